@@ -1,27 +1,63 @@
 #include "pch.h"
 #include "Debugger/BaseEventManager.h"
+#include "Debugger/Debugger.h"
+#include "Shared/Emulator.h"
+
+BaseEventManager::BaseEventManager(Debugger* debugger)
+{
+	_debugger = debugger;
+	_readySnapshot = 1;
+	_snapshotRequest = 0;
+	_snapshotScanlineCount = 0;
+	_snapshot = &_snapshots[_frontSnapshot];
+
+	_eventLists.push_back(std::make_unique<DebugEventList>());
+	_eventLists.push_back(std::make_unique<DebugEventList>());
+	_currentList = _eventLists[0].get();
+	_prevList = _eventLists[1].get();
+}
+
+void BaseEventManager::InitSnapshots(uint32_t ppuBufferSize, uint32_t scanlineCount)
+{
+	for(EventViewerSnapshot& snapshot : _snapshots) {
+		snapshot.PpuBuffer = vector<uint16_t>(ppuBufferSize);
+		snapshot.ScanlineCount = scanlineCount;
+	}
+	_snapshotScanlineCount = scanlineCount;
+}
 
 void BaseEventManager::FilterEvents()
 {
 	auto lock = _lock.AcquireSafe();
 	_sentEvents.clear();
+	if(!_snapshot->CurrentFrame) {
+		//No snapshot taken yet
+		return;
+	}
 
-	if(ShowPreviousFrameEvents() && !_forAutoRefresh) {
+	if(ShowPreviousFrameEvents() && !_snapshot->ForAutoRefresh) {
 		int offset = GetScanlineOffset();
-		uint32_t key = (_snapshotScanline << 16) + _snapshotCycle;
-		for(DebugEventInfo& evt : _snapshotPrevFrame) {
-			uint32_t evtKey = ((evt.Scanline + offset) << 16) + evt.Cycle;
+		uint32_t key = (_snapshot->Scanline << 16) + _snapshot->Cycle;
+		DebugEventList& prevFrame = *_snapshot->PrevFrame;
+		for(uint32_t i = 0; i < _snapshot->PrevFrameCount; i++) {
+			DebugEventRecord& record = prevFrame[i];
+			uint32_t evtKey = ((record.Scanline + offset) << 16) + record.Cycle;
 			if(evtKey > key) {
+				DebugEventInfo evt;
+				record.Unpack(evt);
 				EventViewerCategoryCfg eventCfg = GetEventConfig(evt);
 				if(eventCfg.Visible) {
+					evt.Flags |= (uint32_t)EventFlags::PreviousFrame;
 					_sentEvents.push_back(evt);
-					_sentEvents.back().Flags |= (uint32_t)EventFlags::PreviousFrame;
 				}
 			}
 		}
 	}
 
-	for(DebugEventInfo& evt : _snapshotCurrentFrame) {
+	DebugEventList& currentFrame = *_snapshot->CurrentFrame;
+	for(uint32_t i = 0; i < _snapshot->CurrentFrameCount; i++) {
+		DebugEventInfo evt;
+		currentFrame[i].Unpack(evt);
 		EventViewerCategoryCfg eventCfg = GetEventConfig(evt);
 		if(eventCfg.Visible) {
 			_sentEvents.push_back(evt);
@@ -73,21 +109,105 @@ void BaseEventManager::GetEvents(DebugEventInfo* eventArray, uint32_t& maxEventC
 uint32_t BaseEventManager::GetEventCount()
 {
 	auto lock = _lock.AcquireSafe();
+	AcquireSnapshot();
 	FilterEvents();
 	return (uint32_t)_sentEvents.size();
 }
 
 void BaseEventManager::ClearFrameEvents()
 {
-	_prevDebugEvents = _debugEvents;
-	_debugEvents.clear();
+	uint32_t request = _snapshotRequest.load(std::memory_order_acquire);
+	if(request) {
+		//Take the snapshot requested by the UI now that the frame is complete
+		TakeSnapshot(request & SnapshotRequestedForAutoRefresh);
+		_snapshotRequest.compare_exchange_strong(request, 0, std::memory_order_acq_rel);
+	}
+
+	auto lock = _snapshotLock.AcquireSafe();
+
+	//The completed frame's list becomes the previous frame's list, and a list that isn't used by a snapshot is reused for the new frame
+	DebugEventList* nextList = nullptr;
+	for(unique_ptr<DebugEventList>& list : _eventLists) {
+		if(list.get() != _currentList && list.get() != _prevList && list->SnapshotRefCount == 0) {
+			nextList = list.get();
+			break;
+		}
+	}
+
+	if(!nextList) {
+		//All lists are used by snapshots, this can only happen a few times (each snapshot refers to 2 lists at most)
+		_eventLists.push_back(std::make_unique<DebugEventList>());
+		nextList = _eventLists.back().get();
+	}
+
+	nextList->Clear();
+	_prevList = _currentList;
+	_currentList = nextList;
+}
+
+uint32_t BaseEventManager::TakeEventSnapshot(bool forAutoRefresh)
+{
+	if(_debugger->GetEmulator()->IsEmulationThread() || _debugger->IsExecutionStopped()) {
+		TakeSnapshot(forAutoRefresh);
+	} else {
+		//Let the emulation thread take the snapshot at the end of the current frame rather than pausing it,
+		//and wait for it for a short while (the previous snapshot is kept if the frame takes too long to complete)
+		_snapshotRequest.store(SnapshotRequested | (forAutoRefresh ? SnapshotRequestedForAutoRefresh : 0), std::memory_order_release);
+		for(int i = 0; i < 100 && _snapshotRequest.load(std::memory_order_acquire); i++) {
+			std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+		}
+	}
+	return _snapshotScanlineCount;
+}
+
+void BaseEventManager::TakeSnapshot(bool forAutoRefresh)
+{
+	auto lock = _snapshotLock.AcquireSafe();
+
+	EventViewerSnapshot& snapshot = _snapshots[_backSnapshot];
+	TakePpuSnapshot(snapshot);
+	TakeEventListSnapshot(snapshot);
+	snapshot.ForAutoRefresh = forAutoRefresh;
+	_snapshotScanlineCount = snapshot.ScanlineCount;
+	PublishSnapshot();
+}
+
+void BaseEventManager::TakeEventListSnapshot(EventViewerSnapshot& snapshot)
+{
+	//Release the lists used by the snapshot's previous content
+	if(snapshot.CurrentFrame) {
+		snapshot.CurrentFrame->SnapshotRefCount--;
+		snapshot.PrevFrame->SnapshotRefCount--;
+	}
+
+	snapshot.CurrentFrame = _currentList;
+	snapshot.PrevFrame = _prevList;
+	snapshot.CurrentFrame->SnapshotRefCount++;
+	snapshot.PrevFrame->SnapshotRefCount++;
+	snapshot.CurrentFrameCount = _currentList->GetCount();
+	snapshot.PrevFrameCount = _prevList->GetCount();
+}
+
+void BaseEventManager::PublishSnapshot()
+{
+	//Swap the back snapshot with the ready one - the UI picks it up the next time it reads the snapshot
+	_backSnapshot = _readySnapshot.exchange(_backSnapshot | NewSnapshotFlag, std::memory_order_acq_rel) & 0x03;
+}
+
+void BaseEventManager::AcquireSnapshot()
+{
+	if(_readySnapshot.load(std::memory_order_acquire) & NewSnapshotFlag) {
+		_frontSnapshot = _readySnapshot.exchange(_frontSnapshot, std::memory_order_acq_rel) & 0x03;
+		_snapshot = &_snapshots[_frontSnapshot];
+	}
 }
 
 void BaseEventManager::GetDisplayBuffer(uint32_t* buffer, uint32_t bufferSize)
 {
 	auto lock = _lock.AcquireSafe();
+	AcquireSnapshot();
 	FrameInfo size = GetDisplayBufferSize();
-	if(_snapshotScanline < 0 || bufferSize < size.Width * size.Height * sizeof(uint32_t)) {
+	if(_snapshot->Scanline < 0 || bufferSize < size.Width * size.Height * sizeof(uint32_t)) {
 		return;
 	}
 
@@ -126,8 +246,8 @@ void BaseEventManager::DrawEvent(DebugEventInfo& evt, bool drawBackground, uint3
 
 void BaseEventManager::DrawEvents(uint32_t* buffer, FrameInfo size)
 {
-	if(!_forAutoRefresh) {
-		DrawLine(buffer, size, 0xFFFFFF55, _snapshotScanline);
+	if(!_snapshot->ForAutoRefresh) {
+		DrawLine(buffer, size, 0xFFFFFF55, _snapshot->Scanline);
 	}
 
 	FilterEvents();
@@ -139,9 +259,9 @@ void BaseEventManager::DrawEvents(uint32_t* buffer, FrameInfo size)
 	}
 	
 	//Draw dot over current pixel
-	if(!_forAutoRefresh) {
-		int32_t y = _snapshotScanline + _snapshotScanlineOffset;
-		int32_t x = _snapshotCycle;
+	if(!_snapshot->ForAutoRefresh) {
+		int32_t y = _snapshot->Scanline + _snapshotScanlineOffset;
+		int32_t x = _snapshot->Cycle;
 		ConvertScanlineCycleToRowColumn(x, y);
 
 		DrawDot(x, y, 0xFF990099, true, buffer);
@@ -5,6 +5,8 @@
 #include "Utilities/SimpleLock.h"
 #include "SNES/DmaControllerTypes.h"
 
+class Debugger;
+
 enum class EventFlags
 {
 	PreviousFrame = 1,
@@ -29,6 +31,112 @@ struct DebugEventInfo
 	uint32_t Color = 0;
 };
 
+//Compact copy of a DebugEventInfo, used to store the events captured during a frame
+//Only the fields that are used by a given event type are kept (DMA channel info for SNES DMA events, target memory otherwise)
+struct DebugEventRecord
+{
+	uint32_t Address;
+	int32_t Value;
+	uint32_t ProgramCounter;
+	int16_t Scanline;
+	uint16_t Cycle;
+	int16_t BreakpointId;
+	uint8_t OperationType;
+	uint8_t MemType;
+	uint8_t Type;
+	uint8_t Flags;
+	int8_t DmaChannel;
+	int8_t RegisterId;
+
+	union
+	{
+		struct
+		{
+			uint32_t Address;
+			uint8_t Type;
+			uint8_t MemType;
+		} Target;
+
+		struct
+		{
+			uint16_t SrcAddress;
+			uint16_t TransferSize;
+			uint8_t SrcBank;
+			uint8_t DestAddress;
+			uint8_t TransferMode;
+			uint8_t HdmaLineCounterAndRepeat;
+		} Dma;
+	};
+
+	//Set in TransferMode
+	static constexpr uint8_t DmaInvertDirection = 0x80;
+	static constexpr uint8_t DmaHdmaIndirect = 0x40;
+
+	__forceinline void Pack(DebugEventInfo& evt)
+	{
+		Address = evt.Operation.Address;
+		Value = evt.Operation.Value;
+		ProgramCounter = evt.ProgramCounter;
+		Scanline = evt.Scanline;
+		Cycle = evt.Cycle;
+		BreakpointId = evt.BreakpointId;
+		OperationType = (uint8_t)evt.Operation.Type;
+		MemType = (uint8_t)evt.Operation.MemType;
+		Type = (uint8_t)evt.Type;
+		Flags = (uint8_t)evt.Flags;
+		DmaChannel = evt.DmaChannel;
+		RegisterId = (int8_t)evt.RegisterId;
+
+		if(DmaChannel >= 0) {
+			DmaChannelConfig& cfg = evt.DmaChannelInfo;
+			Dma.SrcAddress = cfg.SrcAddress;
+			Dma.TransferSize = cfg.TransferSize;
+			Dma.SrcBank = cfg.SrcBank;
+			Dma.DestAddress = cfg.DestAddress;
+			Dma.TransferMode = cfg.TransferMode | (cfg.InvertDirection ? DmaInvertDirection : 0) | (cfg.HdmaIndirectAddressing ? DmaHdmaIndirect : 0);
+			Dma.HdmaLineCounterAndRepeat = cfg.HdmaLineCounterAndRepeat;
+		} else {
+			Target.Address = evt.TargetMemory.Address;
+			Target.Type = (uint8_t)evt.TargetMemory.Type;
+			Target.MemType = (uint8_t)evt.TargetMemory.MemType;
+		}
+	}
+
+	void Unpack(DebugEventInfo& evt)
+	{
+		evt = {};
+		evt.Operation.Address = Address;
+		evt.Operation.Value = Value;
+		evt.Operation.Type = (MemoryOperationType)OperationType;
+		evt.Operation.MemType = (MemoryType)MemType;
+		evt.Type = (DebugEventType)Type;
+		evt.ProgramCounter = ProgramCounter;
+		evt.Scanline = Scanline;
+		evt.Cycle = Cycle;
+		evt.BreakpointId = BreakpointId;
+		evt.DmaChannel = DmaChannel;
+		evt.Flags = Flags;
+		evt.RegisterId = RegisterId;
+
+		if(DmaChannel >= 0) {
+			DmaChannelConfig& cfg = evt.DmaChannelInfo;
+			cfg.SrcAddress = Dma.SrcAddress;
+			cfg.TransferSize = Dma.TransferSize;
+			cfg.SrcBank = Dma.SrcBank;
+			cfg.DestAddress = Dma.DestAddress;
+			cfg.TransferMode = Dma.TransferMode & 0x07;
+			cfg.InvertDirection = (Dma.TransferMode & DmaInvertDirection) != 0;
+			cfg.HdmaIndirectAddressing = (Dma.TransferMode & DmaHdmaIndirect) != 0;
+			cfg.HdmaLineCounterAndRepeat = Dma.HdmaLineCounterAndRepeat;
+		} else {
+			evt.TargetMemory.Address = Target.Address;
+			evt.TargetMemory.Value = Value;
+			evt.TargetMemory.Type = (MemoryOperationType)Target.Type;
+			evt.TargetMemory.MemType = (MemoryType)Target.MemType;
+		}
+	}
+};
+
 struct EventViewerCategoryCfg
 {
 	bool Visible;
@@ -39,23 +147,134 @@ struct BaseEventViewerConfig
 {
 };
 
+//Events captured during a frame - the storage is allocated in chunks that are kept for the next frames,
+//so adding events doesn't allocate once a frame with as many events has been captured
+//Events are never modified once added, so snapshots can read the first GetCount() events while more events are added
+class DebugEventList
+{
+private:
+	static constexpr uint32_t ChunkShift = 10;
+	static constexpr uint32_t ChunkSize = 1 << ChunkShift;
+	static constexpr uint32_t MaxChunks = 1024;
+
+	unique_ptr<DebugEventRecord[]> _chunks[MaxChunks];
+	atomic<uint32_t> _count;
+
+public:
+	//Number of snapshots that refer to this list (the list can't be cleared and reused while this is not 0)
+	uint32_t SnapshotRefCount = 0;
+
+	DebugEventList()
+	{
+		_count = 0;
+	}
+
+	__forceinline void Add(DebugEventInfo& evt)
+	{
+		uint32_t count = _count.load(std::memory_order_relaxed);
+		uint32_t chunk = count >> ChunkShift;
+		if(chunk >= MaxChunks) {
+			//Too many events in a single frame, ignore the rest
+			return;
+		}
+
+		if(!_chunks[chunk]) {
+			_chunks[chunk].reset(new DebugEventRecord[ChunkSize]);
+		}
+		_chunks[chunk][count & (ChunkSize - 1)].Pack(evt);
+
+		//Publish the event after it's written
+		_count.store(count + 1, std::memory_order_release);
+	}
+
+	void Clear()
+	{
+		_count.store(0, std::memory_order_release);
+	}
+
+	uint32_t GetCount()
+	{
+		return _count.load(std::memory_order_acquire);
+	}
+
+	DebugEventRecord& operator[](uint32_t index)
+	{
+		return _chunks[index >> ChunkShift][index & (ChunkSize - 1)];
+	}
+};
+
+struct EventViewerSnapshot
+{
+	//Event lists referenced by the snapshot, only the first [xxxCount] events are part of the snapshot
+	DebugEventList* CurrentFrame = nullptr;
+	DebugEventList* PrevFrame = nullptr;
+	uint32_t CurrentFrameCount = 0;
+	uint32_t PrevFrameCount = 0;
+
+	//Copy of the PPU's output (PCE also stores the row clock dividers after the screen)
+	vector<uint16_t> PpuBuffer;
+
+	int16_t Scanline = -1;
+	uint16_t Cycle = 0;
+	uint32_t ScanlineCount = 0;
+	bool ForAutoRefresh = false;
+
+	//SNES only
+	bool OverscanMode = false;
+	bool HighResOutput = false;
+};
+
 class BaseEventManager
 {
 protected:
-	vector<DebugEventInfo> _debugEvents;
-	vector<DebugEventInfo> _prevDebugEvents;
-	vector<DebugEventInfo> _sentEvents;
+	static constexpr uint32_t NewSnapshotFlag = 0x04;
+	static constexpr uint32_t SnapshotRequested = 0x01;
+	static constexpr uint32_t SnapshotRequestedForAutoRefresh = 0x02;
+
+	Debugger* _debugger = nullptr;
+
+	//Event lists for the current and previous frames - snapshots refer to these lists instead of copying them,
+	//so a new list is taken from the pool at the start of a frame when the older list is still used by a snapshot
+	vector<unique_ptr<DebugEventList>> _eventLists;
+	DebugEventList* _currentList = nullptr;
+	DebugEventList* _prevList = nullptr;
+
+	//Snapshots are triple buffered: the back snapshot is filled and published without waiting for the UI,
+	//which only reads the front snapshot (_snapshot)
+	EventViewerSnapshot _snapshots[3];
+	uint32_t _backSnapshot = 0;
+	uint32_t _frontSnapshot = 2;
+	atomic<uint32_t> _readySnapshot;
+	EventViewerSnapshot* _snapshot = nullptr;
+	SimpleLock _snapshotLock;
+
+	//Set when a snapshot is requested by another thread while the emulation is running, the emulation thread takes
+	//the snapshot at the end of the current frame (instead of being paused while the snapshot is taken)
+	atomic<uint32_t> _snapshotRequest;
+	atomic<uint32_t> _snapshotScanlineCount;
 
-	vector<DebugEventInfo> _snapshotCurrentFrame;
-	vector<DebugEventInfo> _snapshotPrevFrame;
-	int16_t _snapshotScanline = -1;
+	vector<DebugEventInfo> _sentEvents;
 	int16_t _snapshotScanlineOffset = 0;
-	uint16_t _snapshotCycle = 0;
-	bool _forAutoRefresh = false;
+
+	//Used by the UI calls that read the front snapshot and the filtered events
 	SimpleLock _lock;
 
 	virtual bool ShowPreviousFrameEvents() = 0;
 
+	__forceinline void AddDebugEvent(DebugEventInfo& evt)
+	{
+		_currentList->Add(evt);
+	}
+
+	void InitSnapshots(uint32_t ppuBufferSize, uint32_t scanlineCount);
+	void TakeSnapshot(bool forAutoRefresh);
+	void TakeEventListSnapshot(EventViewerSnapshot& snapshot);
+	void PublishSnapshot();
+	void AcquireSnapshot();
+
+	//Copies the PPU's output and sets the scanline/cycle/scanline count in the snapshot
+	virtual void TakePpuSnapshot(EventViewerSnapshot& snapshot) = 0;
+
 	void FilterEvents();
 	void DrawDot(uint32_t x, uint32_t y, uint32_t color, bool drawBackground, uint32_t* buffer);
 	virtual int GetScanlineOffset() { return 0; }
@@ -68,6 +287,7 @@ protected:
 	void DrawEvent(DebugEventInfo& evt, bool drawBackground, uint32_t* buffer);
 
 public:
+	BaseEventManager(Debugger* debugger);
 	virtual ~BaseEventManager() {}
 
 	virtual void SetConfiguration(BaseEventViewerConfig& config) = 0;
@@ -81,7 +301,7 @@ public:
 
 	virtual EventViewerCategoryCfg GetEventConfig(DebugEventInfo& evt) = 0;
 
-	virtual uint32_t TakeEventSnapshot(bool forAutoRefresh) = 0;
+	uint32_t TakeEventSnapshot(bool forAutoRefresh);
 	virtual FrameInfo GetDisplayBufferSize() = 0;
 	virtual DebugEventInfo GetEvent(uint16_t scanline, uint16_t cycle) = 0;
 	
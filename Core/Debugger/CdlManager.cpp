@@ -65,6 +65,26 @@ void CdlManager::SaveCdlFile(MemoryType memType, char* cdlFile)
 	}
 }
 
+bool CdlManager::MapCdlFile(MemoryType memType, char* cdlFile)
+{
+	DebugBreakHelper helper(_debugger);
+	CodeDataLogger* cdl = GetCodeDataLogger(memType);
+	if(cdl && cdl->MapCdlFile(cdlFile)) {
+		RefreshCodeCache();
+		return true;
+	}
+	return false;
+}
+
+void CdlManager::FlushCdlFiles()
+{
+	for(CodeDataLogger* cdl : _codeDataLoggers) {
+		if(cdl) {
+			cdl->FlushCdlFile();
+		}
+	}
+}
+
 void CdlManager::RegisterCdl(MemoryType memType, CodeDataLogger* cdl)
 {
 	_codeDataLoggers[(int)memType] = cdl;
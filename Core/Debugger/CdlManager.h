@@ -27,6 +27,8 @@ public:
 	void ResetCdl(MemoryType memType);
 	void LoadCdlFile(MemoryType memType, char* cdlFile);
 	void SaveCdlFile(MemoryType memType, char* cdlFile);
+	bool MapCdlFile(MemoryType memType, char* cdlFile);
+	void FlushCdlFiles();
 	void RegisterCdl(MemoryType memType, CodeDataLogger* cdl);
 
 	void RefreshCodeCache();
@@ -8,6 +8,7 @@
 #include "Shared/MessageManager.h"
 #include "Utilities/VirtualFile.h"
 #include "Utilities/FolderUtilities.h"
+#include "Utilities/MemoryMappedFile.h"
 
 CodeDataLogger::CodeDataLogger(Debugger* debugger, MemoryType memType, uint32_t memSize, CpuType cpuType, uint32_t romCrc32)
 {
@@ -16,6 +17,7 @@ CodeDataLogger::CodeDataLogger(Debugger* debugger, MemoryType memType, uint32_t
 	_memSize = memSize;
 	_romCrc32 = romCrc32;
 	_cdlData = new uint8_t[memSize];
+	_blockVersions = vector<uint32_t>((memSize >> BlockShift) + 1);
 	Reset();
 
 	debugger->GetCdlManager()->RegisterCdl(memType, this);
@@ -23,7 +25,12 @@ CodeDataLogger::CodeDataLogger(Debugger* debugger, MemoryType memType, uint32_t
 
 CodeDataLogger::~CodeDataLogger()
 {
-	delete[] _cdlData;
+	if(_mappedFile) {
+		_mappedFile->Flush();
+	}
+	if(_ownsData) {
+		delete[] _cdlData;
+	}
 }
 
 void CodeDataLogger::Reset()
@@ -79,6 +86,12 @@ bool CodeDataLogger::LoadCdlFile(string cdlFilepath, bool autoResetCdl)
 
 bool CodeDataLogger::SaveCdlFile(string cdlFilepath)
 {
+	if(_mappedFile && (cdlFilepath == _mappedFilePath || FolderUtilities::IsSameFile(cdlFilepath, _mappedFilePath))) {
+		//The file is already up to date (and must not be truncated while it's mapped)
+		_mappedFile->Flush();
+		return true;
+	}
+
 	ofstream cdlFile(cdlFilepath, ios::out | ios::binary);
 	if(cdlFile) {
 		cdlFile.write("CDLv2", 5);
@@ -94,6 +107,88 @@ bool CodeDataLogger::SaveCdlFile(string cdlFilepath)
 	return false;
 }
 
+bool CodeDataLogger::MapCdlFile(string cdlFilepath)
+{
+	//Uses the file itself as the storage for the CDL data, so it's updated in place (by the OS) as code/data gets logged
+	size_t fileSize = CodeDataLogger::HeaderSize + _memSize + GetExtraDataSize();
+	bool newFile = true;
+
+	{
+		//Validate existing files before opening them in read/write mode, to avoid modifying files that aren't CDL files for this ROM
+		MemoryMappedFile existingFile;
+		if(existingFile.Open(cdlFilepath)) {
+			uint8_t* data = existingFile.GetData();
+			if(existingFile.GetSize() != fileSize || memcmp(data, "CDLv2", 5) != 0) {
+				return false;
+			}
+
+			uint32_t savedCrc = data[5] | (data[6] << 8) | (data[7] << 16) | (data[8] << 24);
+			if(savedCrc != _romCrc32) {
+				//CDL file for another ROM, don't overwrite it
+				return false;
+			}
+			newFile = false;
+		}
+	}
+
+	//Only missing or empty files are created/resized
+	unique_ptr<MemoryMappedFile> file(new MemoryMappedFile());
+	if(!file->OpenWritable(cdlFilepath, fileSize)) {
+		return false;
+	}
+
+	uint8_t* data = file->GetData();
+	if(newFile) {
+		for(int i = 0; i < CodeDataLogger::HeaderSize; i++) {
+			if(data[i] != 0) {
+				//Not an empty file (could not be validated above), don't overwrite it
+				return false;
+			}
+		}
+
+		//New file, initialize it with the current CDL data
+		memcpy(data, "CDLv2", 5);
+		data[5] = _romCrc32 & 0xFF;
+		data[6] = (_romCrc32 >> 8) & 0xFF;
+		data[7] = (_romCrc32 >> 16) & 0xFF;
+		data[8] = (_romCrc32 >> 24) & 0xFF;
+	} else if(memcmp(data, "CDLv2", 5) != 0) {
+		//File was replaced after it was validated
+		return false;
+	}
+
+	SetExternalStorage(data + CodeDataLogger::HeaderSize, newFile);
+	MapExtraData(data + CodeDataLogger::HeaderSize + _memSize, newFile);
+
+	//Replacing the previous mapping (if any) is done last, the current data may be copied from it
+	_mappedFile = std::move(file);
+	_mappedFilePath = cdlFilepath;
+	return true;
+}
+
+void CodeDataLogger::SetExternalStorage(uint8_t* data, bool copyCurrentData)
+{
+	if(copyCurrentData) {
+		memcpy(data, _cdlData, _memSize);
+	}
+	if(_ownsData) {
+		delete[] _cdlData;
+		_ownsData = false;
+	}
+	_cdlData = data;
+
+	for(uint32_t& version : _blockVersions) {
+		version++;
+	}
+}
+
+void CodeDataLogger::FlushCdlFile()
+{
+	if(_mappedFile) {
+		_mappedFile->Flush();
+	}
+}
+
 string CodeDataLogger::GetCdlFilePath(string romName)
 {
 	return FolderUtilities::CombinePath(FolderUtilities::GetDebuggerFolder(), FolderUtilities::GetFilename(romName, false) + ".cdl");
@@ -4,6 +4,7 @@
 
 class Disassembler;
 class Debugger;
+class MemoryMappedFile;
 
 class CodeDataLogger
 {
@@ -11,6 +12,10 @@ protected:
 	constexpr static int HeaderSize = 9; //"CDLv2" + 4-byte CRC32 value
 
 	uint8_t* _cdlData = nullptr;
+	unique_ptr<MemoryMappedFile> _mappedFile;
+	string _mappedFilePath;
+	bool _ownsData = true;
+	vector<uint32_t> _blockVersions;
 	CpuType _cpuType = CpuType::Snes;
 	MemoryType _memType = {};
 	uint32_t _memSize = 0;
@@ -19,7 +24,13 @@ protected:
 	virtual void InternalLoadCdlFile(uint8_t* cdlData, uint32_t cdlSize) {}
 	virtual void InternalSaveCdlFile(ofstream& cdlFile) {}
 
+	//Extra sections saved after the CDL data (e.g CHR ROM for NES), which must also be mapped when the file is mapped
+	virtual uint32_t GetExtraDataSize() { return 0; }
+	virtual void MapExtraData(uint8_t* data, bool initialize) {}
+
 public:
+	static constexpr uint32_t BlockShift = 12;
+
 	CodeDataLogger(Debugger* debugger, MemoryType memType, uint32_t memSize, CpuType cpuType, uint32_t romCrc32);
 	virtual ~CodeDataLogger();
 
@@ -30,25 +41,40 @@ public:
 
 	bool LoadCdlFile(string cdlFilepath, bool autoResetCdl);
 	bool SaveCdlFile(string cdlFilepath);
+	bool MapCdlFile(string cdlFilepath);
+	void FlushCdlFile();
+	void SetExternalStorage(uint8_t* data, bool copyCurrentData);
 	string GetCdlFilePath(string romName);
 
+	__forceinline void SetFlags(int32_t absoluteAddr, uint8_t flags)
+	{
+		if((_cdlData[absoluteAddr] & flags) != flags) {
+			_cdlData[absoluteAddr] |= flags;
+
+			//Let the disassembler know that this block's flags changed
+			_blockVersions[(uint32_t)absoluteAddr >> BlockShift]++;
+		}
+	}
+
 	template<uint8_t flags = 0>
 	void SetCode(int32_t absoluteAddr)
 	{
-		_cdlData[absoluteAddr] |= CdlFlags::Code | flags;
+		SetFlags(absoluteAddr, CdlFlags::Code | flags);
 	}
 
 	void SetCode(int32_t absoluteAddr, uint8_t flags)
 	{
-		_cdlData[absoluteAddr] |= CdlFlags::Code | flags;
+		SetFlags(absoluteAddr, CdlFlags::Code | flags);
 	}
 
 	template<uint8_t flags = 0>
 	void SetData(int32_t absoluteAddr)
 	{
-		_cdlData[absoluteAddr] |= CdlFlags::Data | flags;
+		SetFlags(absoluteAddr, CdlFlags::Data | flags);
 	}
 
+	uint32_t GetBlockVersion(uint32_t block) { return block < _blockVersions.size() ? _blockVersions[block] : 0; }
+
 	virtual CdlStatistics GetStatistics();
 
 	bool IsCode(uint32_t absoluteAddr);
@@ -120,6 +120,9 @@ Debugger::Debugger(Emulator* emu, IConsole* console)
 
 Debugger::~Debugger()
 {
+	//Stop the search index thread before the objects it uses (labels, CDL, etc.) are destroyed
+	_disassemblySearch.reset();
+
 	Release();
 }
 
@@ -21,6 +21,8 @@
 #include "Utilities/HexUtilities.h"
 #include "Utilities/StringUtilities.h"
 
+static_assert(Disassembler::BlockShift == CodeDataLogger::BlockShift, "block sizes must match");
+
 Disassembler::Disassembler(IConsole* console, Debugger* debugger)
 {
 	_debugger = debugger;
@@ -28,6 +30,7 @@ Disassembler::Disassembler(IConsole* console, Debugger* debugger)
 	_console = console;
 	_settings = debugger->GetEmulator()->GetSettings();
 	_memoryDumper = _debugger->GetMemoryDumper();
+	_cacheGeneration = 0;
 
 	for(int i = (int)MemoryType::SnesPrgRom; i < DebugUtilities::GetMemoryTypeCount(); i++) {
 		InitSource((MemoryType)i);
@@ -37,7 +40,7 @@ Disassembler::Disassembler(IConsole* console, Debugger* debugger)
 void Disassembler::InitSource(MemoryType type)
 {
 	uint32_t size = _memoryDumper->GetMemorySize(type);
-	_sources[(int)type] = { vector<DisassemblyInfo>(size), size };
+	_sources[(int)type] = { vector<DisassemblyInfo>(size), vector<uint32_t>((size >> BlockShift) + 1), size };
 }
 
 DisassemblerSource& Disassembler::GetSource(MemoryType type)
@@ -60,6 +63,8 @@ uint32_t Disassembler::BuildCache(AddressInfo &addrInfo, uint8_t cpuFlags, CpuTy
 				//(can happen when resizing an instruction after X/M updates)
 				src.Cache[address + i] = DisassemblyInfo();
 			}
+			MarkBlockChanged(src, address);
+			MarkBlockChanged(src, std::min<int32_t>(address + disInfo.GetOpSize() - 1, (int32_t)src.Cache.size() - 1));
 			returnSize += disInfo.GetOpSize();
 		} else {
 			returnSize += disInfo.GetOpSize();
@@ -80,29 +85,189 @@ uint32_t Disassembler::BuildCache(AddressInfo &addrInfo, uint8_t cpuFlags, CpuTy
 
 void Disassembler::ResetPrgCache()
 {
+	std::unique_lock<std::shared_mutex> lock(_sourceLock);
 	InitSource(MemoryType::SnesPrgRom);
 	InitSource(MemoryType::GbPrgRom);
 	InitSource(MemoryType::NesPrgRom);
 	InitSource(MemoryType::PcePrgRom);
+
+	//Block versions were reset, force all banks to be disassembled again
+	_cacheGeneration++;
 }
 
 void Disassembler::InvalidateCache(AddressInfo addrInfo, CpuType type)
 {
 	if(addrInfo.Address >= 0) {
 		DisassemblerSource& src = GetSource(addrInfo.Type);
+		bool changed = false;
 		for(int i = 0; i < 4; i++) {
-			if(addrInfo.Address >= i) {
+			if(addrInfo.Address >= i && src.Cache[addrInfo.Address - i].IsInitialized()) {
 				src.Cache[addrInfo.Address - i].Reset();
+				changed = true;
 			}
 		}
+
+		//Only writes to code invalidate the cached banks (otherwise banks mapped to RAM would be rebuilt constantly)
+		if(changed) {
+			MarkBlockChanged(src, addrInfo.Address);
+			MarkBlockChanged(src, std::max(0, addrInfo.Address - 3));
+		}
+	}
+}
+
+uint32_t Disassembler::GetBlockVersion(MemoryType type, uint32_t block)
+{
+	DisassemblerSource& src = GetSource(type);
+	uint32_t version = block < src.BlockVersions.size() ? src.BlockVersions[block] : 0;
+	CodeDataLogger* cdl = _debugger->GetCdlManager()->GetCodeDataLogger(type);
+	if(cdl) {
+		version += cdl->GetBlockVersion(block);
+	}
+	return version;
+}
+
+uint32_t Disassembler::GetConfigFlags()
+{
+	DebugConfig& cfg = _settings->GetDebugConfig();
+	return (
+		(cfg.DisassembleUnidentifiedData ? 0x01 : 0) |
+		(cfg.DisassembleVerifiedData ? 0x02 : 0) |
+		(cfg.ShowUnidentifiedData ? 0x04 : 0) |
+		(cfg.ShowVerifiedData ? 0x08 : 0) |
+		(cfg.ShowJumpLabels ? 0x10 : 0) |
+		(cfg.UseLowerCaseDisassembly ? 0x20 : 0) |
+		(cfg.SnesUseAltSpcOpNames ? 0x40 : 0) |
+		(cfg.ShowMemoryValues ? 0x80 : 0) //Not used by the disassembly itself, but affects the search index
+	);
+}
+
+void Disassembler::GetBankMappings(CpuType cpuType, uint16_t bank, vector<AddressInfo>& mappings)
+{
+	AddressInfo relAddress = {};
+	relAddress.Type = DebugUtilities::GetCpuMemoryType(cpuType);
+	int32_t bankStart = bank << 16;
+	int32_t bankEnd = std::min<int32_t>((bank + 1) << 16, (int32_t)_memoryDumper->GetMemorySize(relAddress.Type));
+
+	mappings.clear();
+	for(int32_t i = bankStart; i < bankEnd; i += MappingSampleSize) {
+		relAddress.Address = i;
+		mappings.push_back(_console->GetAbsoluteAddress(relAddress));
 	}
 }
 
-vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t bank)
+bool Disassembler::IsBankValid(DisassemblerBank& bank, CpuType cpuType, uint16_t bankNumber)
+{
+	if(bank.HasVolatileCode || bank.Generation != _cacheGeneration || bank.LabelVersion != _labelManager->GetVersion() || bank.ConfigFlags != GetConfigFlags()) {
+		return false;
+	}
+
+	for(DisassemblerBankDependency& dep : bank.Dependencies) {
+		if(GetBlockVersion(dep.Type, dep.Block) != dep.Version) {
+			return false;
+		}
+	}
+
+	//Check if the memory mappings changed since the bank was disassembled
+	AddressInfo relAddress = {};
+	relAddress.Type = DebugUtilities::GetCpuMemoryType(cpuType);
+	int32_t bankStart = bankNumber << 16;
+	for(size_t i = 0; i < bank.Mappings.size(); i++) {
+		relAddress.Address = bankStart + (int32_t)(i * MappingSampleSize);
+		AddressInfo absAddr = _console->GetAbsoluteAddress(relAddress);
+		if(absAddr.Address != bank.Mappings[i].Address || absAddr.Type != bank.Mappings[i].Type) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+shared_ptr<DisassemblerBank> Disassembler::GetBank(CpuType cpuType, uint16_t bank)
+{
+	uint32_t key = ((uint32_t)cpuType << 16) | bank;
+
+	shared_ptr<DisassemblerBank> cachedBank;
+	{
+		auto lock = _bankLock.AcquireSafe();
+		auto result = _banks.find(key);
+		if(result != _banks.end()) {
+			cachedBank = result->second;
+			cachedBank->LastAccess = ++_bankAccessCounter;
+		}
+	}
+
+	if(cachedBank && IsBankValid(*cachedBank, cpuType, bank)) {
+		return cachedBank;
+	}
+
+	//Disassemble the bank without holding the lock, to allow multiple banks to be disassembled in parallel (see DisassemblySearch)
+	shared_ptr<DisassemblerBank> newBank(new DisassemblerBank());
+	newBank->Generation = _cacheGeneration;
+	newBank->LabelVersion = _labelManager->GetVersion();
+	newBank->ConfigFlags = GetConfigFlags();
+	GetBankMappings(cpuType, bank, newBank->Mappings);
+	DisassembleBank(cpuType, bank, *newBank);
+
+	auto lock = _bankLock.AcquireSafe();
+	auto result = _banks.find(key);
+	if(result != _banks.end()) {
+		_cachedRowCount -= (uint32_t)result->second->Rows.size();
+		_banks.erase(result);
+	}
+
+	//Evict the least recently used banks to keep memory usage in check
+	while(_cachedRowCount + newBank->Rows.size() > MaxCachedRows && !_banks.empty()) {
+		auto oldest = _banks.begin();
+		for(auto it = _banks.begin(); it != _banks.end(); it++) {
+			if(it->second->LastAccess < oldest->second->LastAccess) {
+				oldest = it;
+			}
+		}
+		_cachedRowCount -= (uint32_t)oldest->second->Rows.size();
+		_banks.erase(oldest);
+	}
+
+	newBank->LastAccess = ++_bankAccessCounter;
+	_cachedRowCount += (uint32_t)newBank->Rows.size();
+	_banks[key] = newBank;
+	return newBank;
+}
+
+shared_ptr<DisassemblerBank> Disassembler::GetCachedBank(CpuType cpuType, uint16_t bank)
+{
+	//Returns the bank only if it's already cached and up to date, without disassembling it or affecting the LRU order
+	shared_ptr<DisassemblerBank> cachedBank;
+	{
+		auto lock = _bankLock.AcquireSafe();
+		auto result = _banks.find(((uint32_t)cpuType << 16) | bank);
+		if(result != _banks.end()) {
+			cachedBank = result->second;
+		}
+	}
+
+	if(cachedBank && IsBankValid(*cachedBank, cpuType, bank)) {
+		return cachedBank;
+	}
+	return nullptr;
+}
+
+shared_ptr<DisassemblySearchIndex> Disassembler::GetSearchIndex(DisassemblerBank& bank)
+{
+	auto lock = _bankLock.AcquireSafe();
+	return bank.SearchIndex;
+}
+
+void Disassembler::SetSearchIndex(DisassemblerBank& bank, shared_ptr<DisassemblySearchIndex> index)
+{
+	auto lock = _bankLock.AcquireSafe();
+	bank.SearchIndex = index;
+}
+
+void Disassembler::DisassembleBank(CpuType cpuType, uint16_t bank, DisassemblerBank& result)
 {
 	constexpr int bytesPerRow = 8;
 
-	vector<DisassemblyResult> results;
+	vector<DisassemblyResult>& results = result.Rows;
 	results.reserve(20000);
 
 	DebugConfig& cfg = _settings->GetDebugConfig();
@@ -123,7 +288,7 @@ vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t ba
 	relAddress.Type = DebugUtilities::GetCpuMemoryType(cpuType);
 
 	if(bank > GetMaxBank(cpuType)) {
-		return results;
+		return;
 	}
 
 	int32_t bankStart = bank << 16;
@@ -131,6 +296,17 @@ vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t ba
 	bankEnd = std::min<int32_t>(bankEnd, (int32_t)_memoryDumper->GetMemorySize(relAddress.Type));
 
 	AddressInfo addrInfo = {};
+	DisassemblerBankDependency* prevDependency = nullptr;
+	result.Dependencies.reserve(64);
+
+	auto addDependency = [&]() {
+		//Keep track of which blocks of memory are used by this bank, to be able to tell when they are modified
+		uint32_t block = (uint32_t)addrInfo.Address >> BlockShift;
+		if(!prevDependency || prevDependency->Type != addrInfo.Type || prevDependency->Block != block) {
+			result.Dependencies.push_back({ addrInfo.Type, block, GetBlockVersion(addrInfo.Type, block) });
+			prevDependency = &result.Dependencies.back();
+		}
+	};
 
 	auto pushEndBlock = [&]() {
 		if(inUnknownBlock || inVerifiedBlock) {
@@ -172,6 +348,8 @@ vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t ba
 			pushUnmappedBlock();
 		}
 
+		addDependency();
+
 		DisassemblerSource& src = GetSource(addrInfo.Type);
 		DisassemblyInfo disassemblyInfo = src.Cache[addrInfo.Address];
 		CodeDataLogger* cdl = _debugger->GetCdlManager()->GetCodeDataLogger(addrInfo.Type);
@@ -185,6 +363,9 @@ vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t ba
 		} else if((isData && disData) || (!isData && !isCode && disUnident)) {
 			disassemblyInfo.Initialize(i, 0, cpuType, relAddress.Type, _memoryDumper);
 			opSize = disassemblyInfo.GetOpSize();
+
+			//The rows depend on the current value of this byte, which can change without invalidating the bank
+			result.HasVolatileCode |= !DebugUtilities::IsRom(addrInfo.Type);
 		}
 
 		if(opSize > 0) {
@@ -240,6 +421,7 @@ vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t ba
 				if(addrInfo.Type != prevMemType || src.Cache[addrInfo.Address].IsInitialized()) {
 					break;
 				}
+				addDependency();
 				i++;
 			}
 		} else {
@@ -287,10 +469,40 @@ vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t ba
 		pushUnmappedBlock();
 	}
 
-	return results;
+	for(size_t i = 1; i < results.size(); i++) {
+		if(results[i].CpuAddress < results[i - 1].CpuAddress) {
+			result.IsSorted = false;
+			break;
+		}
+	}
 }
 
-void Disassembler::GetLineData(DisassemblyResult& row, CpuType type, MemoryType memType, CodeLineData& data)
+uint64_t Disassembler::GetAddressSpaceSignature(CpuType cpuType)
+{
+	//Labels in the disassembly text are resolved based on the current memory mappings,
+	//so cached text can only be reused as long as the mappings for the whole address space are unchanged
+	AddressInfo relAddress = {};
+	relAddress.Type = DebugUtilities::GetCpuMemoryType(cpuType);
+	uint32_t size = _memoryDumper->GetMemorySize(relAddress.Type);
+	uint32_t step = std::max<uint32_t>(MappingSampleSize, size / 4096);
+
+	uint64_t signature = 0xCBF29CE484222325;
+	for(uint32_t i = 0; i < size; i += step) {
+		relAddress.Address = (int32_t)i;
+		AddressInfo absAddr = _console->GetAbsoluteAddress(relAddress);
+		signature = (signature ^ (uint32_t)absAddr.Address) * 0x100000001B3;
+		signature = (signature ^ (uint32_t)absAddr.Type) * 0x100000001B3;
+	}
+	return signature;
+}
+
+void Disassembler::GetLineData(DisassemblerBank& bank, int32_t rowIndex, CpuType type, MemoryType memType, CodeLineData& data)
+{
+	string& cachedText = bank.Text[rowIndex];
+	GetLineData(bank.Rows[rowIndex], type, memType, data, &cachedText);
+}
+
+void Disassembler::GetLineData(DisassemblyResult& row, CpuType type, MemoryType memType, CodeLineData& data, string* cachedText)
 {
 	data.Address = row.CpuAddress;
 	data.AbsoluteAddress = row.Address;
@@ -353,6 +565,7 @@ void Disassembler::GetLineData(DisassemblyResult& row, CpuType type, MemoryType
 		} else {
 			DisassemblerSource& src = GetSource(row.Address.Type);
 			DisassemblyInfo disInfo = src.Cache[row.Address.Address];
+			bool isCachedInfo = disInfo.IsInitialized();
 
 			//Always use Sa1 as the cpu type when disassembling Sa1 address space
 			CpuType lineCpuType = type != CpuType::Sa1 && disInfo.IsInitialized() ? disInfo.GetCpuType() : type;
@@ -513,9 +726,17 @@ void Disassembler::GetLineData(DisassemblyResult& row, CpuType type, MemoryType
 				data.EffectiveAddress.ValueSize = 0;
 			}
 
-			string text;
-			disInfo.GetDisassembly(text, row.CpuAddress, _labelManager, _settings);
-			memcpy(data.Text, text.c_str(), std::min<int>((int)text.size() + 1, 1000));
+			if(cachedText && !cachedText->empty()) {
+				memcpy(data.Text, cachedText->c_str(), std::min<int>((int)cachedText->size() + 1, 1000));
+			} else {
+				string text;
+				disInfo.GetDisassembly(text, row.CpuAddress, _labelManager, _settings);
+				memcpy(data.Text, text.c_str(), std::min<int>((int)text.size() + 1, 1000));
+				if(cachedText && isCachedInfo) {
+					//Only cache text for instructions that are in the cache (text for the others depends on the current memory values)
+					*cachedText = text;
+				}
+			}
 
 			disInfo.GetByteCode(data.ByteCode);
 
@@ -543,10 +764,17 @@ void Disassembler::GetLineData(DisassemblyResult& row, CpuType type, MemoryType
 	}
 }
 
-int32_t Disassembler::GetMatchingRow(vector<DisassemblyResult>& rows, uint32_t address, bool returnFirstRow)
+int32_t Disassembler::GetMatchingRow(DisassemblerBank& bank, uint32_t address, bool returnFirstRow)
 {
-	int32_t i;
-	for(i = 0; i < (int32_t)rows.size(); i++) {
+	vector<DisassemblyResult>& rows = bank.Rows;
+	int32_t i = 0;
+	if(bank.IsSorted) {
+		//Skip all rows before the address
+		auto it = std::lower_bound(rows.begin(), rows.end(), (int32_t)address, [](const DisassemblyResult& row, int32_t addr) { return row.CpuAddress < addr; });
+		i = (int32_t)(it - rows.begin());
+	}
+
+	for(; i < (int32_t)rows.size(); i++) {
 		if(rows[i].CpuAddress == (int32_t)address) {
 			if(i + 1 >= rows.size() || rows[i + 1].CpuAddress != (int32_t)address || address == 0 || returnFirstRow) {
 				//Keep going down until the last instance of the matching address is found
@@ -566,34 +794,44 @@ int32_t Disassembler::GetMatchingRow(vector<DisassemblyResult>& rows, uint32_t a
 uint32_t Disassembler::GetDisassemblyOutput(CpuType type, uint32_t address, CodeLineData output[], uint32_t rowCount)
 {
 	uint16_t bank = address >> 16;
-	Timer timer;
-	vector<DisassemblyResult> rows = Disassemble(type, bank);
+	shared_ptr<DisassemblerBank> bankData = GetBank(type, bank);
 
-	int32_t i = GetMatchingRow(rows, address, true);
+	int32_t i = GetMatchingRow(*bankData, address, true);
 
-	if(i >= (int32_t)rows.size()) {
+	if(i >= (int32_t)bankData->Rows.size()) {
 		return 0;
 	}
 
 	MemoryType memType = DebugUtilities::GetCpuMemoryType(type);
 	uint32_t maxBank = (_memoryDumper->GetMemorySize(memType) - 1) >> 16;
+	uint64_t signature = GetAddressSpaceSignature(type);
+
+	auto lock = _bankLock.AcquireSafe();
+	auto checkTextCache = [&]() {
+		if(bankData->TextSignature != signature) {
+			bankData->Text.clear();
+			bankData->TextSignature = signature;
+		}
+	};
+	checkTextCache();
 
 	int32_t row;
 	for(row = 0; row < (int32_t)rowCount; row++){
-		if(row + i >= rows.size()) {
+		if(row + i >= bankData->Rows.size()) {
 			if(bank < maxBank) {
 				bank++;
-				rows = Disassemble(type, bank);
-				if(rows.size() == 0) {
+				bankData = GetBank(type, bank);
+				if(bankData->Rows.size() == 0) {
 					break;
 				}
+				checkTextCache();
 				i = -row;
 			} else {
 				break;
 			}
 		}
 
-		GetLineData(rows[row + i], type, memType, output[row]);
+		GetLineData(*bankData, row + i, type, memType, output[row]);
 	}
 
 	return row;
@@ -609,20 +847,20 @@ uint16_t Disassembler::GetMaxBank(CpuType cpuType)
 int32_t Disassembler::GetDisassemblyRowAddress(CpuType cpuType, uint32_t address, int32_t rowOffset)
 {
 	uint16_t bank = address >> 16;
-	vector<DisassemblyResult> rows = Disassemble(cpuType, bank);
-	int32_t len = (int32_t)rows.size();
+	shared_ptr<DisassemblerBank> bankData = GetBank(cpuType, bank);
+	int32_t len = (int32_t)bankData->Rows.size();
 	if(len == 0) {
 		return address;
 	}
 
 	uint16_t maxBank = GetMaxBank(cpuType);
-	int32_t i = GetMatchingRow(rows, address, false);
+	int32_t i = GetMatchingRow(*bankData, address, false);
 
 	if(rowOffset > 0) {
 		while(len > 0) {
 			for(; i < len; i++) {
-				if(rowOffset <= 0 && rows[i].CpuAddress >= 0 && rows[i].CpuAddress != (int32_t)address) {
-					return rows[i].CpuAddress;
+				if(rowOffset <= 0 && bankData->Rows[i].CpuAddress >= 0 && bankData->Rows[i].CpuAddress != (int32_t)address) {
+					return bankData->Rows[i].CpuAddress;
 				}
 				rowOffset--;
 			}
@@ -630,19 +868,19 @@ int32_t Disassembler::GetDisassemblyRowAddress(CpuType cpuType, uint32_t address
 			//End of bank, didn't find an appropriate row to jump to, try the next bank
 			if(bank == maxBank) {
 				//Reached bottom of last bank, return the bottom row
-				return rows[len - 1].CpuAddress >= 0 ? rows[len - 1].CpuAddress : address;
+				return bankData->Rows[len - 1].CpuAddress >= 0 ? bankData->Rows[len - 1].CpuAddress : address;
 			}
 
 			bank++;
-			rows = Disassemble(cpuType, bank);
-			len = (int32_t)rows.size();
+			bankData = GetBank(cpuType, bank);
+			len = (int32_t)bankData->Rows.size();
 			i = 0;
 		}
 	} else if(rowOffset < 0) {
 		while(len > 0) {
 			for(; i >= 0; i--) {
-				if(rowOffset >= 0 && rows[i].CpuAddress >= 0 && rows[i].CpuAddress != (int32_t)address) {
-					return rows[i].CpuAddress;
+				if(rowOffset >= 0 && bankData->Rows[i].CpuAddress >= 0 && bankData->Rows[i].CpuAddress != (int32_t)address) {
+					return bankData->Rows[i].CpuAddress;
 				}
 				rowOffset++;
 			}
@@ -650,12 +888,12 @@ int32_t Disassembler::GetDisassemblyRowAddress(CpuType cpuType, uint32_t address
 			//Start of bank, didn't find an appropriate row to jump to, try the previous bank
 			if(bank == 0) {
 				//Reached top of first bank, return the top row
-				return rows[0].CpuAddress >= 0 ? rows[0].CpuAddress : address;
+				return bankData->Rows[0].CpuAddress >= 0 ? bankData->Rows[0].CpuAddress : address;
 			}
 
 			bank--;
-			rows = Disassemble(cpuType, bank);
-			len = (int32_t)rows.size();
+			bankData = GetBank(cpuType, bank);
+			len = (int32_t)bankData->Rows.size();
 			i = len - 1;
 		}
 	}
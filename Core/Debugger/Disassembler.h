@@ -1,5 +1,7 @@
 #pragma once
 #include "pch.h"
+#include <shared_mutex>
+#include "Utilities/SimpleLock.h"
 #include "Debugger/DisassemblyInfo.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/DebugUtilities.h"
@@ -12,14 +14,51 @@ class MemoryDumper;
 class DisassemblySearch;
 class EmuSettings;
 struct SnesCpuState;
+struct DisassemblySearchIndex;
 enum class CpuType : uint8_t;
 
 struct DisassemblerSource
 {
 	vector<DisassemblyInfo> Cache;
+	vector<uint32_t> BlockVersions;
 	uint32_t Size = 0;
 };
 
+struct DisassemblerBankDependency
+{
+	MemoryType Type;
+	uint32_t Block;
+	uint32_t Version;
+};
+
+struct DisassemblerBank
+{
+	vector<DisassemblyResult> Rows;
+	
+	//Absolute address of each sampled address in the bank, used to detect mapping changes (e.g bank switching)
+	vector<AddressInfo> Mappings;
+	
+	//Blocks of absolute memory that were used to build the rows, along with their version at the time
+	vector<DisassemblerBankDependency> Dependencies;
+
+	//Formatted text for rows that have been displayed, indexed by row
+	unordered_map<int32_t, string> Text;
+
+	//Text search index for the rows (built by DisassemblySearch)
+	shared_ptr<DisassemblySearchIndex> SearchIndex;
+
+	uint64_t TextSignature = 0;
+
+	uint32_t Generation = 0;
+	uint32_t LabelVersion = 0;
+	uint32_t ConfigFlags = 0;
+	uint64_t LastAccess = 0;
+	bool IsSorted = true;
+
+	//Set when unidentified bytes in RAM were disassembled, the bank must be rebuilt each time it's used
+	bool HasVolatileCode = false;
+};
+
 class Disassembler
 {
 private:
@@ -32,16 +71,48 @@ private:
 	MemoryDumper *_memoryDumper;
 
 	DisassemblerSource _sources[DebugUtilities::GetMemoryTypeCount()] = {};
+
+	//Held by ResetPrgCache while the sources are reallocated, and by the search/index threads while they read them
+	std::shared_mutex _sourceLock;
+
+	static constexpr uint32_t MappingSampleSize = 0x40;
+	static constexpr uint32_t MaxCachedRows = 2000000;
+
+	SimpleLock _bankLock;
+	unordered_map<uint32_t, shared_ptr<DisassemblerBank>> _banks;
+	uint32_t _cachedRowCount = 0;
+	atomic<uint32_t> _cacheGeneration;
+	uint64_t _bankAccessCounter = 0;
 	
 	void InitSource(MemoryType type);
 	DisassemblerSource& GetSource(MemoryType type);
+	
+	__forceinline void MarkBlockChanged(DisassemblerSource& src, int32_t address)
+	{
+		src.BlockVersions[(uint32_t)address >> BlockShift]++;
+	}
 
-	void GetLineData(DisassemblyResult& result, CpuType type, MemoryType memType, CodeLineData& data);
-	int32_t GetMatchingRow(vector<DisassemblyResult>& rows, uint32_t address, bool returnFirstRow);
-	vector<DisassemblyResult> Disassemble(CpuType cpuType, uint16_t bank);
+	uint32_t GetBlockVersion(MemoryType type, uint32_t block);
+	uint32_t GetConfigFlags();
+	uint64_t GetAddressSpaceSignature(CpuType cpuType);
+	void GetBankMappings(CpuType cpuType, uint16_t bank, vector<AddressInfo>& mappings);
+	bool IsBankValid(DisassemblerBank& bank, CpuType cpuType, uint16_t bankNumber);
+	void DisassembleBank(CpuType cpuType, uint16_t bank, DisassemblerBank& result);
+	shared_ptr<DisassemblerBank> GetBank(CpuType cpuType, uint16_t bank);
+	shared_ptr<DisassemblerBank> GetCachedBank(CpuType cpuType, uint16_t bank);
+	std::shared_lock<std::shared_mutex> AcquireSourceReadLock() { return std::shared_lock<std::shared_mutex>(_sourceLock); }
+	shared_ptr<DisassemblySearchIndex> GetSearchIndex(DisassemblerBank& bank);
+	void SetSearchIndex(DisassemblerBank& bank, shared_ptr<DisassemblySearchIndex> index);
+
+	void GetLineData(DisassemblyResult& result, CpuType type, MemoryType memType, CodeLineData& data, string* cachedText = nullptr);
+	void GetLineData(DisassemblerBank& bank, int32_t rowIndex, CpuType type, MemoryType memType, CodeLineData& data);
+	int32_t GetMatchingRow(DisassemblerBank& bank, uint32_t address, bool returnFirstRow);
 	uint16_t GetMaxBank(CpuType cpuType);
 	
 public:
+	//Size of the blocks used to track changes to the disassembly cache (must match CodeDataLogger::BlockShift)
+	static constexpr uint32_t BlockShift = 12;
+
 	Disassembler(IConsole* console, Debugger* debugger);
 
 	uint32_t BuildCache(AddressInfo &addrInfo, uint8_t cpuFlags, CpuType type);
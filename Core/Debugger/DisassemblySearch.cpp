@@ -7,6 +7,17 @@ DisassemblySearch::DisassemblySearch(Disassembler* disassembler, LabelManager* l
 {
 	_disassembler = disassembler;
 	_labelManager = labelManager;
+	_stopIndexing = false;
+	_pendingIndexCpuTypes = 0;
+}
+
+DisassemblySearch::~DisassemblySearch()
+{
+	_stopIndexing = true;
+	_indexSignal.Signal();
+	if(_indexThread.joinable()) {
+		_indexThread.join();
+	}
 }
 
 int32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options)
@@ -27,121 +38,352 @@ uint32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searc
 	uint16_t bank = startAddress >> 16;
 	uint16_t maxBank = _disassembler->GetMaxBank(cpuType);
 
-	vector<DisassemblyResult> rows = _disassembler->Disassemble(cpuType, bank);
-	if(rows.empty()) {
-		return -1;
+	//The worker threads read the disassembly cache and the labels, prevent the UI from modifying them until the search is done
+	auto sourceLock = _disassembler->AcquireSourceReadLock();
+	auto labelLock = _labelManager->AcquireReadLock();
+
+	shared_ptr<DisassemblerBank> bankData = _disassembler->GetBank(cpuType, bank);
+	if(bankData->Rows.empty() || maxResultCount == 0) {
+		return 0;
 	}
 	int step = options.SearchBackwards ? -1 : 1;
 
-	string searchStr = searchString;
-
-	int32_t startRow = _disassembler->GetMatchingRow(rows, startAddress, options.SearchBackwards);
+	int32_t startRow = _disassembler->GetMatchingRow(*bankData, startAddress, options.SearchBackwards);
 	if(options.SearchBackwards) {
 		startRow--;
 	} else if(options.SkipFirstLine) {
 		startRow++;
 	}
 
-	if(startRow >= 0 && startRow < rows.size()) {
-		startAddress = rows[startRow].CpuAddress;
+	if(startRow >= 0 && startRow < bankData->Rows.size()) {
+		startAddress = bankData->Rows[startRow].CpuAddress;
 	}
 
-	uint32_t resultCount = 0;
+	//Split the search into segments (one per bank), in the order in which they need to be searched
+	vector<DisassemblySearchSegment> segments;
+	segments.push_back({ bank, true, startRow, -1 });
+	int nextBank = bank;
+	while(true) {
+		nextBank += step;
+		if(nextBank < 0) {
+			nextBank = maxBank;
+		} else if(nextBank > maxBank) {
+			if(startAddress == 0) {
+				break;
+			}
+			nextBank = 0;
+		}
 
-	int32_t prevAddress = -1;
+		if(nextBank == bank) {
+			//Search the start of the start bank last, until the start address is reached
+			segments.push_back({ bank, false, 0, startAddress });
+			break;
+		}
+		segments.push_back({ (uint16_t)nextBank, false, 0, -1 });
+	}
 
-	CodeLineData lineData = {};
-	int rowCounter = 0;
+	DisassemblySearchContext ctx;
+	ctx.Cpu = cpuType;
+	ctx.MemType = memType;
+	ctx.Needle = searchString;
+	ctx.Options = options;
+	ctx.MaxResultCount = maxResultCount;
+	ctx.TextSignature = _disassembler->GetAddressSpaceSignature(cpuType);
+	ctx.FormattedRows = 0;
+	ctx.Stop = false;
 
-	string txt;
+	//The index can only be used when the search string contains at least 1 trigram
+	ctx.UseIndex = ctx.Needle.size() >= 3;
+	ctx.NeedleSignature[0] = 0;
+	ctx.NeedleSignature[1] = 0;
+	AddTrigrams(ctx.Needle.c_str(), (int)ctx.Needle.size(), ctx.NeedleSignature);
 
-	do {
-		for(int i = startRow; i >= 0 && i < rows.size(); i += step) {
-			if(rows[i].CpuAddress < 0) {
-				continue;
-			}
+	//Memory values are only searched when looking for a single result, and can only match hex strings
+	ctx.CheckValues = maxResultCount == 1;
+	for(char c : ctx.Needle) {
+		if(!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F') || c == '$')) {
+			ctx.CheckValues = false;
+			break;
+		}
+	}
 
-			if(
-				(!options.SearchBackwards && prevAddress < startAddress && rows[i].CpuAddress >= startAddress) ||
-				(options.SearchBackwards && prevAddress > startAddress && rows[i].CpuAddress <= startAddress) ||
-				rowCounter > 500000
-			) {
-				if(rowCounter > 0) {
-					//Checked entire memory space without finding a match (or checked over 500k rows), give up
-					return resultCount;
-				}
-			}
+	vector<DisassemblySearchSegmentResult> results(segments.size());
+	atomic<uint32_t> nextSegment(0);
+	SimpleLock mergeLock;
+	uint32_t mergedSegments = 0;
+	uint32_t resultCount = 0;
 
-			rowCounter++;
+	auto searchWorker = [&]() {
+		while(!ctx.Stop) {
+			uint32_t index = nextSegment++;
+			if(index >= segments.size()) {
+				break;
+			}
 
-			prevAddress = rows[i].CpuAddress;
+			SearchSegment(ctx, segments[index], results[index]);
 
-			_disassembler->GetLineData(rows[i], cpuType, memType, lineData);
+			auto lock = mergeLock.AcquireSafe();
+			results[index].Done = true;
 
-			if(TextContains(searchStr, lineData.Text, 1000, options)) {
-				searchResults[resultCount] = lineData;
-				if(maxResultCount == ++resultCount) {
-					return resultCount;
+			//Merge the results of completed segments in order, to keep the results sorted by address
+			while(mergedSegments < segments.size() && results[mergedSegments].Done) {
+				DisassemblySearchSegmentResult& result = results[mergedSegments];
+				for(size_t i = 0; i < result.Lines.size() && resultCount < maxResultCount; i++) {
+					searchResults[resultCount++] = result.Lines[i];
 				}
-				continue;
-			}
+				result.Lines.clear();
+				mergedSegments++;
 
-			if(TextContains(searchStr, lineData.Comment, 1000, options)) {
-				searchResults[resultCount] = lineData;
-				if(maxResultCount == ++resultCount) {
-					return resultCount;
+				if(resultCount >= maxResultCount || result.Aborted || result.EndOfSearch) {
+					ctx.Stop = true;
+					break;
 				}
-				continue;
 			}
+		}
+	};
 
-			if(lineData.EffectiveAddress.ShowAddress && lineData.EffectiveAddress.Address >= 0) {
-				txt = _labelManager->GetLabel({ lineData.EffectiveAddress.Address, memType });
-				if(txt.empty()) {
-					txt = "[$" + DebugUtilities::AddressToHex(lineData.LineCpuType, lineData.EffectiveAddress.Address) + "]";
-				} else {
-					txt = "[" + txt + "]";
-				}
+	uint32_t threadCount = std::clamp<uint32_t>(std::thread::hardware_concurrency(), 1, MaxSearchThreads);
+	threadCount = std::min<uint32_t>(threadCount, (uint32_t)segments.size());
 
-				if(TextContains(searchStr, txt.c_str(), (int)txt.size(), options)) {
-					searchResults[resultCount] = lineData;
-					if(maxResultCount == ++resultCount) {
-						return resultCount;
-					}
-					continue;
-				}
-			}
+	vector<std::thread> threads;
+	for(uint32_t i = 1; i < threadCount; i++) {
+		threads.push_back(std::thread(searchWorker));
+	}
+	searchWorker();
+	for(std::thread& thread : threads) {
+		thread.join();
+	}
 
-			if(maxResultCount == 1 && lineData.EffectiveAddress.ValueSize > 0) {
-				txt = "$" + (lineData.EffectiveAddress.ValueSize == 2 ? HexUtilities::ToHex((uint16_t)lineData.Value) : HexUtilities::ToHex((uint8_t)lineData.Value));
-				if(TextContains(searchStr, txt.c_str(), (int)txt.size(), options)) {
-					searchResults[resultCount] = lineData;
-					if(maxResultCount == ++resultCount) {
-						return resultCount;
-					}
-					continue;
-				}
+	RequestIndexing(cpuType);
+
+	return resultCount;
+}
+
+void DisassemblySearch::SearchSegment(DisassemblySearchContext& ctx, DisassemblySearchSegment& segment, DisassemblySearchSegmentResult& result)
+{
+	shared_ptr<DisassemblerBank> bankData = _disassembler->GetBank(ctx.Cpu, segment.Bank);
+	vector<DisassemblyResult>& rows = bankData->Rows;
+	if(rows.empty()) {
+		result.EndOfSearch = true;
+		return;
+	}
+
+	shared_ptr<DisassemblySearchIndex> index = _disassembler->GetSearchIndex(*bankData);
+	if(index && index->TextSignature != ctx.TextSignature) {
+		index.reset();
+	}
+	bool useIndex = index && ctx.UseIndex;
+
+	//When an entire bank is scanned, build its index at the same time
+	shared_ptr<DisassemblySearchIndex> newIndex;
+	if(!index && !segment.UseStartRow && segment.StopAddress < 0) {
+		newIndex.reset(new DisassemblySearchIndex());
+		newIndex->Signatures.resize(rows.size() * 2);
+		newIndex->Flags.resize(rows.size());
+		newIndex->TextSignature = ctx.TextSignature;
+	}
+
+	int32_t step = ctx.Options.SearchBackwards ? -1 : 1;
+	int32_t startRow = segment.UseStartRow ? segment.StartRow : (step > 0 ? 0 : (int32_t)rows.size() - 1);
+
+	CodeLineData lineData = {};
+	string txt;
+
+	for(int32_t i = startRow; i >= 0 && i < (int32_t)rows.size(); i += step) {
+		if((i & 0xFF) == 0 && ctx.Stop) {
+			result.Aborted = true;
+			return;
+		}
+
+		DisassemblyResult& row = rows[i];
+		if(row.CpuAddress < 0) {
+			continue;
+		}
+
+		if(segment.StopAddress >= 0 && (step > 0 ? row.CpuAddress >= segment.StopAddress : row.CpuAddress <= segment.StopAddress)) {
+			//Checked entire memory space
+			result.EndOfSearch = true;
+			return;
+		}
+
+		if(useIndex && !IsIndexCandidate(ctx, *index, i)) {
+			continue;
+		}
+
+		if(++ctx.FormattedRows > MaxFormattedRows) {
+			//Checked too many rows, give up
+			ctx.Stop = true;
+			result.Aborted = true;
+			return;
+		}
+
+		_disassembler->GetLineData(row, ctx.Cpu, ctx.MemType, lineData);
+
+		if(newIndex) {
+			UpdateIndex(*newIndex, i, lineData);
+		}
+
+		if(result.Lines.size() < ctx.MaxResultCount && IsMatch(ctx, lineData, txt)) {
+			result.Lines.push_back(lineData);
+			if(result.Lines.size() >= ctx.MaxResultCount && !newIndex) {
+				return;
 			}
 		}
+	}
 
-		//No match found, go to next/previous bank
-		int nextBank = (int)bank + step;
-		if(nextBank < 0) {
-			nextBank = maxBank;
-		} else if(nextBank > maxBank) {
-			if(startAddress == 0) {
-				return resultCount;
+	if(newIndex) {
+		_disassembler->SetSearchIndex(*bankData, newIndex);
+	}
+}
+
+bool DisassemblySearch::IsMatch(DisassemblySearchContext& ctx, CodeLineData& lineData, string& txt)
+{
+	if(TextContains(ctx.Needle, lineData.Text, 1000, ctx.Options)) {
+		return true;
+	}
+
+	if(TextContains(ctx.Needle, lineData.Comment, 1000, ctx.Options)) {
+		return true;
+	}
+
+	if(lineData.EffectiveAddress.ShowAddress && lineData.EffectiveAddress.Address >= 0) {
+		txt = _labelManager->GetLabel({ lineData.EffectiveAddress.Address, ctx.MemType });
+		if(txt.empty()) {
+			txt = "[$" + DebugUtilities::AddressToHex(lineData.LineCpuType, lineData.EffectiveAddress.Address) + "]";
+		} else {
+			txt = "[" + txt + "]";
+		}
+
+		if(TextContains(ctx.Needle, txt.c_str(), (int)txt.size(), ctx.Options)) {
+			return true;
+		}
+	}
+
+	if(ctx.MaxResultCount == 1 && lineData.EffectiveAddress.ValueSize > 0) {
+		txt = "$" + (lineData.EffectiveAddress.ValueSize == 2 ? HexUtilities::ToHex((uint16_t)lineData.Value) : HexUtilities::ToHex((uint8_t)lineData.Value));
+		if(TextContains(ctx.Needle, txt.c_str(), (int)txt.size(), ctx.Options)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void DisassemblySearch::AddTrigrams(const char* text, int size, uint64_t signature[2])
+{
+	//Sets 1 bit (out of 128) per trigram, case-insensitive (the index must match a superset of what TextContains matches)
+	uint32_t prev = 0;
+	for(int i = 0; i < size; i++) {
+		char c = text[i];
+		if(c <= 0) {
+			break;
+		}
+
+		prev = ((prev << 8) | (uint8_t)tolower(c)) & 0xFFFFFF;
+		if(i >= 2) {
+			uint32_t bit = (prev * 2654435761u) >> 25;
+			signature[bit >> 6] |= 1ULL << (bit & 0x3F);
+		}
+	}
+}
+
+void DisassemblySearch::UpdateIndex(DisassemblySearchIndex& index, int32_t row, CodeLineData& lineData)
+{
+	uint64_t signature[2] = {};
+	AddTrigrams(lineData.Text, 1000, signature);
+	AddTrigrams(lineData.Comment, 1000, signature);
+	index.Signatures[row * 2] = signature[0];
+	index.Signatures[row * 2 + 1] = signature[1];
+
+	uint8_t flags = SearchIndexFlags::None;
+	if(lineData.EffectiveAddress.ShowAddress) {
+		flags |= SearchIndexFlags::EffectiveAddress;
+	}
+	if(lineData.EffectiveAddress.ValueSize > 0) {
+		flags |= SearchIndexFlags::Value;
+	}
+	index.Flags[row] = flags;
+}
+
+bool DisassemblySearch::IsIndexCandidate(DisassemblySearchContext& ctx, DisassemblySearchIndex& index, int32_t row)
+{
+	uint8_t flags = index.Flags[row];
+	if((flags & SearchIndexFlags::EffectiveAddress) || ((flags & SearchIndexFlags::Value) && ctx.CheckValues)) {
+		//Effective address & memory value depend on the CPU's state, these rows must always be checked
+		return true;
+	}
+
+	return (
+		(index.Signatures[row * 2] & ctx.NeedleSignature[0]) == ctx.NeedleSignature[0] &&
+		(index.Signatures[row * 2 + 1] & ctx.NeedleSignature[1]) == ctx.NeedleSignature[1]
+	);
+}
+
+void DisassemblySearch::RequestIndexing(CpuType cpuType)
+{
+	_pendingIndexCpuTypes |= 1 << (int)cpuType;
+	if(!_indexThread.joinable()) {
+		_indexThread = std::thread(&DisassemblySearch::IndexThread, this);
+	}
+	_indexSignal.Signal();
+}
+
+void DisassemblySearch::IndexThread()
+{
+	while(!_stopIndexing) {
+		_indexSignal.Wait();
+
+		uint32_t pending = _pendingIndexCpuTypes.exchange(0);
+		for(int i = 0; i <= (int)DebugUtilities::GetLastCpuType() && !_stopIndexing; i++) {
+			if(pending & (1 << i)) {
+				IndexBanks((CpuType)i);
 			}
-			nextBank = 0;
 		}
-		bank = (uint16_t)nextBank;
-		rows = _disassembler->Disassemble(cpuType, bank);
-		if(rows.empty()) {
-			return resultCount;
+	}
+}
+
+void DisassemblySearch::IndexBanks(CpuType cpuType)
+{
+	//Build the index for the cached banks that were not fully scanned by the previous searches, to speed up the next ones
+	//Banks that are not in the cache are skipped, disassembling them here would evict the banks used by the UI
+	MemoryType memType = DebugUtilities::GetCpuMemoryType(cpuType);
+	uint64_t textSignature = _disassembler->GetAddressSpaceSignature(cpuType);
+	uint16_t maxBank = _disassembler->GetMaxBank(cpuType);
+	CodeLineData lineData = {};
+
+	for(uint32_t bank = 0; bank <= maxBank; bank++) {
+		if(_stopIndexing || _pendingIndexCpuTypes) {
+			//Stop if another search was started, it will restart the indexing once it's done
+			return;
 		}
-		startRow = options.SearchBackwards ? (int32_t)rows.size() - 1 : 0;
-	} while(true);
 
-	return resultCount;
+		//Locks are only held while a single bank is indexed, to avoid blocking the UI for long
+		auto sourceLock = _disassembler->AcquireSourceReadLock();
+		auto labelLock = _labelManager->AcquireReadLock();
+
+		shared_ptr<DisassemblerBank> bankData = _disassembler->GetCachedBank(cpuType, bank);
+		if(!bankData) {
+			continue;
+		}
+
+		shared_ptr<DisassemblySearchIndex> index = _disassembler->GetSearchIndex(*bankData);
+		if(index && index->TextSignature == textSignature) {
+			continue;
+		}
+
+		vector<DisassemblyResult>& rows = bankData->Rows;
+		index.reset(new DisassemblySearchIndex());
+		index->Signatures.resize(rows.size() * 2);
+		index->Flags.resize(rows.size());
+		index->TextSignature = textSignature;
+		for(int32_t i = 0; i < (int32_t)rows.size(); i++) {
+			if(rows[i].CpuAddress >= 0) {
+				_disassembler->GetLineData(rows[i], cpuType, memType, lineData);
+				UpdateIndex(*index, i, lineData);
+			}
+		}
+		_disassembler->SetSearchIndex(*bankData, index);
+	}
 }
 
 bool DisassemblySearch::TextContains(string& needle, const char* hay, int size, DisassemblySearchOptions& options)
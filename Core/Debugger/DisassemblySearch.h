@@ -3,9 +3,11 @@
 #include "Debugger/DisassemblyInfo.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/DebugUtilities.h"
+#include "Utilities/AutoResetEvent.h"
 
 class Disassembler;
 class LabelManager;
+struct DisassemblerBank;
 enum class CpuType : uint8_t;
 
 struct DisassemblySearchOptions
@@ -16,13 +18,87 @@ struct DisassemblySearchOptions
 	bool SkipFirstLine;
 };
 
+namespace SearchIndexFlags
+{
+	enum SearchIndexFlags : uint8_t
+	{
+		None = 0,
+		EffectiveAddress = 1,
+		Value = 2
+	};
+}
+
+struct DisassemblySearchIndex
+{
+	//128-bit signature (2 values per row) of the trigrams contained in each row's text and comment
+	vector<uint64_t> Signatures;
+
+	//Rows that contain text that depends on the CPU state (effective address, memory value) and must always be checked
+	vector<uint8_t> Flags;
+
+	//Signature of the memory mappings when the index was built (labels in the text depend on them)
+	uint64_t TextSignature = 0;
+};
+
+struct DisassemblySearchSegment
+{
+	uint16_t Bank;
+	bool UseStartRow;
+	int32_t StartRow;
+	int32_t StopAddress;
+};
+
+struct DisassemblySearchSegmentResult
+{
+	vector<CodeLineData> Lines;
+	bool Done = false;
+	bool Aborted = false;
+	bool EndOfSearch = false;
+};
+
+struct DisassemblySearchContext
+{
+	CpuType Cpu;
+	MemoryType MemType;
+	string Needle;
+	DisassemblySearchOptions Options;
+	uint32_t MaxResultCount;
+	uint64_t TextSignature;
+
+	bool UseIndex;
+	bool CheckValues;
+	uint64_t NeedleSignature[2];
+
+	atomic<uint32_t> FormattedRows;
+	atomic<bool> Stop;
+};
+
 class DisassemblySearch
 {
 private:
+	//Max number of rows that are formatted and compared by a single search
+	static constexpr uint32_t MaxFormattedRows = 500000;
+	static constexpr uint32_t MaxSearchThreads = 8;
+
 	Disassembler* _disassembler;
 	LabelManager* _labelManager;
 
+	std::thread _indexThread;
+	AutoResetEvent _indexSignal;
+	atomic<bool> _stopIndexing;
+	atomic<uint32_t> _pendingIndexCpuTypes;
+
 	uint32_t SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options, CodeLineData searchResults[], uint32_t maxResultCount);
+	void SearchSegment(DisassemblySearchContext& ctx, DisassemblySearchSegment& segment, DisassemblySearchSegmentResult& result);
+	bool IsMatch(DisassemblySearchContext& ctx, CodeLineData& lineData, string& txt);
+
+	static void AddTrigrams(const char* text, int size, uint64_t signature[2]);
+	void UpdateIndex(DisassemblySearchIndex& index, int32_t row, CodeLineData& lineData);
+	bool IsIndexCandidate(DisassemblySearchContext& ctx, DisassemblySearchIndex& index, int32_t row);
+
+	void RequestIndexing(CpuType cpuType);
+	void IndexThread();
+	void IndexBanks(CpuType cpuType);
 
 	template<bool matchCase> bool TextContains(string& needle, const char* hay, int size, DisassemblySearchOptions& options);
 	bool TextContains(string& needle, const char* hay, int size, DisassemblySearchOptions& options);
@@ -30,7 +106,8 @@ private:
 
 public:
 	DisassemblySearch(Disassembler* disassembler, LabelManager* labelManager);
+	~DisassemblySearch();
 
 	int32_t SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options);
 	uint32_t FindOccurrences(CpuType cpuType, const char* searchString, DisassemblySearchOptions options, CodeLineData output[], uint32_t maxResultCount);
-};
\ No newline at end of file
+};
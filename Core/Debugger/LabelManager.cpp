@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "Debugger/LabelManager.h"
+#include "Debugger/LabelWorkspace.h"
 #include "Debugger/Debugger.h"
 #include "Debugger/DebugUtilities.h"
 #include "Debugger/DebugBreakHelper.h"
@@ -7,19 +8,122 @@
 LabelManager::LabelManager(Debugger *debugger)
 {
 	_debugger = debugger;
+	_version = 0;
+}
+
+LabelManager::~LabelManager()
+{
 }
 
 void LabelManager::ClearLabels()
 {
 	DebugBreakHelper helper(_debugger);
+	std::unique_lock<std::shared_mutex> lock(_labelLock);
+	_codeLabels.clear();
+	_codeLabelReverseLookup.clear();
+	_workspace.reset();
+	_version++;
+}
+
+bool LabelManager::LoadWorkspace(string filepath)
+{
+	unique_ptr<LabelWorkspace> workspace(new LabelWorkspace());
+	if(!workspace->Open(filepath)) {
+		return false;
+	}
+
+	DebugBreakHelper helper(_debugger);
+	std::unique_lock<std::shared_mutex> lock(_labelLock);
+	_codeLabels.clear();
+	_codeLabelReverseLookup.clear();
+	_workspace = std::move(workspace);
+	_version++;
+	return true;
+}
+
+bool LabelManager::SaveWorkspace(string filepath)
+{
+	DebugBreakHelper helper(_debugger);
+	std::unique_lock<std::shared_mutex> lock(_labelLock);
+
+	vector<std::pair<uint64_t, LabelInfo>> labels;
+	if(_workspace) {
+		uint64_t key;
+		LabelInfo label;
+		for(uint32_t i = 0, len = _workspace->GetEntryCount(); i < len; i++) {
+			_workspace->GetEntry(i, key, label);
+			if(_codeLabels.find(key) == _codeLabels.end()) {
+				labels.push_back({ key, label });
+			}
+		}
+	}
+
+	for(auto& label : _codeLabels) {
+		if(!label.second.Label.empty() || !label.second.Comment.empty()) {
+			labels.push_back({ label.first, label.second });
+		}
+	}
+
+	//Release the mapping before overwriting the file (it may be the file currently in use)
+	_workspace.reset();
 	_codeLabels.clear();
 	_codeLabelReverseLookup.clear();
+
+	bool result = LabelWorkspace::Save(filepath, labels);
+	if(result) {
+		_workspace.reset(new LabelWorkspace());
+		result = _workspace->Open(filepath);
+	}
+
+	if(!result) {
+		//Keep the labels in memory if the file couldn't be written/reopened
+		_workspace.reset();
+		for(auto& label : labels) {
+			_codeLabels.emplace(label.first, label.second);
+			_codeLabelReverseLookup.emplace(label.second.Label, label.first);
+		}
+	}
+	_version++;
+	return result;
+}
+
+bool LabelManager::FindLabel(uint64_t key, string* label, string* comment)
+{
+	auto result = _codeLabels.find(key);
+	if(result != _codeLabels.end()) {
+		if(result->second.Label.empty() && result->second.Comment.empty()) {
+			//Label was removed from the workspace
+			return false;
+		}
+		if(label) {
+			*label = result->second.Label;
+		}
+		if(comment) {
+			*comment = result->second.Comment;
+		}
+		return true;
+	}
+	return _workspace && _workspace->GetLabel(key, label, comment);
+}
+
+bool LabelManager::FindLabelKey(string& label, uint64_t& key)
+{
+	auto result = _codeLabelReverseLookup.find(label);
+	if(result != _codeLabelReverseLookup.end()) {
+		key = result->second;
+		return true;
+	}
+
+	//Labels in the workspace are only valid if they weren't changed since the workspace was loaded
+	return _workspace && _workspace->GetLabelKey(label, key) && _codeLabels.find(key) == _codeLabels.end();
 }
 
 void LabelManager::SetLabel(uint32_t address, MemoryType memType, string label, string comment)
 {
 	DebugBreakHelper helper(_debugger);
+	std::unique_lock<std::shared_mutex> lock(_labelLock);
 	uint64_t key = GetLabelKey(address, memType);
+	_version++;
 
 	auto existingLabel = _codeLabels.find(key);
 	if(existingLabel != _codeLabels.end()) {
@@ -39,6 +143,9 @@ void LabelManager::SetLabel(uint32_t address, MemoryType memType, string label,
 
 		_codeLabels.emplace(key, labelInfo);
 		_codeLabelReverseLookup.emplace(label, key);
+	} else if(_workspace && _workspace->HasLabel(key)) {
+		//Hide the label stored in the workspace
+		_codeLabels.emplace(key, LabelInfo());
 	}
 }
 
@@ -73,25 +180,16 @@ string LabelManager::GetLabel(AddressInfo address, bool checkRegisterLabels)
 bool LabelManager::InternalGetLabel(AddressInfo address, string &label)
 {
 	int64_t key = GetLabelKey(address.Address, address.Type);
-	if(key >= 0) {
-		auto result = _codeLabels.find(key);
-		if(result != _codeLabels.end()) {
-			label = result->second.Label;
-			return true;
-		}
-	}
-	return false;
+	return key >= 0 && FindLabel(key, &label, nullptr);
 }
 
 string LabelManager::GetComment(AddressInfo absAddress)
 {
 	uint64_t key = GetLabelKey(absAddress.Address, absAddress.Type);
 
-	if(key >= 0) {
-		auto result = _codeLabels.find(key);
-		if(result != _codeLabels.end()) {
-			return result->second.Comment;
-		}
+	string comment;
+	if(key >= 0 && FindLabel(key, nullptr, &comment)) {
+		return comment;
 	}
 
 	return "";
@@ -106,12 +204,8 @@ bool LabelManager::GetLabelAndComment(AddressInfo address, LabelInfo &labelInfo)
 	if(address.Address >= 0) {
 		int64_t key = GetLabelKey(address.Address, address.Type);
 
-		if(key >= 0) {
-			auto result = _codeLabels.find(key);
-			if(result != _codeLabels.end()) {
-				labelInfo = result->second;
-				return true;
-			}
+		if(key >= 0 && FindLabel(key, &labelInfo.Label, &labelInfo.Comment)) {
+			return true;
 		}
 	}
 	return false;
@@ -119,15 +213,15 @@ bool LabelManager::GetLabelAndComment(AddressInfo address, LabelInfo &labelInfo)
 
 bool LabelManager::ContainsLabel(string &label)
 {
-	return _codeLabelReverseLookup.find(label) != _codeLabelReverseLookup.end();
+	uint64_t key;
+	return FindLabelKey(label, key);
 }
 
 AddressInfo LabelManager::GetLabelAbsoluteAddress(string& label)
 {
 	AddressInfo addr = { -1, MemoryType::None };
-	auto result = _codeLabelReverseLookup.find(label);
-	if(result != _codeLabelReverseLookup.end()) {
-		uint64_t key = result->second;
+	uint64_t key;
+	if(FindLabelKey(label, key)) {
 		addr.Type = GetKeyMemoryType(key);
 		addr.Address = (int32_t)(key & 0xFFFFFFFF);
 	}
@@ -136,9 +230,8 @@ AddressInfo LabelManager::GetLabelAbsoluteAddress(string& label)
 
 int32_t LabelManager::GetLabelRelativeAddress(string &label, CpuType cpuType)
 {
-	auto result = _codeLabelReverseLookup.find(label);
-	if(result != _codeLabelReverseLookup.end()) {
-		uint64_t key = result->second;
+	uint64_t key;
+	if(FindLabelKey(label, key)) {
 		MemoryType type = GetKeyMemoryType(key);
 		AddressInfo addr { (int32_t)(key & 0xFFFFFFFF), type };
 		if(DebugUtilities::IsRelativeMemory(type)) {
@@ -159,7 +252,7 @@ bool LabelManager::HasLabelOrComment(AddressInfo address)
 	if(address.Address >= 0) {
 		uint64_t key = GetLabelKey(address.Address, address.Type);
 		if(key >= 0) {
-			return _codeLabels.find(key) != _codeLabels.end();
+			return FindLabel(key, nullptr, nullptr);
 		}
 	}
 	return false;
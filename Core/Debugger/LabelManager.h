@@ -2,9 +2,12 @@
 #include "pch.h"
 #include <unordered_map>
 #include <functional>
+#include <mutex>
+#include <shared_mutex>
 #include "Debugger/DebugTypes.h"
 
 class Debugger;
+class LabelWorkspace;
 
 class AddressHasher
 {
@@ -25,21 +28,34 @@ struct LabelInfo
 class LabelManager
 {
 private:
+	//Labels added/changed since the workspace was loaded (an empty label+comment hides the workspace's label)
 	unordered_map<uint64_t, LabelInfo, AddressHasher> _codeLabels;
 	unordered_map<string, uint64_t> _codeLabelReverseLookup;
+	unique_ptr<LabelWorkspace> _workspace;
 
 	Debugger *_debugger;
+	atomic<uint32_t> _version;
+
+	//Taken by writers, and by the disassembly search/index threads while they read labels
+	//(the other readers run on the UI thread, or on the emulation thread which is paused by writers)
+	std::shared_mutex _labelLock;
 
 	int64_t GetLabelKey(uint32_t absoluteAddr, MemoryType memType);
 	MemoryType GetKeyMemoryType(uint64_t key);
 	bool InternalGetLabel(AddressInfo address, string& label);
+	bool FindLabel(uint64_t key, string* label, string* comment);
+	bool FindLabelKey(string& label, uint64_t& key);
 
 public:
 	LabelManager(Debugger *debugger);
+	~LabelManager();
 
 	void SetLabel(uint32_t address, MemoryType memType, string label, string comment);
 	void ClearLabels();
 
+	bool LoadWorkspace(string filepath);
+	bool SaveWorkspace(string filepath);
+
 	AddressInfo GetLabelAbsoluteAddress(string& label);
 	int32_t GetLabelRelativeAddress(string &label, CpuType cpuType);
 
@@ -50,4 +66,10 @@ public:
 	bool ContainsLabel(string &label);
 
 	bool HasLabelOrComment(AddressInfo address);
+
+	//Incremented every time a label or comment is added, changed or removed
+	uint32_t GetVersion() { return _version; }
+
+	//Must be held by background threads while they read labels
+	std::shared_lock<std::shared_mutex> AcquireReadLock() { return std::shared_lock<std::shared_mutex>(_labelLock); }
 };
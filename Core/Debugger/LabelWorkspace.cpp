@@ -0,0 +1,153 @@
+#include "pch.h"
+#include "Debugger/LabelWorkspace.h"
+#include "Debugger/LabelManager.h"
+
+bool LabelWorkspace::Open(string filepath)
+{
+	if(!_file.Open(filepath) || _file.GetSize() < sizeof(LabelWorkspaceHeader)) {
+		_file.Close();
+		return false;
+	}
+
+	uint8_t* data = _file.GetData();
+	LabelWorkspaceHeader* header = (LabelWorkspaceHeader*)data;
+	uint64_t entriesSize = (uint64_t)header->EntryCount * sizeof(LabelWorkspaceEntry);
+	uint64_t nameIndexSize = (uint64_t)header->NameCount * sizeof(uint32_t);
+	uint64_t expectedSize = sizeof(LabelWorkspaceHeader) + entriesSize + nameIndexSize + header->StringPoolSize;
+	if(memcmp(header->Magic, "MLBL", 4) != 0 || header->Version != FileVersion || header->NameCount > header->EntryCount || _file.GetSize() < expectedSize) {
+		_file.Close();
+		return false;
+	}
+
+	LabelWorkspaceEntry* entries = (LabelWorkspaceEntry*)(data + sizeof(LabelWorkspaceHeader));
+	uint32_t* nameIndex = (uint32_t*)(data + sizeof(LabelWorkspaceHeader) + entriesSize);
+
+	//Make sure every entry only refers to data inside the file (the file may be truncated or corrupted)
+	for(uint32_t i = 0; i < header->EntryCount; i++) {
+		LabelWorkspaceEntry& entry = entries[i];
+		bool validEntry = (
+			(uint64_t)entry.LabelOffset + entry.LabelLength <= header->StringPoolSize &&
+			(uint64_t)entry.CommentOffset + entry.CommentLength <= header->StringPoolSize &&
+			(i == 0 || entries[i - 1].Key < entry.Key)
+		);
+		if(!validEntry) {
+			_file.Close();
+			return false;
+		}
+	}
+
+	for(uint32_t i = 0; i < header->NameCount; i++) {
+		if(nameIndex[i] >= header->EntryCount) {
+			_file.Close();
+			return false;
+		}
+	}
+
+	_entryCount = header->EntryCount;
+	_nameCount = header->NameCount;
+	_entries = entries;
+	_nameIndex = nameIndex;
+	_stringPool = (char*)(data + sizeof(LabelWorkspaceHeader) + entriesSize + nameIndexSize);
+	return true;
+}
+
+LabelWorkspaceEntry* LabelWorkspace::FindEntry(uint64_t key)
+{
+	LabelWorkspaceEntry* end = _entries + _entryCount;
+	LabelWorkspaceEntry* entry = std::lower_bound(_entries, end, key, [](const LabelWorkspaceEntry& a, uint64_t b) { return a.Key < b; });
+	return (entry != end && entry->Key == key) ? entry : nullptr;
+}
+
+int LabelWorkspace::CompareLabel(LabelWorkspaceEntry& entry, const string& label)
+{
+	int result = memcmp(_stringPool + entry.LabelOffset, label.c_str(), std::min<size_t>(entry.LabelLength, label.size()));
+	if(result == 0) {
+		return entry.LabelLength < label.size() ? -1 : (entry.LabelLength > label.size() ? 1 : 0);
+	}
+	return result;
+}
+
+bool LabelWorkspace::HasLabel(uint64_t key)
+{
+	return FindEntry(key) != nullptr;
+}
+
+bool LabelWorkspace::GetLabel(uint64_t key, string* label, string* comment)
+{
+	LabelWorkspaceEntry* entry = FindEntry(key);
+	if(entry) {
+		if(label) {
+			label->assign(_stringPool + entry->LabelOffset, entry->LabelLength);
+		}
+		if(comment) {
+			comment->assign(_stringPool + entry->CommentOffset, entry->CommentLength);
+		}
+		return true;
+	}
+	return false;
+}
+
+bool LabelWorkspace::GetLabelKey(const string& label, uint64_t& key)
+{
+	uint32_t* end = _nameIndex + _nameCount;
+	uint32_t* result = std::lower_bound(_nameIndex, end, label, [this](uint32_t index, const string& b) { return CompareLabel(_entries[index], b) < 0; });
+	if(result != end && CompareLabel(_entries[*result], label) == 0) {
+		key = _entries[*result].Key;
+		return true;
+	}
+	return false;
+}
+
+void LabelWorkspace::GetEntry(uint32_t index, uint64_t& key, LabelInfo& label)
+{
+	LabelWorkspaceEntry& entry = _entries[index];
+	key = entry.Key;
+	label.Label = string(_stringPool + entry.LabelOffset, entry.LabelLength);
+	label.Comment = string(_stringPool + entry.CommentOffset, entry.CommentLength);
+}
+
+bool LabelWorkspace::Save(string filepath, vector<std::pair<uint64_t, LabelInfo>>& labels)
+{
+	std::sort(labels.begin(), labels.end(), [](const std::pair<uint64_t, LabelInfo>& a, const std::pair<uint64_t, LabelInfo>& b) { return a.first < b.first; });
+
+	vector<LabelWorkspaceEntry> entries;
+	vector<uint32_t> nameIndex;
+	string stringPool;
+	entries.reserve(labels.size());
+	for(std::pair<uint64_t, LabelInfo>& label : labels) {
+		LabelWorkspaceEntry entry = {};
+		entry.Key = label.first;
+		entry.LabelOffset = (uint32_t)stringPool.size();
+		entry.LabelLength = (uint32_t)label.second.Label.size();
+		stringPool += label.second.Label;
+		entry.CommentOffset = (uint32_t)stringPool.size();
+		entry.CommentLength = (uint32_t)label.second.Comment.size();
+		stringPool += label.second.Comment;
+
+		if(entry.LabelLength > 0) {
+			nameIndex.push_back((uint32_t)entries.size());
+		}
+		entries.push_back(entry);
+	}
+
+	std::sort(nameIndex.begin(), nameIndex.end(), [&](uint32_t a, uint32_t b) { return labels[a].second.Label < labels[b].second.Label; });
+
+	ofstream file(filepath, ios::out | ios::binary);
+	if(!file) {
+		return false;
+	}
+
+	LabelWorkspaceHeader header = {};
+	memcpy(header.Magic, "MLBL", 4);
+	header.Version = FileVersion;
+	header.EntryCount = (uint32_t)entries.size();
+	header.NameCount = (uint32_t)nameIndex.size();
+	header.StringPoolSize = (uint32_t)stringPool.size();
+
+	file.write((char*)&header, sizeof(header));
+	file.write((char*)entries.data(), entries.size() * sizeof(LabelWorkspaceEntry));
+	file.write((char*)nameIndex.data(), nameIndex.size() * sizeof(uint32_t));
+	file.write(stringPool.data(), stringPool.size());
+	file.close();
+	return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "pch.h"
+#include "Utilities/MemoryMappedFile.h"
+
+struct LabelInfo;
+
+struct LabelWorkspaceHeader
+{
+	char Magic[4];
+	uint32_t Version;
+	uint32_t EntryCount;
+	uint32_t NameCount;
+	uint32_t StringPoolSize;
+	uint32_t Reserved;
+};
+
+struct LabelWorkspaceEntry
+{
+	uint64_t Key;
+	uint32_t LabelOffset;
+	uint32_t LabelLength;
+	uint32_t CommentOffset;
+	uint32_t CommentLength;
+};
+
+//Read-only, memory-mapped label file.
+//Layout: header, entries (sorted by key), name index (entry indexes sorted by label), string pool
+class LabelWorkspace
+{
+private:
+	static constexpr uint32_t FileVersion = 1;
+
+	MemoryMappedFile _file;
+	LabelWorkspaceEntry* _entries = nullptr;
+	uint32_t* _nameIndex = nullptr;
+	char* _stringPool = nullptr;
+	uint32_t _entryCount = 0;
+	uint32_t _nameCount = 0;
+
+	LabelWorkspaceEntry* FindEntry(uint64_t key);
+	int CompareLabel(LabelWorkspaceEntry& entry, const string& label);
+
+public:
+	bool Open(string filepath);
+
+	bool HasLabel(uint64_t key);
+	//Only fills the requested fields (label and/or comment can be null)
+	bool GetLabel(uint64_t key, string* label, string* comment);
+	bool GetLabelKey(const string& label, uint64_t& key);
+
+	uint32_t GetEntryCount() { return _entryCount; }
+	void GetEntry(uint32_t index, uint64_t& key, LabelInfo& label);
+
+	static bool Save(string filepath, vector<std::pair<uint64_t, LabelInfo>>& labels);
+};
@@ -92,6 +92,8 @@ int LuaApi::GetLibrary(lua_State *lua)
 		{ "write", LuaApi::WriteMemory },
 		{ "readWord", LuaApi::ReadMemoryWord },
 		{ "writeWord", LuaApi::WriteMemoryWord },
+		{ "readBlock", LuaApi::ReadMemoryBlock },
+		{ "writeBlock", LuaApi::WriteMemoryBlock },
 		
 		{ "convertAddress", LuaApi::ConvertAddress },
 		{ "getLabelAddress", LuaApi::GetLabelAddress },
@@ -300,6 +302,79 @@ int LuaApi::WriteMemoryWord(lua_State *lua)
 	return l.ReturnCount();
 }
 
+int LuaApi::ReadMemoryBlock(lua_State *lua)
+{
+	//emu.readBlock(address, length, memType, [table])
+	//Returns the data as a string, or fills the given table (1-based) if one is provided
+	lua_settop(lua, 4);
+	int64_t address = luaL_checkinteger(lua, 1);
+	int64_t length = luaL_checkinteger(lua, 2);
+	int type = (int)luaL_checkinteger(lua, 3);
+	bool fillTable = lua_istable(lua, 4);
+	MemoryType memType = (MemoryType)(type & 0xFF);
+	errorCond(address < 0, "address must be >= 0");
+	errorCond(length < 0, "length must be >= 0");
+	checkEnum(MemoryType, memType, "invalid memory type");
+	errorCond(address + length > _memoryDumper->GetMemorySize(memType), "address range is out of bounds");
+
+	if(fillTable) {
+		vector<uint8_t> data(length);
+		if(length > 0) {
+			_memoryDumper->GetMemoryValues(memType, (uint32_t)address, (uint32_t)(address + length - 1), data.data());
+		}
+		for(int64_t i = 0; i < length; i++) {
+			lua_pushinteger(lua, data[i]);
+			lua_rawseti(lua, 4, i + 1);
+		}
+		lua_settop(lua, 4);
+	} else {
+		luaL_Buffer buffer;
+		char* data = luaL_buffinitsize(lua, &buffer, (size_t)length);
+		if(length > 0) {
+			_memoryDumper->GetMemoryValues(memType, (uint32_t)address, (uint32_t)(address + length - 1), (uint8_t*)data);
+		}
+		luaL_pushresultsize(&buffer, (size_t)length);
+	}
+	return 1;
+}
+
+int LuaApi::WriteMemoryBlock(lua_State *lua)
+{
+	//emu.writeBlock(address, data, memType) - data can be a string or a table of byte values (1-based)
+	lua_settop(lua, 3);
+	int64_t address = luaL_checkinteger(lua, 1);
+	int type = (int)luaL_checkinteger(lua, 3);
+	bool disableSideEffects = (type & 0x100) == 0x100;
+	MemoryType memType = (MemoryType)(type & 0xFF);
+	errorCond(address < 0, "address must be >= 0");
+	checkEnum(MemoryType, memType, "invalid memory type");
+
+	vector<uint8_t> data;
+	if(lua_type(lua, 2) == LUA_TSTRING) {
+		size_t len = 0;
+		const char* str = lua_tolstring(lua, 2, &len);
+		data.insert(data.end(), (uint8_t*)str, (uint8_t*)str + len);
+	} else if(lua_istable(lua, 2)) {
+		size_t len = lua_rawlen(lua, 2);
+		data.resize(len);
+		for(size_t i = 0; i < len; i++) {
+			lua_rawgeti(lua, 2, (lua_Integer)i + 1);
+			lua_Integer value = lua_tointeger(lua, -1);
+			lua_pop(lua, 1);
+			errorCond(value > 255 || value < -128, "value out of range");
+			data[i] = (uint8_t)value;
+		}
+	} else {
+		error("data must be a string or a table");
+	}
+
+	errorCond(address + (int64_t)data.size() > _memoryDumper->GetMemorySize(memType), "address range is out of bounds");
+	if(data.size() > 0) {
+		_memoryDumper->SetMemoryValues(memType, (uint32_t)address, data.data(), (uint32_t)data.size(), disableSideEffects);
+	}
+	return 0;
+}
+
 int LuaApi::ConvertAddress(lua_State *lua)
 {
 	LuaCallHelper l(lua);
@@ -769,10 +844,9 @@ int LuaApi::Rewind(lua_State *lua)
 int LuaApi::TakeScreenshot(lua_State *lua)
 {
 	LuaCallHelper l(lua);
+	int compressionLevel = (int)l.ReadInteger(PNGHelper::DefaultCompressionLevel);
 	checkparams();
-	stringstream ss;
-	_emu->GetVideoDecoder()->TakeScreenshot(ss);
-	l.Return(ss.str());
+	l.Return(_emu->GetVideoDecoder()->TakeScreenshotAsync("", compressionLevel).get());
 	return l.ReturnCount();
 }
 
@@ -1007,9 +1081,28 @@ int LuaApi::LoadSavestate(lua_State* lua)
 int LuaApi::GetState(lua_State *lua)
 {
 	LuaCallHelper l(lua);
-	checkparams();
+
+	//emu.getState([keys]) - when a list of keys is given, only those values are returned
+	//Objects that contain none of the requested keys are skipped entirely, which is much cheaper than serializing the whole console
+	vector<string> keys;
+	bool filterKeys = lua_gettop(lua) == 1 && lua_istable(lua, 1);
+	if(filterKeys) {
+		for(size_t i = 1, len = lua_rawlen(lua, 1); i <= len; i++) {
+			lua_rawgeti(lua, 1, (lua_Integer)i);
+			if(lua_type(lua, -1) == LUA_TSTRING) {
+				keys.push_back(lua_tostring(lua, -1));
+			}
+			lua_pop(lua, 1);
+		}
+		lua_settop(lua, 0);
+	} else {
+		checkparams();
+	}
 
 	Serializer s(0, true, SerializeFormat::Map);
+	if(filterKeys) {
+		s.SetMapKeyFilter(keys);
+	}
 	s.Stream(*_emu->GetConsole().get(), "", -1);
 	
 	//Add some more Lua-specific values
@@ -30,6 +30,8 @@ public:
 	static int WriteMemory(lua_State *lua);
 	static int ReadMemoryWord(lua_State *lua);
 	static int WriteMemoryWord(lua_State *lua);
+	static int ReadMemoryBlock(lua_State *lua);
+	static int WriteMemoryBlock(lua_State *lua);
 
 	static int GetLabelAddress(lua_State* lua);
 	static int ConvertAddress(lua_State *lua);
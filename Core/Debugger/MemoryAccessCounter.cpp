@@ -15,29 +15,100 @@ MemoryAccessCounter::MemoryAccessCounter(Debugger* debugger)
 
 	for(int i = (int)DebugUtilities::GetLastCpuMemoryType() + 1; i < DebugUtilities::GetMemoryTypeCount(); i++) {
 		uint32_t memSize = _debugger->GetMemoryDumper()->GetMemorySize((MemoryType)i);
-		_counters[i].reserve(memSize);
-		for(uint32_t j = 0; j < memSize; j++) {
-			_counters[i].push_back({});
+		uint32_t pageCount = (memSize + MemoryAccessPage::Mask) >> MemoryAccessPage::Shift;
+		_memorySize[i] = memSize;
+		for(int j = 0; j < 3; j++) {
+			_pages[i][j] = vector<atomic<MemoryAccessPage*>>(pageCount);
 		}
 	}
 }
 
+MemoryAccessCounter::~MemoryAccessCounter()
+{
+	for(int i = 0; i < DebugUtilities::GetMemoryTypeCount(); i++) {
+		for(int j = 0; j < 3; j++) {
+			for(atomic<MemoryAccessPage*>& page : _pages[i][j]) {
+				delete page.load();
+			}
+		}
+	}
+}
+
+MemoryAccessPage* MemoryAccessCounter::GetPage(AddressInfo& addressInfo, MemoryAccessCounterType type)
+{
+	//Only the emulation thread allocates pages, so it can read the pointer without synchronization
+	atomic<MemoryAccessPage*>& page = _pages[(int)addressInfo.Type][(int)type][addressInfo.Address >> MemoryAccessPage::Shift];
+	MemoryAccessPage* result = page.load(std::memory_order_relaxed);
+	if(!result) {
+		result = new MemoryAccessPage();
+		page.store(result, std::memory_order_release);
+	}
+	return result;
+}
+
+uint32_t MemoryAccessCounter::GetStamp(AddressInfo& addressInfo, MemoryAccessCounterType type)
+{
+	MemoryAccessPage* page = _pages[(int)addressInfo.Type][(int)type][addressInfo.Address >> MemoryAccessPage::Shift].load(std::memory_order_relaxed);
+	return page ? page->Stamps[addressInfo.Address & MemoryAccessPage::Mask] : 0;
+}
+
+uint32_t MemoryAccessCounter::GetRelativeStamp(uint64_t masterClock)
+{
+	//Also triggers when the clock goes backwards (e.g when loading a save state)
+	if(masterClock - _stampBase >= MaxStampOffset) {
+		RebaseStamps(masterClock);
+	}
+	return (uint32_t)(masterClock - _stampBase) + 1;
+}
+
+uint64_t MemoryAccessCounter::GetAbsoluteStamp(uint32_t stamp)
+{
+	return stamp ? _stampBase + stamp - 1 : 0;
+}
+
+void MemoryAccessCounter::RebaseStamps(uint64_t masterClock)
+{
+	uint64_t newBase = masterClock > RebaseWindow ? masterClock - RebaseWindow : 0;
+	for(int i = 0; i < DebugUtilities::GetMemoryTypeCount(); i++) {
+		for(int j = 0; j < 3; j++) {
+			for(atomic<MemoryAccessPage*>& pagePtr : _pages[i][j]) {
+				MemoryAccessPage* page = pagePtr.load(std::memory_order_relaxed);
+				if(!page) {
+					continue;
+				}
+
+				for(uint32_t k = 0; k < MemoryAccessPage::Size; k++) {
+					if(page->Stamps[k]) {
+						//Accesses older than the window are all clamped to the new base
+						uint64_t stamp = std::clamp(GetAbsoluteStamp(page->Stamps[k]), newBase, masterClock);
+						page->Stamps[k] = (uint32_t)(stamp - newBase) + 1;
+					}
+				}
+			}
+		}
+	}
+	_stampBase = newBase;
+}
+
 ReadResult MemoryAccessCounter::ProcessMemoryRead(AddressInfo &addressInfo, uint64_t masterClock)
 {
 	if(addressInfo.Address < 0) {
 		return ReadResult::Normal;
 	}
 
-	AddressCounters& counts = _counters[(int)addressInfo.Type][addressInfo.Address];
-	if(_enableBreakOnUninitRead && counts.WriteStamp == 0 && DebugUtilities::IsVolatileRam(addressInfo.Type)) {
-		ReadResult result = counts.ReadStamp == 0 ? ReadResult::FirstUninitRead : ReadResult::UninitRead;
-		counts.ReadStamp = masterClock;
-		counts.ReadCounter++;
+	uint32_t stamp = GetRelativeStamp(masterClock);
+	MemoryAccessPage* page = GetPage(addressInfo, MemoryAccessCounterType::Read);
+	uint32_t offset = addressInfo.Address & MemoryAccessPage::Mask;
+
+	if(_enableBreakOnUninitRead && DebugUtilities::IsVolatileRam(addressInfo.Type) && GetStamp(addressInfo, MemoryAccessCounterType::Write) == 0) {
+		ReadResult result = page->Stamps[offset] == 0 ? ReadResult::FirstUninitRead : ReadResult::UninitRead;
+		page->Stamps[offset] = stamp;
+		page->Counters[offset]++;
 		return result;
 	}
 
-	counts.ReadStamp = masterClock;
-	counts.ReadCounter++;
+	page->Stamps[offset] = stamp;
+	page->Counters[offset]++;
 	return ReadResult::Normal;
 }
 
@@ -47,9 +118,11 @@ void MemoryAccessCounter::ProcessMemoryWrite(AddressInfo& addressInfo, uint64_t
 		return;
 	}
 
-	AddressCounters& counts = _counters[(int)addressInfo.Type][addressInfo.Address];
-	counts.WriteStamp = masterClock;
-	counts.WriteCounter++;
+	uint32_t stamp = GetRelativeStamp(masterClock);
+	MemoryAccessPage* page = GetPage(addressInfo, MemoryAccessCounterType::Write);
+	uint32_t offset = addressInfo.Address & MemoryAccessPage::Mask;
+	page->Stamps[offset] = stamp;
+	page->Counters[offset]++;
 }
 
 void MemoryAccessCounter::ProcessMemoryExec(AddressInfo& addressInfo, uint64_t masterClock)
@@ -58,20 +131,49 @@ void MemoryAccessCounter::ProcessMemoryExec(AddressInfo& addressInfo, uint64_t m
 		return;
 	}
 
-	AddressCounters& counts = _counters[(int)addressInfo.Type][addressInfo.Address];
-	counts.ExecStamp = masterClock;
-	counts.ExecCounter++;
+	uint32_t stamp = GetRelativeStamp(masterClock);
+	MemoryAccessPage* page = GetPage(addressInfo, MemoryAccessCounterType::Exec);
+	uint32_t offset = addressInfo.Address & MemoryAccessPage::Mask;
+	page->Stamps[offset] = stamp;
+	page->Counters[offset]++;
 }
 
 void MemoryAccessCounter::ResetCounts()
 {
 	DebugBreakHelper helper(_debugger);
 	for(int i = 0; i < DebugUtilities::GetMemoryTypeCount(); i++) {
-		memset(_counters[i].data(), 0, _counters[i].size() * sizeof(AddressCounters));
+		for(int j = 0; j < 3; j++) {
+			//Pages are cleared rather than freed, since the UI can read them at any time
+			for(atomic<MemoryAccessPage*>& page : _pages[i][j]) {
+				if(MemoryAccessPage* pageData = page.load()) {
+					memset(pageData, 0, sizeof(MemoryAccessPage));
+				}
+			}
+		}
 	}
 	_enableBreakOnUninitRead = _debugger->GetConsole()->GetMasterClock() < 1000;
 }
 
+void MemoryAccessCounter::GetAccessCounts(AddressInfo& addressInfo, AddressCounters& counts)
+{
+	uint32_t pageIndex = addressInfo.Address >> MemoryAccessPage::Shift;
+	uint32_t offset = addressInfo.Address & MemoryAccessPage::Mask;
+	vector<atomic<MemoryAccessPage*>>* pages = _pages[(int)addressInfo.Type];
+
+	//Called by the UI thread, the acquire loads ensure newly allocated pages are fully initialized
+	MemoryAccessPage* page = pages[(int)MemoryAccessCounterType::Read][pageIndex].load(std::memory_order_acquire);
+	counts.ReadStamp = page ? GetAbsoluteStamp(page->Stamps[offset]) : 0;
+	counts.ReadCounter = page ? page->Counters[offset] : 0;
+
+	page = pages[(int)MemoryAccessCounterType::Write][pageIndex].load(std::memory_order_acquire);
+	counts.WriteStamp = page ? GetAbsoluteStamp(page->Stamps[offset]) : 0;
+	counts.WriteCounter = page ? page->Counters[offset] : 0;
+
+	page = pages[(int)MemoryAccessCounterType::Exec][pageIndex].load(std::memory_order_acquire);
+	counts.ExecStamp = page ? GetAbsoluteStamp(page->Stamps[offset]) : 0;
+	counts.ExecCounter = page ? page->Counters[offset] : 0;
+}
+
 void MemoryAccessCounter::GetAccessCounts(uint32_t offset, uint32_t length, MemoryType memoryType, AddressCounters counts[])
 {
 	if(DebugUtilities::IsRelativeMemory(memoryType)) {
@@ -81,12 +183,16 @@ void MemoryAccessCounter::GetAccessCounts(uint32_t offset, uint32_t length, Memo
 			addr.Address = offset + i;
 			AddressInfo info = _debugger->GetAbsoluteAddress(addr);
 			if(info.Address >= 0) {
-				counts[i] = _counters[(int)info.Type][info.Address];
+				GetAccessCounts(info, counts[i]);
 			}
 		}
 	} else {
-		if(offset + length <= _counters[(int)memoryType].size()) {
-			memcpy(counts, _counters[(int)memoryType].data() + offset, length * sizeof(AddressCounters));
+		if(offset + length <= _memorySize[(int)memoryType]) {
+			AddressInfo info = { 0, memoryType };
+			for(uint32_t i = 0; i < length; i++) {
+				info.Address = offset + i;
+				GetAccessCounts(info, counts[i]);
+			}
 		}
 	}
 }
@@ -30,16 +30,51 @@ enum class ReadResult
 	UninitRead
 };
 
+enum class MemoryAccessCounterType
+{
+	Read = 0,
+	Write = 1,
+	Exec = 2
+};
+
+//Stamps/counters for a single access type, for a block of addresses
+struct MemoryAccessPage
+{
+	static constexpr uint32_t Shift = 12;
+	static constexpr uint32_t Size = 1 << Shift;
+	static constexpr uint32_t Mask = Size - 1;
+
+	//Relative to the counter's stamp base, 0 means no access
+	uint32_t Stamps[Size];
+	uint32_t Counters[Size];
+};
+
 class MemoryAccessCounter
 {
 private:
-	vector<AddressCounters> _counters[DebugUtilities::GetMemoryTypeCount()];
+	//Pages are only allocated when an address in them is accessed (separately for reads, writes and execs)
+	//The emulation thread allocates them while the UI thread reads them, so they are published with release/acquire semantics
+	vector<atomic<MemoryAccessPage*>> _pages[DebugUtilities::GetMemoryTypeCount()][3];
+	uint32_t _memorySize[DebugUtilities::GetMemoryTypeCount()] = {};
+
+	//Stamps are stored as 32-bit offsets from this value, and are rebased when the master clock gets too far ahead of it
+	static constexpr uint64_t MaxStampOffset = 0xFFFFFFFE;
+	static constexpr uint64_t RebaseWindow = 0x40000000;
+	uint64_t _stampBase = 0;
 
 	Debugger* _debugger = nullptr;
 	bool _enableBreakOnUninitRead = false;
 
+	MemoryAccessPage* GetPage(AddressInfo& addressInfo, MemoryAccessCounterType type);
+	uint32_t GetStamp(AddressInfo& addressInfo, MemoryAccessCounterType type);
+	uint32_t GetRelativeStamp(uint64_t masterClock);
+	uint64_t GetAbsoluteStamp(uint32_t stamp);
+	void RebaseStamps(uint64_t masterClock);
+	void GetAccessCounts(AddressInfo& addressInfo, AddressCounters& counts);
+
 public:
 	MemoryAccessCounter(Debugger *debugger);
+	~MemoryAccessCounter();
 
 	ReadResult ProcessMemoryRead(AddressInfo& addressInfo, uint64_t masterClock);
 	void ProcessMemoryWrite(AddressInfo& addressInfo, uint64_t masterClock);
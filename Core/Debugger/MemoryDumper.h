@@ -41,6 +41,6 @@ public:
 	uint16_t GetMemoryValueWord(MemoryType memoryType, uint32_t address, bool disableSideEffects = true);
 	void SetMemoryValueWord(MemoryType memoryType, uint32_t address, uint16_t value, bool disableSideEffects = true);
 	void SetMemoryValue(MemoryType memoryType, uint32_t address, uint8_t value, bool disableSideEffects = true);
-	void SetMemoryValues(MemoryType memoryType, uint32_t address, uint8_t* data, uint32_t length);
+	void SetMemoryValues(MemoryType memoryType, uint32_t address, uint8_t* data, uint32_t length, bool disableSideEffects = true);
 	void SetMemoryState(MemoryType type, uint8_t *buffer, uint32_t length);
 };
\ No newline at end of file
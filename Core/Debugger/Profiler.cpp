@@ -5,7 +5,10 @@
 #include "Debugger/Debugger.h"
 #include "Debugger/MemoryDumper.h"
 #include "Debugger/DebugTypes.h"
+#include "Debugger/LabelManager.h"
 #include "Shared/Interfaces/IConsole.h"
+#include "Utilities/HexUtilities.h"
+#include "Utilities/magic_enum.hpp"
 
 static constexpr int32_t ResetFunctionIndex = -1;
 
@@ -34,6 +37,7 @@ void Profiler::StackFunction(AddressInfo &addr, StackFrameFlags stackFlag)
 		_stackFlags.push_back(stackFlag);
 		_cycleCountStack.push_back(_currentCycleCount);
 		_functionStack.push_back(_currentFunction);
+		_nodeStack.push_back(_currentNode);
 
 		if(_functionStack.size() > 100) {
 			//Keep stack to 100 functions at most (to prevent performance issues, esp. in debug builds)
@@ -41,6 +45,7 @@ void Profiler::StackFunction(AddressInfo &addr, StackFrameFlags stackFlag)
 			_functionStack.pop_front();
 			_cycleCountStack.pop_front();
 			_stackFlags.pop_front();
+			_nodeStack.pop_front();
 		}
 
 		ProfiledFunction& func = _functions[key];
@@ -48,6 +53,9 @@ void Profiler::StackFunction(AddressInfo &addr, StackFrameFlags stackFlag)
 
 		_currentFunction = key;
 		_currentCycleCount = 0;
+
+		_currentNode = GetCallNode(_currentNode, key, stackFlag);
+		_callNodes[_currentNode].CallCount++;
 	}
 }
 
@@ -69,10 +77,37 @@ void Profiler::UpdateCycles()
 		}
 	}
 
+	//Inclusive times for each call path are calculated when exporting the call tree
+	_callNodes[_currentNode].ExclusiveCycles += clockGap;
+
 	_currentCycleCount += clockGap;
 	_prevMasterClock = masterClock;
 }
 
+uint32_t Profiler::GetCallNode(uint32_t parent, int32_t function, StackFrameFlags flags)
+{
+	uint64_t key = ((uint64_t)parent << 34) | ((uint64_t)flags << 32) | (uint32_t)function;
+	auto result = _callNodeLookup.find(key);
+	if(result != _callNodeLookup.end()) {
+		return result->second;
+	}
+
+	if(_callNodes.size() >= MaxCallNodes) {
+		//Tree is too large (code doesn't use calls/returns normally), count the cycles in the caller instead
+		return parent;
+	}
+
+	ProfilerCallNode node;
+	node.Function = function;
+	node.Flags = flags;
+	node.Parent = parent;
+	_callNodes.push_back(node);
+
+	uint32_t index = (uint32_t)_callNodes.size() - 1;
+	_callNodeLookup[key] = index;
+	return index;
+}
+
 void Profiler::UnstackFunction()
 {
 	if(!_functionStack.empty()) {
@@ -87,6 +122,9 @@ void Profiler::UnstackFunction()
 		_functionStack.pop_back();
 		_stackFlags.pop_back();
 
+		_currentNode = _nodeStack.back();
+		_nodeStack.pop_back();
+
 		//Add the subroutine's cycle count to the current routine's cycle count
 		_currentCycleCount = _cycleCountStack.back() + _currentCycleCount;
 		_cycleCountStack.pop_back();
@@ -106,7 +144,9 @@ void Profiler::ResetState()
 	_functionStack.clear();
 	_stackFlags.clear();
 	_cycleCountStack.clear();
+	_nodeStack.clear();
 	_currentFunction = ResetFunctionIndex;
+	_currentNode = 0;
 }
 
 void Profiler::InternalReset()
@@ -116,6 +156,11 @@ void Profiler::InternalReset()
 	_functions.clear();
 	_functions[ResetFunctionIndex] = ProfiledFunction();
 	_functions[ResetFunctionIndex].Address = { ResetFunctionIndex, MemoryType::None };
+
+	//Root of the call tree
+	_callNodes.clear();
+	_callNodeLookup.clear();
+	_callNodes.push_back(ProfilerCallNode());
 }
 
 void Profiler::GetProfilerData(ProfiledFunction* profilerData, uint32_t& functionCount)
@@ -134,3 +179,113 @@ void Profiler::GetProfilerData(ProfiledFunction* profilerData, uint32_t& functio
 		}
 	}
 }
+
+
+string Profiler::GetFrameName(ProfilerCallNode& node)
+{
+	string name;
+	if(node.Function == ResetFunctionIndex) {
+		name = "[Reset]";
+	} else {
+		AddressInfo addr = _functions[node.Function].Address;
+		name = _debugger->GetLabelManager()->GetLabel(addr);
+		if(name.empty()) {
+			name = string(magic_enum::enum_name(addr.Type)) + ":$" + HexUtilities::ToHex((uint32_t)addr.Address);
+		}
+	}
+
+	switch(node.Flags) {
+		default: break;
+		case StackFrameFlags::Nmi: name = "[nmi] " + name; break;
+		case StackFrameFlags::Irq: name = "[irq] " + name; break;
+	}
+
+	//Remove characters that have a special meaning in the output formats
+	for(char& c : name) {
+		if(c == ';' || c == '"' || c == '\\' || c < ' ') {
+			c = '_';
+		}
+	}
+	return name;
+}
+
+bool Profiler::ExportCallTree(string filename, ProfilerExportFormat format)
+{
+	DebugBreakHelper helper(_debugger);
+
+	UpdateCycles();
+
+	ofstream file(filename, ios::out | ios::binary);
+	if(!file) {
+		return false;
+	}
+
+	//Frame index for each node (nodes for the same function & flags share the same frame)
+	vector<string> frameNames;
+	vector<uint32_t> nodeFrames(_callNodes.size());
+	unordered_map<string, uint32_t> frameIndexes;
+	for(size_t i = 0; i < _callNodes.size(); i++) {
+		string name = GetFrameName(_callNodes[i]);
+		auto result = frameIndexes.find(name);
+		if(result == frameIndexes.end()) {
+			nodeFrames[i] = (uint32_t)frameNames.size();
+			frameIndexes[name] = nodeFrames[i];
+			frameNames.push_back(name);
+		} else {
+			nodeFrames[i] = result->second;
+		}
+	}
+
+	uint64_t totalCycles = 0;
+	for(ProfilerCallNode& node : _callNodes) {
+		totalCycles += node.ExclusiveCycles;
+	}
+
+	if(format == ProfilerExportFormat::Speedscope) {
+		file << "{\"$schema\":\"https://www.speedscope.app/file-format-schema.json\",\"shared\":{\"frames\":[";
+		for(size_t i = 0; i < frameNames.size(); i++) {
+			file << (i > 0 ? "," : "") << "{\"name\":\"" << frameNames[i] << "\"}";
+		}
+		file << "]},\"profiles\":[{\"type\":\"sampled\",\"name\":\"Mesen\",\"unit\":\"none\",\"startValue\":0,\"endValue\":" << totalCycles << ",\"samples\":[";
+	}
+
+	//Output 1 entry per call path, with the path's exclusive cycle count as its weight
+	vector<uint32_t> path;
+	bool firstSample = true;
+	string weights;
+	for(size_t i = 0; i < _callNodes.size(); i++) {
+		if(_callNodes[i].ExclusiveCycles == 0) {
+			continue;
+		}
+
+		path.clear();
+		for(uint32_t node = (uint32_t)i; ; node = _callNodes[node].Parent) {
+			path.push_back(node);
+			if(node == 0) {
+				break;
+			}
+		}
+
+		if(format == ProfilerExportFormat::Speedscope) {
+			file << (firstSample ? "[" : ",[");
+			for(int j = (int)path.size() - 1; j >= 0; j--) {
+				file << nodeFrames[path[j]] << (j > 0 ? "," : "");
+			}
+			file << "]";
+			weights += (firstSample ? "" : ",") + std::to_string(_callNodes[i].ExclusiveCycles);
+		} else {
+			for(int j = (int)path.size() - 1; j >= 0; j--) {
+				file << frameNames[nodeFrames[path[j]]] << (j > 0 ? ";" : "");
+			}
+			file << " " << _callNodes[i].ExclusiveCycles << "\n";
+		}
+		firstSample = false;
+	}
+
+	if(format == ProfilerExportFormat::Speedscope) {
+		file << "],\"weights\":[" << weights << "]}]}";
+	}
+
+	file.close();
+	return !file.fail();
+}
\ No newline at end of file
@@ -15,6 +15,22 @@ struct ProfiledFunction
 	AddressInfo Address = {};
 };
 
+//Node in the calling context tree (one node per unique call path)
+struct ProfilerCallNode
+{
+	int32_t Function = -1;
+	StackFrameFlags Flags = StackFrameFlags::None;
+	uint32_t Parent = 0;
+	uint64_t ExclusiveCycles = 0;
+	uint64_t CallCount = 0;
+};
+
+enum class ProfilerExportFormat
+{
+	CollapsedStacks = 0,
+	Speedscope = 1
+};
+
 class Profiler
 {
 private:
@@ -22,8 +38,14 @@ private:
 	IConsole* _console = nullptr;
 
 	unordered_map<int32_t, ProfiledFunction> _functions;
+
+	static constexpr uint32_t MaxCallNodes = 1000000;
+	vector<ProfilerCallNode> _callNodes;
+	unordered_map<uint64_t, uint32_t> _callNodeLookup;
+	uint32_t _currentNode = 0;
 	
 	deque<int32_t> _functionStack;
+	deque<uint32_t> _nodeStack;
 	deque<StackFrameFlags> _stackFlags;
 	deque<uint64_t> _cycleCountStack;
 
@@ -33,6 +55,8 @@ private:
 
 	void InternalReset();
 	void UpdateCycles();
+	uint32_t GetCallNode(uint32_t parent, int32_t function, StackFrameFlags flags);
+	string GetFrameName(ProfilerCallNode& node);
 
 public:
 	Profiler(Debugger* debugger, IConsole* _console);
@@ -44,4 +68,5 @@ public:
 	void Reset();
 	void ResetState();
 	void GetProfilerData(ProfiledFunction* profilerData, uint32_t& functionCount);
+	bool ExportCallTree(string filename, ProfilerExportFormat format);
 };
\ No newline at end of file
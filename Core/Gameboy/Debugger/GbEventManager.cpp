@@ -5,23 +5,15 @@
 #include "Gameboy/Gameboy.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/Debugger.h"
-#include "Debugger/DebugBreakHelper.h"
 #include "Debugger/BaseEventManager.h"
 #include "SNES/SnesDefaultVideoFilter.h"
 
-GbEventManager::GbEventManager(Debugger* debugger, GbCpu* cpu, GbPpu* ppu)
+GbEventManager::GbEventManager(Debugger* debugger, GbCpu* cpu, GbPpu* ppu) : BaseEventManager(debugger)
 {
-	_debugger = debugger;
 	_cpu = cpu;
 	_ppu = ppu;
 
-	_ppuBuffer = new uint16_t[456*GbEventManager::ScreenHeight];
-	memset(_ppuBuffer, 0, 456*GbEventManager::ScreenHeight * sizeof(uint16_t));
-}
-
-GbEventManager::~GbEventManager()
-{
-	delete[] _ppuBuffer;
+	InitSnapshots(456 * GbEventManager::ScreenHeight, GbEventManager::ScreenHeight);
 }
 
 void GbEventManager::AddEvent(DebugEventType type, MemoryOperationInfo& operation, int32_t breakpointId)
@@ -34,7 +26,7 @@ void GbEventManager::AddEvent(DebugEventType type, MemoryOperationInfo& operatio
 	evt.BreakpointId = breakpointId;
 	evt.DmaChannel = -1;
 	evt.ProgramCounter = _debugger->GetProgramCounter(CpuType::Gameboy, true);
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void GbEventManager::AddEvent(DebugEventType type)
@@ -46,7 +38,7 @@ void GbEventManager::AddEvent(DebugEventType type)
 	evt.BreakpointId = -1;
 	evt.DmaChannel = -1;
 	evt.ProgramCounter = _cpu->GetState().PC;
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 DebugEventInfo GbEventManager::GetEvent(uint16_t y, uint16_t x)
@@ -121,43 +113,38 @@ void GbEventManager::ConvertScanlineCycleToRowColumn(int32_t& x, int32_t& y)
 	x *= 2;
 }
 
-uint32_t GbEventManager::TakeEventSnapshot(bool forAutoRefresh)
+void GbEventManager::TakePpuSnapshot(EventViewerSnapshot& snapshot)
 {
-	DebugBreakHelper breakHelper(_debugger);
-	auto lock = _lock.AcquireSafe();
+	uint16_t* ppuBuffer = snapshot.PpuBuffer.data();
 
 	uint16_t cycle = _ppu->GetState().Cycle;
 	uint16_t scanline = _ppu->GetState().Scanline;
 
 	if(scanline >= GbEventManager::VBlankScanline || scanline == 0) {
-		memcpy(_ppuBuffer, _ppu->GetEventViewerBuffer(), 456 * GbEventManager::ScreenHeight * sizeof(uint16_t));
+		memcpy(ppuBuffer, _ppu->GetEventViewerBuffer(), 456 * GbEventManager::ScreenHeight * sizeof(uint16_t));
 	} else {
 		uint32_t size = 456 * GbEventManager::ScreenHeight;
 		uint32_t offset = 456 * scanline;
-		memcpy(_ppuBuffer, _ppu->GetEventViewerBuffer(), offset * sizeof(uint16_t));
-		memcpy(_ppuBuffer + offset, _ppu->GetPreviousEventViewerBuffer() + offset, (size - offset) * sizeof(uint16_t));
+		memcpy(ppuBuffer, _ppu->GetEventViewerBuffer(), offset * sizeof(uint16_t));
+		memcpy(ppuBuffer + offset, _ppu->GetPreviousEventViewerBuffer() + offset, (size - offset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
-	_snapshotScanline = scanline;
-	_snapshotCycle = cycle;
-	_forAutoRefresh = forAutoRefresh;
-	_scanlineCount = GbEventManager::ScreenHeight;
-	return _scanlineCount;
+	snapshot.Scanline = scanline;
+	snapshot.Cycle = cycle;
+	snapshot.ScanlineCount = GbEventManager::ScreenHeight;
 }
 
 FrameInfo GbEventManager::GetDisplayBufferSize()
 {
 	FrameInfo size;
 	size.Width = GbEventManager::ScanlineWidth;
-	size.Height = _scanlineCount * 2;
+	size.Height = _snapshot->ScanlineCount * 2;
 	return size;
 }
 
 void GbEventManager::DrawScreen(uint32_t* buffer)
 {
-	uint16_t *src = _ppuBuffer;
+	uint16_t *src = _snapshot->PpuBuffer.data();
 	for(uint32_t y = 0, len = GbEventManager::ScreenHeight*2; y < len; y++) {
 		for(uint32_t x = 0; x < GbEventManager::ScanlineWidth; x++) {
 			int srcOffset = (y >> 1) * 456 + (x >> 1);
@@ -42,26 +42,21 @@ private:
 
 	GbPpu* _ppu;
 	GbCpu* _cpu;
-	Debugger* _debugger;
-
-	uint32_t _scanlineCount = GbEventManager::ScreenHeight;
-	uint16_t* _ppuBuffer = nullptr;
 
 protected:
 	bool ShowPreviousFrameEvents() override;
 	void ConvertScanlineCycleToRowColumn(int32_t& x, int32_t& y) override;
 	void DrawScreen(uint32_t* buffer) override;
+	void TakePpuSnapshot(EventViewerSnapshot& snapshot) override;
 
 public:
 	GbEventManager(Debugger* debugger, GbCpu* cpu, GbPpu* ppu);
-	~GbEventManager();
 
 	void AddEvent(DebugEventType type, MemoryOperationInfo& operation, int32_t breakpointId = -1) override;
 	void AddEvent(DebugEventType type) override;
 
 	EventViewerCategoryCfg GetEventConfig(DebugEventInfo& evt) override;
 
-	uint32_t TakeEventSnapshot(bool forAutoRefresh) override;
 	DebugEventInfo GetEvent(uint16_t y, uint16_t x) override;
 
 	FrameInfo GetDisplayBufferSize() override;
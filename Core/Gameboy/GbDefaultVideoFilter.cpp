@@ -3,6 +3,7 @@
 #include "Gameboy/GbConstants.h"
 #include "Gameboy/Gameboy.h"
 #include "Shared/Video/DebugHud.h"
+#include "Shared/Video/VideoFilterKernels.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/RewindManager.h"
@@ -104,9 +105,15 @@ void GbDefaultVideoFilter::ApplyFilter(uint16_t* ppuOutputBuffer)
 	uint32_t xOffset = overscan.Left;
 	uint32_t yOffset = overscan.Top;
 
-	for(uint32_t i = 0; i < frameInfo.Height; i++) {
-		for(uint32_t j = 0; j < frameInfo.Width; j++) {
-			out[i * frameInfo.Width + j] = GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset);
+	if(_blendFrames) {
+		for(uint32_t i = 0; i < frameInfo.Height; i++) {
+			for(uint32_t j = 0; j < frameInfo.Width; j++) {
+				out[i * frameInfo.Width + j] = GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset);
+			}
+		}
+	} else {
+		for(uint32_t i = 0; i < frameInfo.Height; i++) {
+			VideoFilterKernels::ConvertPixels(ppuOutputBuffer + i * width + yOffset + xOffset, out + i * frameInfo.Width, frameInfo.Width, _calculatedPalette, 0x7FFF);
 		}
 	}
 
@@ -156,6 +156,16 @@ void GbMemoryManager::Unmap(uint16_t start, uint16_t end)
 
 template<MemoryOperationType opType, GbOamCorruptionType oamCorruptionType>
 uint8_t GbMemoryManager::Read(uint16_t addr)
+{
+	if(_emu->HasMemoryHooks()) {
+		return InternalRead<true, opType, oamCorruptionType>(addr);
+	} else {
+		return InternalRead<false, opType, oamCorruptionType>(addr);
+	}
+}
+
+template<bool withHooks, MemoryOperationType opType, GbOamCorruptionType oamCorruptionType>
+__forceinline uint8_t GbMemoryManager::InternalRead(uint16_t addr)
 {
 	uint8_t value = 0;
 	if(_dmaController->IsOamDmaRunning()) {
@@ -169,10 +179,12 @@ uint8_t GbMemoryManager::Read(uint16_t addr)
 		value = _reads[addr >> 8][(uint8_t)addr];
 	}
 
-	if(_emu->GetCheatManager()->HasCheats<CpuType::Gameboy>()) {
-		_emu->GetCheatManager()->ApplyCheat<CpuType::Gameboy>(addr, value);
+	if constexpr(withHooks) {
+		if(_emu->GetCheatManager()->HasCheats<CpuType::Gameboy>()) {
+			_emu->GetCheatManager()->ApplyCheat<CpuType::Gameboy>(addr, value);
+		}
+		_emu->ProcessMemoryRead<CpuType::Gameboy>(addr, value, opType);
 	}
-	_emu->ProcessMemoryRead<CpuType::Gameboy>(addr, value, opType);
 	return value;
 }
 
@@ -202,18 +214,32 @@ uint8_t GbMemoryManager::ReadDma(uint16_t addr)
 template<MemoryOperationType type>
 void GbMemoryManager::Write(uint16_t addr, uint8_t value)
 {
-	if(_emu->ProcessMemoryWrite<CpuType::Gameboy>(addr, value, type)) {
-		if(_dmaController->IsOamDmaRunning() && _dmaController->IsOamDmaConflict(addr)) {
-			//DMA conflict, can't write
+	if(_emu->HasMemoryHooks()) {
+		InternalWrite<true, type>(addr, value);
+	} else {
+		InternalWrite<false, type>(addr, value);
+	}
+}
+
+template<bool withHooks, MemoryOperationType type>
+__forceinline void GbMemoryManager::InternalWrite(uint16_t addr, uint8_t value)
+{
+	if constexpr(withHooks) {
+		if(!_emu->ProcessMemoryWrite<CpuType::Gameboy>(addr, value, type)) {
 			return;
 		}
+	}
 
-		if(_state.IsWriteRegister[addr >> 8]) {
-			_ppu->ProcessOamCorruption<GbOamCorruptionType::Write>(addr);
-			WriteRegister(addr, value);
-		} else if(_writes[addr >> 8]) {
-			_writes[addr >> 8][(uint8_t)addr] = value;
-		}
+	if(_dmaController->IsOamDmaRunning() && _dmaController->IsOamDmaConflict(addr)) {
+		//DMA conflict, can't write
+		return;
+	}
+
+	if(_state.IsWriteRegister[addr >> 8]) {
+		_ppu->ProcessOamCorruption<GbOamCorruptionType::Write>(addr);
+		WriteRegister(addr, value);
+	} else if(_writes[addr >> 8]) {
+		_writes[addr >> 8][(uint8_t)addr] = value;
 	}
 }
 
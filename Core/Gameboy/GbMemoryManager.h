@@ -54,6 +54,8 @@ public:
 
 	template<MemoryOperationType type, GbOamCorruptionType oamCorruptionType = GbOamCorruptionType::Read>
 	uint8_t Read(uint16_t addr);
+	template<bool withHooks, MemoryOperationType type, GbOamCorruptionType oamCorruptionType>
+	uint8_t InternalRead(uint16_t addr);
 
 	bool IsOamDmaRunning();
 	void WriteDma(uint16_t addr, uint8_t value);
@@ -61,6 +63,8 @@ public:
 
 	template<MemoryOperationType type = MemoryOperationType::Write>
 	void Write(uint16_t addr, uint8_t value);
+	template<bool withHooks, MemoryOperationType type>
+	void InternalWrite(uint16_t addr, uint8_t value);
 
 	uint8_t PeekRegister(uint16_t addr);
 	uint8_t ReadRegister(uint16_t addr);
@@ -91,6 +91,7 @@ void GbPpu::Exec()
 			//More than a full frame's worth of time has passed since the last frame, send another blank frame
 			_lastFrameTime = _gameboy->GetApuCycleCount();
 			_isFirstFrame = true;
+			_skipRender = !_gameboy->IsSgb() && _emu->ShouldSkipRender(true);
 			SendFrame();
 		}
 		return;
@@ -198,6 +199,9 @@ void GbPpu::ProcessVblankScanline()
 				_state.LyForCompare = 0;
 				_wyEnableFlag = false;
 
+				//The SGB's output is rendered by the SNES PPU, which makes its own frame skipping decisions
+				_skipRender = !_gameboy->IsSgb() && _emu->ShouldSkipRender(true);
+
 				if(_emu->IsDebugging()) {
 					_emu->ProcessEvent(EventType::StartFrame, CpuType::Gameboy);
 					_currentEventViewerBuffer = _currentEventViewerBuffer == _eventViewerBuffers[0] ? _eventViewerBuffers[1] : _eventViewerBuffers[0];
@@ -368,7 +372,8 @@ void GbPpu::RunDrawCycle()
 	}
 
 	if(_fetchSprite == -1 && _bgFifo.Size > 0) {
-		if(_drawnPixels >= 0) {
+		//The FIFOs still need to run when the frame won't be displayed (for timing), but pixels don't need to be output
+		if(_drawnPixels >= 0 && !_skipRender) {
 			GameboyConfig& cfg = _emu->GetSettings()->GetGameboyConfig();
 
 			GbFifoEntry entry = _bgFifo.Content[_bgFifo.Position];
@@ -679,9 +684,11 @@ void GbPpu::SendFrame()
 	}
 	_isFirstFrame = false;
 
-	RenderedFrame frame(_currentBuffer, GbConstants::ScreenWidth, GbConstants::ScreenHeight, 1.0, _state.FrameCount, _gameboy->GetControlManager()->GetPortStates());
-	bool rewinding = _emu->GetRewindManager()->IsRewinding();
-	_emu->GetVideoDecoder()->UpdateFrame(frame, rewinding, rewinding);
+	if(!_skipRender) {
+		RenderedFrame frame(_currentBuffer, GbConstants::ScreenWidth, GbConstants::ScreenHeight, 1.0, _state.FrameCount, _gameboy->GetControlManager()->GetPortStates());
+		bool rewinding = _emu->GetRewindManager()->IsRewinding();
+		_emu->GetVideoDecoder()->UpdateFrame(frame, rewinding, rewinding);
+	}
 
 	_emu->ProcessEndOfFrame();
 	_gameboy->ProcessEndOfFrame();
@@ -51,6 +51,7 @@ private:
 
 	bool _isFirstFrame = true;
 	bool _rendererIdle = false;
+	bool _skipRender = false;
 
 	__forceinline void WriteBgPixel(uint8_t colorIndex);
 	__forceinline void WriteObjPixel(uint8_t colorIndex);
@@ -12,8 +12,6 @@
 BisqwitNtscFilter::BisqwitNtscFilter(Emulator* emu) : BaseVideoFilter(emu)
 {
 	_resDivider = 1;
-	_stopThread = false;
-	_workDone = false;
 
 	// from https ://forums.nesdev.org/viewtopic.php?p=159266#p159266
 	const double signalLumaLow[2][4] = {
@@ -50,33 +48,6 @@ BisqwitNtscFilter::BisqwitNtscFilter(Emulator* emu) : BaseVideoFilter(emu)
 			_signalHigh[(h ? 0x40 : 0) | i] = int8_t(std::floor(((q - signal_blank) / (signal_white - signal_blank)) * 100));
 		}
 	}
-
-	_extraThread = std::thread([=]() {
-		//Worker thread to improve decode speed
-		while(!_stopThread) {
-			_waitWork.Wait();
-			if(_stopThread) {
-				break;
-			}
-
-			uint32_t* outputBuffer = GetOutputBuffer();
-			FrameInfo frameInfo = _frameInfo;
-
-			//Adjust outputbuffer to start at the middle of the picture
-			outputBuffer += frameInfo.Width * (frameInfo.Height / 2);
-
-			DecodeFrame(120, 239 - GetOverscan().Bottom, _ppuOutputBuffer, outputBuffer, (GetVideoPhase() * 4) + 327360);
-
-			_workDone = true;
-		}
-	});
-}
-
-BisqwitNtscFilter::~BisqwitNtscFilter()
-{
-	_stopThread = true;
-	_waitWork.Signal();
-	_extraThread.join();
 }
 
 void BisqwitNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
@@ -87,10 +58,22 @@ void BisqwitNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		NesDefaultVideoFilter::ApplyPalBorder(ppuOutputBuffer);
 	}
 
-	_workDone = false;
-	_waitWork.Signal();
-	DecodeFrame(GetOverscan().Top, 120, ppuOutputBuffer, GetOutputBuffer(), (GetVideoPhase() * 4) + GetOverscan().Top*341*8);
-	while(!_workDone) {}
+	OverscanDimensions overscan = GetOverscan();
+	int firstRow = overscan.Top;
+	int lastRow = 239 - overscan.Bottom;
+	uint32_t rowPixelGap = _frameInfo.Width * (8 / _resDivider);
+	uint32_t* outputBuffer = GetOutputBuffer();
+	int startPhase = GetVideoPhase() * 4;
+
+	//Each band of rows is decoded on its own thread (the phase advances by 341*8 signals per row)
+	ProcessRowBands(lastRow - firstRow + 1, [=](uint32_t start, uint32_t end) {
+		DecodeFrame(firstRow + start, firstRow + end - 1, outputBuffer + start * rowPixelGap, startPhase + (firstRow + start) * 341 * 8);
+	});
+
+	//Done in a separate pass, since the last row of each band is blended with the first row of the next band
+	ProcessRowBands(lastRow - firstRow + 1, [=](uint32_t start, uint32_t end) {
+		GenerateMissingLines(firstRow + start, firstRow + end - 1, outputBuffer + start * rowPixelGap);
+	});
 }
 
 FrameInfo BisqwitNtscFilter::GetFrameInfo()
@@ -131,16 +114,16 @@ void BisqwitNtscFilter::OnBeforeApplyFilter()
 	_iWidth = std::max(12, (int)(12 + cfg.NtscIFilterLength * 24));
 	_qWidth = std::max(12, (int)(12 + cfg.NtscQFilterLength * 24));
 
-	_y = contrast / _yWidth;
+	_yiqCoefficients.Y = contrast / _yWidth;
 
-	_ir = (int)(contrast * 1.994681e-6 * saturation / _iWidth);
-	_qr = (int)(contrast * 9.915742e-7 * saturation / _qWidth);
+	_yiqCoefficients.IR = (int)(contrast * 1.994681e-6 * saturation / _iWidth);
+	_yiqCoefficients.QR = (int)(contrast * 9.915742e-7 * saturation / _qWidth);
 
-	_ig = (int)(contrast * 9.151351e-8 * saturation / _iWidth);
-	_qg = (int)(contrast * -6.334805e-7 * saturation / _qWidth);
+	_yiqCoefficients.IG = (int)(contrast * 9.151351e-8 * saturation / _iWidth);
+	_yiqCoefficients.QG = (int)(contrast * -6.334805e-7 * saturation / _qWidth);
 
-	_ib = (int)(contrast * -1.012984e-6 * saturation / _iWidth);
-	_qb = (int)(contrast * 1.667217e-6 * saturation / _qWidth);
+	_yiqCoefficients.IB = (int)(contrast * -1.012984e-6 * saturation / _iWidth);
+	_yiqCoefficients.QB = (int)(contrast * 1.667217e-6 * saturation / _qWidth);
 }
 
 void BisqwitNtscFilter::RecursiveBlend(int iterationCount, uint64_t *output, uint64_t *currentLine, uint64_t *nextLine, int pixelsPerCycle, bool verticalBlend)
@@ -206,15 +189,14 @@ void BisqwitNtscFilter::GenerateNtscSignal(int8_t *ntscSignal, int &phase, int r
 	phase += (341 - 256) * _signalsPerPixel;
 }
 
-void BisqwitNtscFilter::DecodeFrame(int startRow, int endRow, uint16_t *ppuOutputBuffer, uint32_t* outputBuffer, int startPhase)
+void BisqwitNtscFilter::DecodeFrame(int startRow, int endRow, uint32_t* outputBuffer, int startPhase)
 {
 	int pixelsPerCycle = 8 / _resDivider;
 	int phase = startPhase;
 	constexpr int lineWidth = 256;
 	int8_t rowSignal[lineWidth * _signalsPerPixel];
 	uint32_t rowPixelGap = _frameInfo.Width * pixelsPerCycle;
-	
-	uint32_t* orgBuffer = outputBuffer;
+	DecodeBuffers buffers;
 
 	for(int y = startRow; y <= endRow; y++) {
 		int startCycle = phase % 12;
@@ -223,13 +205,20 @@ void BisqwitNtscFilter::DecodeFrame(int startRow, int endRow, uint16_t *ppuOutpu
 		GenerateNtscSignal(rowSignal, phase, y);
 
 		//Convert the NTSC signal to RGB
-		NtscDecodeLine(lineWidth * _signalsPerPixel, rowSignal, outputBuffer, (startCycle + 7) % 12);
+		if(IsReferenceMode()) {
+			NtscDecodeLineReference(lineWidth * _signalsPerPixel, rowSignal, outputBuffer, (startCycle + 7) % 12);
+		} else {
+			NtscDecodeLine(lineWidth * _signalsPerPixel, rowSignal, outputBuffer, (startCycle + 7) % 12, buffers);
+		}
 
 		outputBuffer += rowPixelGap;
 	}
+}
 
-	//Generate the missing vertical lines
-	outputBuffer = orgBuffer;
+void BisqwitNtscFilter::GenerateMissingLines(int startRow, int endRow, uint32_t* outputBuffer)
+{
+	int pixelsPerCycle = 8 / _resDivider;
+	uint32_t rowPixelGap = _frameInfo.Width * pixelsPerCycle;
 	int lastRow = 239 - GetOverscan().Bottom;
 	bool verticalBlend = false; //_emu->GetSettings()->GetVideoConfig();
 	for(int y = startRow; y <= endRow; y++) {
@@ -271,11 +260,64 @@ void BisqwitNtscFilter::DecodeFrame(int startRow, int endRow, uint16_t *ppuOutpu
 *         In essence it conveys in one integer the same information that real NTSC signal
 *         would convey in the colorburst period in the beginning of each scanline.
 */
-void BisqwitNtscFilter::NtscDecodeLine(int width, const int8_t* signal, uint32_t* target, int phase0)
+void BisqwitNtscFilter::NtscDecodeLine(int width, const int8_t* signal, uint32_t* target, int phase0, DecodeBuffers& buffers)
 {
-	auto Read = [=](int pos) -> char { return pos >= 0 && pos < width ? signal[pos] : 0; };
-	auto Cos = [=](int pos) -> char { return _sinetable[(pos + 36) % 12 + phase0]; };
-	auto Sin = [=](int pos) -> char { return _sinetable[(pos + 36) % 12 + 3 + phase0]; };
+	int leftOverscan = GetOverscan().Left * 8;
+	int rightOverscan = width - GetOverscan().Right * 8;
+
+	int maxWidth = std::max(_yWidth, std::max(_iWidth, _qWidth));
+	int maxFilter = maxWidth / 2;
+
+	//Precalculate the signal (and its products with the color subcarrier), with enough zero padding on both sides
+	//to cover every sample read by the filter windows, to avoid bounds checks/modulos in the filter loop
+	int padding = maxFilter + maxWidth;
+	size_t paddedWidth = width + padding * 2;
+	buffers.Signal.assign(paddedWidth, 0);
+	buffers.ISignal.assign(paddedWidth, 0);
+	buffers.QSignal.assign(paddedWidth, 0);
+	int32_t* ySignal = buffers.Signal.data() + padding;
+	int32_t* iSignal = buffers.ISignal.data() + padding;
+	int32_t* qSignal = buffers.QSignal.data() + padding;
+	for(int pos = 0, cycle = 0; pos < width; pos++) {
+		ySignal[pos] = signal[pos];
+		iSignal[pos] = signal[pos] * _sinetable[cycle + phase0];
+		qSignal[pos] = signal[pos] * _sinetable[cycle + 3 + phase0];
+		cycle = cycle == 11 ? 0 : (cycle + 1);
+	}
+
+	buffers.Y.resize(width);
+	buffers.I.resize(width);
+	buffers.Q.resize(width);
+
+	int ysum = _brightness, isum = 0, qsum = 0;
+	uint32_t count = 0;
+	for(int s = -maxFilter; s < rightOverscan; s++) {
+		int sy = s + _yWidth / 2;
+		int si = s + _iWidth / 2;
+		int sq = s + _qWidth / 2;
+		ysum += ySignal[sy] - ySignal[sy - _yWidth];
+		isum += iSignal[si] - iSignal[si - _iWidth];
+		qsum += qSignal[sq] - qSignal[sq - _qWidth];
+
+		if(s >= leftOverscan && !(s % _resDivider)) {
+			buffers.Y[count] = ysum;
+			buffers.I[count] = isum;
+			buffers.Q[count] = qsum;
+			count++;
+		}
+	}
+
+	//The running sums are sequential, but the conversion to RGB is vectorized
+	VideoFilterKernels::YiqToArgb(buffers.Y.data(), buffers.I.data(), buffers.Q.data(), target, count, _yiqCoefficients);
+}
+
+//Original (scalar, unpadded) version of NtscDecodeLine, used as a reference by VideoFilterTest
+//The subcarrier is only read for samples inside the signal (the other products are always 0)
+void BisqwitNtscFilter::NtscDecodeLineReference(int width, const int8_t* signal, uint32_t* target, int phase0)
+{
+	auto Read = [=](int pos) -> int { return pos >= 0 && pos < width ? signal[pos] : 0; };
+	auto Cos = [=](int pos) -> int { return pos >= 0 && pos < width ? _sinetable[pos % 12 + phase0] : 0; };
+	auto Sin = [=](int pos) -> int { return pos >= 0 && pos < width ? _sinetable[pos % 12 + 3 + phase0] : 0; };
 
 	int ysum = _brightness, isum = 0, qsum = 0;
 	int leftOverscan = GetOverscan().Left * 8;
@@ -292,11 +334,7 @@ void BisqwitNtscFilter::NtscDecodeLine(int width, const int8_t* signal, uint32_t
 		qsum += Read(sq) * Sin(sq) - Read(sq - _qWidth) * Sin(sq - _qWidth);
 
 		if(s >= leftOverscan && !(s % _resDivider)) {
-			int r = std::min(255, std::max(0, (ysum*_y + isum*_ir + qsum*_qr) / 65536));
-			int g = std::min(255, std::max(0, (ysum*_y + isum*_ig + qsum*_qg) / 65536));
-			int b = std::min(255, std::max(0, (ysum*_y + isum*_ib + qsum*_qb) / 65536));
-
-			*target = 0xFF000000 | (r << 16) | (g << 8) | b;
+			VideoFilterKernels::YiqToArgbScalar(&ysum, &isum, &qsum, target, 1, _yiqCoefficients);
 			target++;
 		}
 	}
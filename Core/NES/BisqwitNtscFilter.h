@@ -4,7 +4,7 @@
 #pragma once
 #include "pch.h"
 #include "Shared/Video/BaseVideoFilter.h"
-#include "Utilities/AutoResetEvent.h"
+#include "Shared/Video/VideoFilterKernels.h"
 
 class BisqwitNtscFilter : public BaseVideoFilter
 {
@@ -13,11 +13,6 @@ private:
 	static constexpr int _signalsPerPixel = 8;
 	static constexpr int _signalWidth = 258;
 
-	std::thread _extraThread;
-	AutoResetEvent _waitWork;
-	atomic<bool> _stopThread;
-	atomic<bool> _workDone;
-
 	int _resDivider = 1;
 	uint16_t *_ppuOutputBuffer = nullptr;
 	
@@ -29,9 +24,7 @@ private:
 	* Larger values = more horizontal blurring.
 	*/
 	int _yWidth, _iWidth, _qWidth;
-	int _y;
-	int _ir, _ig, _ib;
-	int _qr, _qg, _qb;
+	YiqToRgbCoefficients _yiqCoefficients = {};
 
 	//To finetune hue, you would have to recalculate sinetable[]. (Coarse changes can be made with Phase0.)
 	int8_t _sinetable[27]; // 8*sin(x*2pi/12)
@@ -42,15 +35,27 @@ private:
 
 	void RecursiveBlend(int iterationCount, uint64_t *output, uint64_t *currentLine, uint64_t *nextLine, int pixelsPerCycle, bool verticalBlend);
 	
-	void NtscDecodeLine(int width, const int8_t* signal, uint32_t* target, int phase0);
+	//Per-band work buffers for NtscDecodeLine
+	struct DecodeBuffers
+	{
+		vector<int32_t> Signal;
+		vector<int32_t> ISignal;
+		vector<int32_t> QSignal;
+		vector<int32_t> Y;
+		vector<int32_t> I;
+		vector<int32_t> Q;
+	};
+
+	void NtscDecodeLine(int width, const int8_t* signal, uint32_t* target, int phase0, DecodeBuffers& buffers);
+	void NtscDecodeLineReference(int width, const int8_t* signal, uint32_t* target, int phase0);
 	
 	void GenerateNtscSignal(int8_t *ntscSignal, int &phase, int rowNumber);
-	void DecodeFrame(int startRow, int endRow, uint16_t *ppuOutputBuffer, uint32_t* outputBuffer, int startPhase);
+	void DecodeFrame(int startRow, int endRow, uint32_t* outputBuffer, int startPhase);
+	void GenerateMissingLines(int startRow, int endRow, uint32_t* outputBuffer);
 	void OnBeforeApplyFilter();
 
 public:
 	BisqwitNtscFilter(Emulator* emu);
-	virtual ~BisqwitNtscFilter();
 
 	virtual void ApplyFilter(uint16_t *ppuOutputBuffer);
 	virtual FrameInfo GetFrameInfo();
@@ -22,6 +22,18 @@ protected:
 		}
 	}
 
+	uint32_t GetExtraDataSize() override
+	{
+		return _chrRomCdl ? _chrRomCdl->GetSize() : 0;
+	}
+
+	void MapExtraData(uint8_t* data, bool initialize) override
+	{
+		if(_chrRomCdl) {
+			_chrRomCdl->SetExternalStorage(data, initialize);
+		}
+	}
+
 public:
 	NesCodeDataLogger(Debugger* debugger, MemoryType memType, uint32_t memSize, CpuType cpuType, uint32_t romCrc32, CodeDataLogger* chrRomCdl)
 		: CodeDataLogger(debugger, memType, memSize, cpuType, romCrc32)
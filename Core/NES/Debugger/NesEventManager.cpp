@@ -9,12 +9,10 @@
 #include "NES/NesConstants.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/Debugger.h"
-#include "Debugger/DebugBreakHelper.h"
 #include "Debugger/BaseEventManager.h"
 
-NesEventManager::NesEventManager(Debugger *debugger, NesConsole* console)
+NesEventManager::NesEventManager(Debugger *debugger, NesConsole* console) : BaseEventManager(debugger)
 {
-	_debugger = debugger;
 	_console = console;
 	_cpu = console->GetCpu();
 	_mapper = console->GetMapper();
@@ -22,13 +20,7 @@ NesEventManager::NesEventManager(Debugger *debugger, NesConsole* console)
 
 	NesDefaultVideoFilter::GetFullPalette(_palette, console->GetNesConfig(), console->GetPpu()->GetPpuModel());
 
-	_ppuBuffer = new uint16_t[NesConstants::ScreenPixelCount];
-	memset(_ppuBuffer, 0, NesConstants::ScreenPixelCount * sizeof(uint16_t));
-}
-
-NesEventManager::~NesEventManager()
-{
-	delete[] _ppuBuffer;
+	InitSnapshots(NesConstants::ScreenPixelCount, 262);
 }
 
 void NesEventManager::AddEvent(DebugEventType type, MemoryOperationInfo& operation, int32_t breakpointId)
@@ -79,7 +71,7 @@ void NesEventManager::AddEvent(DebugEventType type, MemoryOperationInfo& operati
 		}
 	}
 
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void NesEventManager::AddEvent(DebugEventType type)
@@ -98,7 +90,7 @@ void NesEventManager::AddEvent(DebugEventType type)
 	evt.BreakpointId = -1;
 	evt.ProgramCounter = _cpu->GetState().PC;
 	evt.DmaChannel = -1;
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void NesEventManager::ClearFrameEvents()
@@ -202,43 +194,38 @@ void NesEventManager::ConvertScanlineCycleToRowColumn(int32_t& x, int32_t& y)
 	x = x * 2;
 }
 
-uint32_t NesEventManager::TakeEventSnapshot(bool forAutoRefresh)
+void NesEventManager::TakePpuSnapshot(EventViewerSnapshot& snapshot)
 {
 	BaseNesPpu* ppu = _console->GetPpu();
-	DebugBreakHelper breakHelper(_debugger);
-	auto lock = _lock.AcquireSafe();
+	uint16_t* ppuBuffer = snapshot.PpuBuffer.data();
 
 	uint16_t cycle = _console->GetPpu()->GetCurrentCycle();
 	uint16_t scanline = ppu->GetCurrentScanline() + 1;
 
 	if(scanline >= 240 || (scanline == 0 && cycle == 0)) {
-		memcpy(_ppuBuffer, ppu->GetScreenBuffer(false), NesConstants::ScreenPixelCount * sizeof(uint16_t));
+		memcpy(ppuBuffer, ppu->GetScreenBuffer(false), NesConstants::ScreenPixelCount * sizeof(uint16_t));
 	} else {
 		uint32_t offset = (NesConstants::ScreenWidth * scanline);
-		memcpy(_ppuBuffer, ppu->GetScreenBuffer(false), offset * sizeof(uint16_t));
-		memcpy(_ppuBuffer + offset, ppu->GetScreenBuffer(true) + offset, (NesConstants::ScreenPixelCount - offset) * sizeof(uint16_t));
+		memcpy(ppuBuffer, ppu->GetScreenBuffer(false), offset * sizeof(uint16_t));
+		memcpy(ppuBuffer + offset, ppu->GetScreenBuffer(true) + offset, (NesConstants::ScreenPixelCount - offset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
-	_snapshotScanline = scanline;
-	_snapshotCycle = cycle;
-	_forAutoRefresh = forAutoRefresh;
-	_scanlineCount = ppu->GetScanlineCount();
-	return _scanlineCount;
+	snapshot.ScanlineCount = ppu->GetScanlineCount();
+	snapshot.Scanline = scanline;
+	snapshot.Cycle = cycle;
 }
 
 FrameInfo NesEventManager::GetDisplayBufferSize()
 {
 	FrameInfo size;
 	size.Width = NesConstants::CyclesPerLine * 2;
-	size.Height = _scanlineCount * 2;
+	size.Height = _snapshot->ScanlineCount * 2;
 	return size;
 }
 
 void NesEventManager::DrawScreen(uint32_t *buffer)
 {
-	uint16_t *src = _ppuBuffer;
+	uint16_t *src = _snapshot->PpuBuffer.data();
 	for(uint32_t y = 0, len = NesConstants::ScreenHeight*2; y < len; y++) {
 		int rowOffset = (y + 2) * NesConstants::CyclesPerLine * 2;
 
@@ -278,12 +265,14 @@ void NesEventManager::DrawNtscBorders(uint32_t *buffer)
 	bgColor.resize(NesConstants::CyclesPerLine * 243);
 
 	//TODO use bg color changes from previous frame when needed
-	for(DebugEventInfo &evt : _snapshotCurrentFrame) {
-		if(evt.Type == DebugEventType::BgColorChange) {
+	DebugEventList& currentFrame = *_snapshot->CurrentFrame;
+	for(uint32_t i = 0; i < _snapshot->CurrentFrameCount; i++) {
+		DebugEventRecord& evt = currentFrame[i];
+		if(evt.Type == (uint8_t)DebugEventType::BgColorChange) {
 			uint32_t pos = ((evt.Scanline + 1) * NesConstants::CyclesPerLine) + evt.Cycle;
 			if(pos >= currentPos && evt.Scanline < 242) {
 				std::fill(bgColor.begin() + currentPos, bgColor.begin() + pos, currentColor);
-				currentColor = evt.Operation.Address;
+				currentColor = evt.Address;
 				currentPos = pos;
 			}
 		}
@@ -52,26 +52,22 @@ private:
 	NesCpu* _cpu = nullptr;
 	NesConsole* _console = nullptr;
 	BaseMapper* _mapper = nullptr;
-	Debugger* _debugger = nullptr;
 
 	uint32_t _palette[512] = {};
 
-	uint32_t _scanlineCount = 262;
-	uint16_t *_ppuBuffer = nullptr;
-
 	void DrawNtscBorders(uint32_t *buffer);
 	void DrawPixel(uint32_t *buffer, int32_t x, uint32_t y, uint32_t color);
 
 protected:
 	void ConvertScanlineCycleToRowColumn(int32_t& x, int32_t& y) override;
 	void DrawScreen(uint32_t* buffer) override;
+	void TakePpuSnapshot(EventViewerSnapshot& snapshot) override;
 
 	bool ShowPreviousFrameEvents() override;
 	int GetScanlineOffset() override { return 1; }
 
 public:
 	NesEventManager(Debugger *debugger, NesConsole* console);
-	~NesEventManager();
 
 	void AddEvent(DebugEventType type, MemoryOperationInfo& operation, int32_t breakpointId = -1) override;
 	void AddEvent(DebugEventType type) override;
@@ -80,7 +76,6 @@ public:
 
 	EventViewerCategoryCfg GetEventConfig(DebugEventInfo& evt) override;
 
-	uint32_t TakeEventSnapshot(bool forAutoRefresh) override;
 
 	FrameInfo GetDisplayBufferSize() override;
 
@@ -24,6 +24,14 @@ public:
 	__forceinline void DrawPixel()
 	{
 		//This is called 3.7 million times per second - needs to be as fast as possible.
+		if(_skipRender) {
+			//Frame won't be displayed, only run the pixel logic when a sprite 0 hit is still possible
+			if(_sprite0Visible && !_statusFlags.Sprite0Hit && _hasSprite[_cycle] && (IsRenderingEnabled() || ((_videoRamAddr & 0x3F00) != 0x3F00))) {
+				GetPixelColor();
+			}
+			return;
+		}
+
 		if(IsRenderingEnabled() || ((_videoRamAddr & 0x3F00) != 0x3F00)) {
 			uint32_t color = GetPixelColor();
 			_currentOutputBuffer[(_scanline << 8) + _cycle - 1] = _paletteRam[color & 0x03 ? color : 0];
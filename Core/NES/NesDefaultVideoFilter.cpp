@@ -6,6 +6,7 @@
 #include "NES/NesConstants.h"
 #include "NES/NesPpu.h"
 #include "Shared/Video/BaseVideoFilter.h"
+#include "Shared/Video/VideoFilterKernels.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/Emulator.h"
 
@@ -162,7 +163,6 @@ void NesDefaultVideoFilter::OnBeforeApplyFilter()
 
 void NesDefaultVideoFilter::DecodePpuBuffer(uint16_t* ppuOutputBuffer, uint32_t* outputBuffer)
 {
-	uint32_t* out = outputBuffer;
 	OverscanDimensions overscan = GetOverscan();
 	FrameInfo frame = _frameInfo;
 
@@ -171,10 +171,7 @@ void NesDefaultVideoFilter::DecodePpuBuffer(uint16_t* ppuOutputBuffer, uint32_t*
 	}
 
 	for(uint32_t i = 0; i < frame.Height; i++) {
-		for(uint32_t j = 0; j < frame.Width; j++) {
-			*out = _calculatedPalette[ppuOutputBuffer[(i + overscan.Top) * _baseFrameInfo.Width + j + overscan.Left]];
-			out++;
-		}
+		VideoFilterKernels::ConvertPixels(ppuOutputBuffer + (i + overscan.Top) * _baseFrameInfo.Width + overscan.Left, outputBuffer + i * frame.Width, frame.Width, _calculatedPalette, 0x1FF);
 	}
 }
 
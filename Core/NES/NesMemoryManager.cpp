@@ -116,12 +116,20 @@ uint16_t NesMemoryManager::DebugReadWord(uint16_t addr)
 }
 
 uint8_t NesMemoryManager::Read(uint16_t addr, MemoryOperationType operationType)
+{
+	return _emu->HasMemoryHooks() ? InternalRead<true>(addr, operationType) : InternalRead<false>(addr, operationType);
+}
+
+template<bool withHooks>
+__forceinline uint8_t NesMemoryManager::InternalRead(uint16_t addr, MemoryOperationType operationType)
 {
 	uint8_t value = _ramReadHandlers[addr]->ReadRam(addr);
-	if(_cheatManager->HasCheats<CpuType::Nes>()) {
-		_cheatManager->ApplyCheat<CpuType::Nes>(addr, value);
+	if constexpr(withHooks) {
+		if(_cheatManager->HasCheats<CpuType::Nes>()) {
+			_cheatManager->ApplyCheat<CpuType::Nes>(addr, value);
+		}
+		_emu->ProcessMemoryRead<CpuType::Nes>(addr, value, operationType);
 	}
-	_emu->ProcessMemoryRead<CpuType::Nes>(addr, value, operationType);
 
 	_openBusHandler.SetOpenBus(value);
 
@@ -130,12 +138,25 @@ uint8_t NesMemoryManager::Read(uint16_t addr, MemoryOperationType operationType)
 
 void NesMemoryManager::Write(uint16_t addr, uint8_t value, MemoryOperationType operationType)
 {
-	if(_emu->ProcessMemoryWrite<CpuType::Nes>(addr, value, operationType)) {
-		_ramWriteHandlers[addr]->WriteRam(addr, value);
-		_openBusHandler.SetOpenBus(value);
+	if(_emu->HasMemoryHooks()) {
+		InternalWrite<true>(addr, value, operationType);
+	} else {
+		InternalWrite<false>(addr, value, operationType);
 	}
 }
 
+template<bool withHooks>
+__forceinline void NesMemoryManager::InternalWrite(uint16_t addr, uint8_t value, MemoryOperationType operationType)
+{
+	if constexpr(withHooks) {
+		if(!_emu->ProcessMemoryWrite<CpuType::Nes>(addr, value, operationType)) {
+			return;
+		}
+	}
+	_ramWriteHandlers[addr]->WriteRam(addr, value);
+	_openBusHandler.SetOpenBus(value);
+}
+
 void NesMemoryManager::DebugWrite(uint16_t addr, uint8_t value, bool disableSideEffects)
 {
 	if(addr <= 0x1FFF) {
@@ -35,6 +35,9 @@ private:
 
 	void InitializeMemoryHandlers(INesMemoryHandler** memoryHandlers, INesMemoryHandler* handler, vector<uint16_t>* addresses, bool allowOverride);
 
+	template<bool withHooks> uint8_t InternalRead(uint16_t addr, MemoryOperationType operationType);
+	template<bool withHooks> void InternalWrite(uint16_t addr, uint8_t value, MemoryOperationType operationType);
+
 protected:
 	void Serialize(Serializer& s) override;
 
@@ -39,8 +39,10 @@ void NesNtscFilter::OnBeforeApplyFilter()
 {
 	NesConfig& nesCfg = _emu->GetSettings()->GetNesConfig();
 
+	//Keep the current PPU model when no NES game is loaded (e.g when the filter is used by VideoFilterTest)
 	shared_ptr<IConsole> console = _emu->GetConsole();
-	PpuModel model = ((NesConsole*)console.get())->GetPpu()->GetPpuModel();
+	NesConsole* nesConsole = dynamic_cast<NesConsole*>(console.get());
+	PpuModel model = nesConsole ? nesConsole->GetPpu()->GetPpuModel() : _ppuModel;
 
 	if(NtscFilterOptionsChanged(_ntscSetup) || model != _ppuModel || memcmp(_nesConfig.UserPalette, nesCfg.UserPalette, sizeof(nesCfg.UserPalette)) != 0) {
 		InitNtscFilter(_ntscSetup);
@@ -74,7 +76,13 @@ void NesNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		NesDefaultVideoFilter::ApplyPalBorder(ppuOutputBuffer);
 	}
 
-	nes_ntsc_blit(&_ntscData, ppuOutputBuffer, _baseFrameInfo.Width, GetVideoPhase(), _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, NES_NTSC_OUT_WIDTH(_baseFrameInfo.Width) * 4);
+	//Rows are independent (except for the burst phase, which changes on each row), so the blit is split in bands
+	uint32_t inWidth = _baseFrameInfo.Width;
+	uint32_t videoPhase = GetVideoPhase();
+	ProcessRowBands(_baseFrameInfo.Height, [=](uint32_t start, uint32_t end) {
+		int phase = (videoPhase + start) % nes_ntsc_burst_count;
+		nes_ntsc_blit(&_ntscData, ppuOutputBuffer + start * inWidth, inWidth, phase, inWidth, end - start, _ntscBuffer + start * baseWidth, baseWidth * 4);
+	});
 
 	for(uint32_t i = 0; i < frameInfo.Height; i+=2) {
 		memcpy(GetOutputBuffer()+i*frameInfo.Width, _ntscBuffer + yOffset + xOffset + (i/2)*baseWidth, frameInfo.Width * sizeof(uint32_t));
@@ -1121,8 +1121,10 @@ template<class T> void NesPpu<T>::SendFrame()
 			_emu->ProcessEndOfFrame();
 		}
 	} else {
-		bool forRewind = _emu->GetRewindManager()->IsRewinding();
-		_emu->GetVideoDecoder()->UpdateFrame(frame, forRewind, forRewind);
+		if(!_skipRender) {
+			bool forRewind = _emu->GetRewindManager()->IsRewinding();
+			_emu->GetVideoDecoder()->UpdateFrame(frame, forRewind, forRewind);
+		}
 		_emu->ProcessEndOfFrame();
 	}
 
@@ -1298,6 +1300,16 @@ template<class T> void NesPpu<T>::ProcessScanlineFirstCycle()
 
 		_emu->ProcessEvent(EventType::StartFrame);
 
+		if(_console->GetVsMainConsole() || _console->GetVsSubConsole()) {
+			//Both VS DualSystem consoles share the same output
+			_skipRender = _emu->IsRunAheadFrame();
+		} else {
+			//Light guns need the current frame's pixels
+			BaseControlManager* controlManager = _console->GetControlManager();
+			bool hasLightGun = controlManager->HasControlDevice(ControllerType::NesZapper) || controlManager->HasControlDevice(ControllerType::FamicomZapper) || controlManager->HasControlDevice(ControllerType::BandaiHyperShot);
+			_skipRender = _emu->ShouldSkipRender(!hasLightGun);
+		}
+
 		UpdateMinimumDrawCycles();
 	}
 
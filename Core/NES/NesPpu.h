@@ -36,7 +36,9 @@ private:
 	static constexpr int32_t OamDecayCycleCount = 3000;
 
 protected:
-	
+	//Set when the current frame will not be displayed (run ahead, fast forward)
+	bool _skipRender = false;
+
 	void UpdateStatusFlag();
 
 	void SetControlRegister(uint8_t value);
@@ -5,13 +5,15 @@
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/CdReader.h"
+#include "Shared/DiscSectorCache.h"
 #include "Utilities/Serializer.h"
 
-PceCdAudioPlayer::PceCdAudioPlayer(Emulator* emu, PceCdRom* cdrom, DiscInfo& disc)
+PceCdAudioPlayer::PceCdAudioPlayer(Emulator* emu, PceCdRom* cdrom, DiscInfo& disc, DiscSectorCache& sectorCache)
 {
 	_emu = emu;
 	_cdrom = cdrom;
 	_disc = &disc;
+	_sectorCache = &sectorCache;
 	_state.Status = CdAudioStatus::Inactive;
 }
 
@@ -29,6 +31,8 @@ void PceCdAudioPlayer::Play(uint32_t startSector, bool pause)
 		_state.CurrentSector = startSector;
 
 		_clockCounter = 0;
+
+		_sectorCache->Prefetch(startSector);
 	}
 }
 
@@ -42,8 +46,13 @@ void PceCdAudioPlayer::SetEndPosition(uint32_t endSector, CdPlayEndBehavior endB
 void PceCdAudioPlayer::PlaySample()
 {
 	if(_state.Status == CdAudioStatus::Playing) {
-		_state.LeftSample = _disc->ReadLeftSample(_state.CurrentSector, _state.CurrentSample);
-		_state.RightSample = _disc->ReadRightSample(_state.CurrentSector, _state.CurrentSample);
+		if(_loadedSector != _state.CurrentSector) {
+			_sectorCache->ReadAudioSector(_state.CurrentSector, _sectorSamples);
+			_loadedSector = _state.CurrentSector;
+		}
+
+		_state.LeftSample = _sectorSamples[_state.CurrentSample * 2];
+		_state.RightSample = _sectorSamples[_state.CurrentSample * 2 + 1];
 		_samplesToPlay.push_back(_state.LeftSample);
 		_samplesToPlay.push_back(_state.RightSample);
 		_state.CurrentSample++;
@@ -8,16 +8,23 @@
 class Emulator;
 class PceCdRom;
 struct DiscInfo;
+class DiscSectorCache;
 
 class PceCdAudioPlayer final : public IAudioProvider, public ISerializable
 {
 	Emulator* _emu = nullptr;
 	DiscInfo* _disc = nullptr;
+	DiscSectorCache* _sectorCache = nullptr;
 	PceCdRom* _cdrom = nullptr;
 
 	PceCdAudioPlayerState _state = {};
 
 	vector<int16_t> _samplesToPlay;
+
+	//Samples for the sector that is currently playing
+	int16_t _sectorSamples[588 * 2] = {};
+	int64_t _loadedSector = -1;
+
 	uint32_t _clockCounter = 0;
 	
 	HermiteResampler _resampler;
@@ -25,7 +32,7 @@ class PceCdAudioPlayer final : public IAudioProvider, public ISerializable
 	void PlaySample();
 
 public:
-	PceCdAudioPlayer(Emulator* emu, PceCdRom* cdrom, DiscInfo& disc);
+	PceCdAudioPlayer(Emulator* emu, PceCdRom* cdrom, DiscInfo& disc, DiscSectorCache& sectorCache);
 
 	void Play(uint32_t startSector, bool pause);
 	void SetEndPosition(uint32_t endSector, CdPlayEndBehavior endBehavior);
@@ -5,6 +5,7 @@
 #include "PCE/PceConsole.h"
 #include "PCE/PceTypes.h"
 #include "Shared/CdReader.h"
+#include "Shared/DiscSectorCache.h"
 #include "Shared/Emulator.h"
 #include "Shared/MessageManager.h"
 #include "Utilities/HexUtilities.h"
@@ -13,10 +14,11 @@
 
 using namespace ScsiSignal;
 
-PceScsiBus::PceScsiBus(Emulator* emu, PceConsole* console, PceCdRom* cdrom, DiscInfo& disc)
+PceScsiBus::PceScsiBus(Emulator* emu, PceConsole* console, PceCdRom* cdrom, DiscInfo& disc, DiscSectorCache& sectorCache)
 {
 	_emu = emu;
 	_disc = &disc;
+	_sectorCache = &sectorCache;
 	_console = console;
 	_cdrom = cdrom;
 }
@@ -206,6 +208,9 @@ void PceScsiBus::CmdRead()
 	_state.Sector = sector;
 	_state.SectorsToRead = sectorsToRead;
 
+	//Start reading the requested sectors in the background while the seek delay runs
+	_sectorCache->Prefetch(sector, sectorsToRead);
+
 	_cdrom->GetAudioPlayer().SetIdle();
 	if(_emu->IsDebugging()) {
 		LogCommand("Read - Sector: " + std::to_string(_state.Sector) + " to " + std::to_string(_state.Sector + _state.SectorsToRead - 1));
@@ -412,7 +417,7 @@ void PceScsiBus::ProcessDiscRead()
 			if(_dataBuffer.empty()) {
 				//read disc data
 				_dataBuffer.clear();
-				_disc->ReadDataSector(_state.Sector, _dataBuffer);
+				_sectorCache->ReadDataSector(_state.Sector, _dataBuffer);
 
 				LogDebug("[SCSI] Sector #" + std::to_string(_state.Sector) + " finished reading.");
 
@@ -10,14 +10,12 @@
 #include "PCE/PceDefaultVideoFilter.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/Debugger.h"
-#include "Debugger/DebugBreakHelper.h"
 #include "Debugger/BaseEventManager.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 
-PceEventManager::PceEventManager(Debugger *debugger, PceConsole *console)
+PceEventManager::PceEventManager(Debugger *debugger, PceConsole *console) : BaseEventManager(debugger)
 {
-	_debugger = debugger;
 	_emu = debugger->GetEmulator();
 	_cpu = console->GetCpu();
 	_vdc = console->GetVdc();
@@ -25,13 +23,8 @@ PceEventManager::PceEventManager(Debugger *debugger, PceConsole *console)
 	_vce = console->GetVce();
 	_memoryManager = console->GetMemoryManager();
 
-	_ppuBuffer = new uint16_t[PceConstants::MaxScreenWidth * PceConstants::ScreenHeight];
-	memset(_ppuBuffer, 0, PceConstants::MaxScreenWidth * PceConstants::ScreenHeight * sizeof(uint16_t));
-}
-
-PceEventManager::~PceEventManager()
-{
-	delete[] _ppuBuffer;
+	//The row clock dividers are stored after the screen in the snapshot's buffer
+	InitSnapshots(PceConstants::MaxScreenWidth * PceConstants::ScreenHeight + PceConstants::ScreenHeight, 262);
 }
 
 void PceEventManager::AddEvent(DebugEventType type, MemoryOperationInfo &operation, int32_t breakpointId)
@@ -49,7 +42,7 @@ void PceEventManager::AddEvent(DebugEventType type, MemoryOperationInfo &operati
 		evt.RegisterId = _vdc->GetState().CurrentReg; //VDC reg
 	}
 
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void PceEventManager::AddEvent(DebugEventType type)
@@ -61,7 +54,7 @@ void PceEventManager::AddEvent(DebugEventType type)
 	evt.BreakpointId = -1;
 	evt.DmaChannel = -1;
 	evt.ProgramCounter = _cpu->GetState().PC;
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 DebugEventInfo PceEventManager::GetEvent(uint16_t y, uint16_t x)
@@ -172,53 +165,50 @@ void PceEventManager::ConvertScanlineCycleToRowColumn(int32_t& x, int32_t& y)
 	y *= 2;
 }
 
-uint32_t PceEventManager::TakeEventSnapshot(bool forAutoRefresh)
+void PceEventManager::TakePpuSnapshot(EventViewerSnapshot& snapshot)
 {
-	DebugBreakHelper breakHelper(_debugger);
-	auto lock = _lock.AcquireSafe();
+	uint16_t* ppuBuffer = snapshot.PpuBuffer.data();
 
 	uint16_t cycle = _vdc->GetHClock();
 	uint16_t scanline = _vdc->GetScanline();
 
 	constexpr uint32_t size = PceConstants::MaxScreenWidth * PceConstants::ScreenHeight;
+	uint16_t* rowClockDividers = ppuBuffer + size;
 	if(scanline < 14 || scanline >= 256) {
-		memcpy(_ppuBuffer, _vpc->GetScreenBuffer(), size * sizeof(uint16_t));
-		memcpy(_rowClockDividers, _vpc->GetScreenBuffer()+size, PceConstants::ScreenHeight * sizeof(uint16_t));
+		memcpy(ppuBuffer, _vpc->GetScreenBuffer(), size * sizeof(uint16_t));
+		memcpy(rowClockDividers, _vpc->GetScreenBuffer()+size, PceConstants::ScreenHeight * sizeof(uint16_t));
 	} else {
 		uint32_t scanlineOffset = (scanline - 14);
 		uint32_t offset = PceConstants::MaxScreenWidth * scanlineOffset;
-		memcpy(_ppuBuffer, _vpc->GetScreenBuffer(), offset * sizeof(uint16_t));
-		memcpy(_ppuBuffer + offset, _vpc->GetPreviousScreenBuffer() + offset, (size - offset) * sizeof(uint16_t));
+		memcpy(ppuBuffer, _vpc->GetScreenBuffer(), offset * sizeof(uint16_t));
+		memcpy(ppuBuffer + offset, _vpc->GetPreviousScreenBuffer() + offset, (size - offset) * sizeof(uint16_t));
 		
-		memcpy(_rowClockDividers, _vpc->GetScreenBuffer()+size, scanlineOffset * sizeof(uint16_t));
-		memcpy(_rowClockDividers + scanlineOffset, _vpc->GetPreviousScreenBuffer() + size + scanlineOffset, (PceConstants::ScreenHeight - scanlineOffset) * sizeof(uint16_t));
+		memcpy(rowClockDividers, _vpc->GetScreenBuffer()+size, scanlineOffset * sizeof(uint16_t));
+		memcpy(rowClockDividers + scanlineOffset, _vpc->GetPreviousScreenBuffer() + size + scanlineOffset, (PceConstants::ScreenHeight - scanlineOffset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
-	_snapshotScanline = scanline;
-	_snapshotCycle = cycle;
-	_forAutoRefresh = forAutoRefresh;
-	_scanlineCount = _vce->GetScanlineCount();
-	return _scanlineCount;
+	snapshot.ScanlineCount = _vce->GetScanlineCount();
+	snapshot.Scanline = scanline;
+	snapshot.Cycle = cycle;
 }
 
 FrameInfo PceEventManager::GetDisplayBufferSize()
 {
 	FrameInfo size;
 	size.Width = PceConstants::ClockPerScanline;
-	size.Height = _scanlineCount * 2;
+	size.Height = _snapshot->ScanlineCount * 2;
 	return size;
 }
 
 void PceEventManager::DrawScreen(uint32_t *buffer)
 {
-	uint16_t *src = _ppuBuffer;
+	uint16_t *src = _snapshot->PpuBuffer.data();
+	uint16_t *rowClockDividers = src + PceConstants::MaxScreenWidth * PceConstants::ScreenHeight;
 	uint32_t* palette = _emu->GetSettings()->GetPcEngineConfig().Palette;
 
 	for(uint32_t y = 0, len = PceConstants::ScreenHeight * 2; y < len; y++) {
 		uint16_t scanline = y >> 1;
-		uint32_t divider = _rowClockDividers[scanline];
+		uint32_t divider = rowClockDividers[scanline];
 		if(divider == 0) {
 			break;
 		}
@@ -63,28 +63,21 @@ private:
 	PceVpc* _vpc;
 	PceVce* _vce;
 	PceMemoryManager* _memoryManager;
-	Debugger* _debugger;
-
-	uint32_t _scanlineCount = 262;
-	uint16_t* _ppuBuffer = nullptr;
-
-	uint16_t _rowClockDividers[PceConstants::ScreenHeight] = {};
 
 protected:
 	void ConvertScanlineCycleToRowColumn(int32_t& x, int32_t& y) override;
 	void DrawScreen(uint32_t* buffer) override;
+	void TakePpuSnapshot(EventViewerSnapshot& snapshot) override;
 	bool ShowPreviousFrameEvents() override;
 
 public:
 	PceEventManager(Debugger *debugger, PceConsole *console);
-	~PceEventManager();
 
 	void AddEvent(DebugEventType type, MemoryOperationInfo &operation, int32_t breakpointId = -1) override;
 	void AddEvent(DebugEventType type) override;
 	
 	EventViewerCategoryCfg GetEventConfig(DebugEventInfo& evt) override;
 
-	uint32_t TakeEventSnapshot(bool forAutoRefresh) override;
 	FrameInfo GetDisplayBufferSize() override;
 	DebugEventInfo GetEvent(uint16_t y, uint16_t x) override;
 
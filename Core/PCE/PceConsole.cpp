@@ -48,9 +48,10 @@ LoadRomResult PceConsole::LoadRom(VirtualFile& romFile)
 			return LoadRomResult::Failure;
 		}
 		romData = _hesData->RomData;
-	} else if(romFile.GetFileExtension() == ".cue") {
+	} else if(romFile.GetFileExtension() == ".cue" || romFile.GetFileExtension() == CompressedDiscImage::Extension) {
 		DiscInfo disc = {};
-		if(!CdReader::LoadCue(romFile, disc)) {
+		bool discLoaded = romFile.GetFileExtension() == ".cue" ? CdReader::LoadCue(romFile, disc) : CdReader::LoadCompressedImage(romFile, disc);
+		if(!discLoaded) {
 			return LoadRomResult::Failure;
 		}
 
@@ -217,6 +218,11 @@ PceMemoryManager* PceConsole::GetMemoryManager()
 	return _memoryManager.get();
 }
 
+PceCdRom* PceConsole::GetCdRom()
+{
+	return _cdrom.get();
+}
+
 uint64_t PceConsole::GetMasterClock()
 {
 	return _memoryManager->GetState().CycleCount;
@@ -46,7 +46,7 @@ private:
 public:
 	PceConsole(Emulator* emu);
 	
-	static vector<string> GetSupportedExtensions() { return { ".pce", ".cue", ".sgx", ".hes" }; }
+	static vector<string> GetSupportedExtensions() { return { ".pce", ".cue", ".dcz", ".sgx", ".hes" }; }
 	static vector<string> GetSupportedSignatures() { return { "HESM" }; }
 
 	void Serialize(Serializer& s) override;
@@ -72,6 +72,7 @@ public:
 	PceVpc* GetVpc();
 	PcePsg* GetPsg();
 	PceMemoryManager* GetMemoryManager();
+	PceCdRom* GetCdRom();
 
 	bool IsSuperGrafx() { return _vdc2 != nullptr; }
 	
@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "PCE/PceConstants.h"
 #include "Shared/Video/BaseVideoFilter.h"
+#include "Shared/Video/VideoFilterKernels.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/Emulator.h"
 
@@ -162,11 +163,8 @@ public:
 			//Makes video filters work properly
 			for(uint32_t i = 0; i < rowCount; i++) {
 				uint32_t xOffset = PceConstants::GetLeftOverscan(_frameDivider) + (overscan.Left * 4 / _frameDivider);
-				uint32_t baseDstOffset = i * frameInfo.Width;
 				uint32_t baseSrcOffset = i * PceConstants::MaxScreenWidth + yOffset + xOffset;
-				for(uint32_t j = 0; j < frameInfo.Width; j++) {
-					out[baseDstOffset + j] = GetPixel(ppuOutputBuffer, baseSrcOffset + j);
-				}
+				VideoFilterKernels::ConvertPixels(ppuOutputBuffer + baseSrcOffset, out + i * frameInfo.Width, frameInfo.Width, _calculatedPalette, 0x3FF);
 			}
 		} else {
 			//Always output at 4x scale
@@ -77,6 +77,8 @@ public:
 
 	__forceinline uint8_t Read(uint16_t addr, MemoryOperationType type = MemoryOperationType::Read);
 	__forceinline void Write(uint16_t addr, uint8_t value, MemoryOperationType type);
+	template<bool withHooks> __forceinline uint8_t InternalRead(uint16_t addr, MemoryOperationType type);
+	template<bool withHooks> __forceinline void InternalWrite(uint16_t addr, uint8_t value, MemoryOperationType type);
 
 	uint8_t ReadRegister(uint16_t addr);
 	void WriteRegister(uint16_t addr, uint8_t value);
@@ -99,6 +101,12 @@ public:
 };
 
 __forceinline uint8_t PceMemoryManager::Read(uint16_t addr, MemoryOperationType type)
+{
+	return _emu->HasMemoryHooks() ? InternalRead<true>(addr, type) : InternalRead<false>(addr, type);
+}
+
+template<bool withHooks>
+__forceinline uint8_t PceMemoryManager::InternalRead(uint16_t addr, MemoryOperationType type)
 {
 	uint8_t bank = _state.Mpr[(addr & 0xE000) >> 13];
 	uint8_t value;
@@ -112,28 +120,44 @@ __forceinline uint8_t PceMemoryManager::Read(uint16_t addr, MemoryOperationType
 		value = _mapper->Read(bank, addr, value);
 	}
 
-	if(_cheatManager->HasCheats<CpuType::Pce>()) {
-		_cheatManager->ApplyCheat<CpuType::Pce>((bank << 13) | (addr & 0x1FFF), value);
+	if constexpr(withHooks) {
+		if(_cheatManager->HasCheats<CpuType::Pce>()) {
+			_cheatManager->ApplyCheat<CpuType::Pce>((bank << 13) | (addr & 0x1FFF), value);
+		}
+		_emu->ProcessMemoryRead<CpuType::Pce>(addr, value, type);
 	}
-	_emu->ProcessMemoryRead<CpuType::Pce>(addr, value, type);
 	return value;
 }
 
 __forceinline void PceMemoryManager::Write(uint16_t addr, uint8_t value, MemoryOperationType type)
 {
-	if(_emu->ProcessMemoryWrite<CpuType::Pce>(addr, value, type)) {
-		uint8_t bank = _state.Mpr[(addr & 0xE000) >> 13];
-		if(_mapper && _mapper->IsBankMapped(bank)) {
-			_mapper->Write(bank, addr, value);
+	if(_emu->HasMemoryHooks()) {
+		InternalWrite<true>(addr, value, type);
+	} else {
+		InternalWrite<false>(addr, value, type);
+	}
+}
+
+template<bool withHooks>
+__forceinline void PceMemoryManager::InternalWrite(uint16_t addr, uint8_t value, MemoryOperationType type)
+{
+	if constexpr(withHooks) {
+		if(!_emu->ProcessMemoryWrite<CpuType::Pce>(addr, value, type)) {
+			return;
 		}
+	}
+
+	uint8_t bank = _state.Mpr[(addr & 0xE000) >> 13];
+	if(_mapper && _mapper->IsBankMapped(bank)) {
+		_mapper->Write(bank, addr, value);
+	}
 
-		addr &= 0x1FFF;
-		if(bank != 0xFF) {
-			if(_writeBanks[bank]) {
-				_writeBanks[bank][addr] = value;
-			}
-		} else {
-			WriteRegister(addr, value);
+	addr &= 0x1FFF;
+	if(bank != 0xFF) {
+		if(_writeBanks[bank]) {
+			_writeBanks[bank][addr] = value;
 		}
+	} else {
+		WriteRegister(addr, value);
 	}
 }
\ No newline at end of file
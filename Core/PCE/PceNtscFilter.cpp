@@ -94,11 +94,22 @@ void PceNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		}
 	}
 
-	if(_frameDivider) {
-		snes_ntsc_blit(&_ntscData, _rgb555Buffer, frameWidth, IsOddFrame() ? 0 : 1, frameWidth, rowCount, GetOutputBuffer(), frameInfo.Width * sizeof(uint32_t));
-	} else {
-		snes_ntsc_blit_hires(&_ntscData, _rgb555Buffer, frameWidth, IsOddFrame() ? 0 : 1, frameWidth, rowCount, _ntscBuffer, frameInfo.Width * sizeof(uint32_t));
+	//Rows are independent (except for the burst phase, which changes on each row), so the blit is split in bands
+	int burstPhase = IsOddFrame() ? 0 : 1;
+	uint32_t* outputBuffer = _frameDivider ? GetOutputBuffer() : _ntscBuffer;
+	bool useHighResOutput = _frameDivider == 0;
+	ProcessRowBands(rowCount, [=](uint32_t start, uint32_t end) {
+		uint16_t* in = _rgb555Buffer + start * frameWidth;
+		uint32_t* out = outputBuffer + start * frameInfo.Width;
+		int phase = (burstPhase + start) % snes_ntsc_burst_count;
+		if(useHighResOutput) {
+			snes_ntsc_blit_hires(&_ntscData, in, frameWidth, phase, frameWidth, end - start, out, frameInfo.Width * sizeof(uint32_t));
+		} else {
+			snes_ntsc_blit(&_ntscData, in, frameWidth, phase, frameWidth, end - start, out, frameInfo.Width * sizeof(uint32_t));
+		}
+	});
 
+	if(useHighResOutput) {
 		for(uint32_t i = 0; i < rowCount; i++) {
 			uint32_t* src = _ntscBuffer + i * frameInfo.Width;
 			for(uint32_t j = 0; j < verticalScale; j++) {
@@ -25,7 +25,6 @@ private:
 	uint16_t* _outBuffer[2] = {};
 	uint16_t* _currentOutBuffer = nullptr;
 
-	Timer _frameSkipTimer;
 	bool _skipRender = false;
 
 	PceVpcState _state = {};
@@ -131,6 +131,8 @@ public:
 
 	void RunCoprocessors();
 	
+	//Coprocessors catch up to the master clock in bulk after each CPU/DMA clock increment, rather than every 2 master clocks.
+	//The S-CPU only observes them through bus accesses and the IRQ line, which are always sampled after a sync.
 	__forceinline void SyncCoprocessors()
 	{
 		if(_needCoprocSync) {
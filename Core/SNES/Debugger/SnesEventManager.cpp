@@ -6,25 +6,17 @@
 #include "SNES/SnesMemoryManager.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/Debugger.h"
-#include "Debugger/DebugBreakHelper.h"
 #include "Debugger/BaseEventManager.h"
 #include "SNES/SnesDefaultVideoFilter.h"
 
-SnesEventManager::SnesEventManager(Debugger *debugger, SnesCpu *cpu, SnesPpu *ppu, SnesMemoryManager *memoryManager, SnesDmaController *dmaController)
+SnesEventManager::SnesEventManager(Debugger *debugger, SnesCpu *cpu, SnesPpu *ppu, SnesMemoryManager *memoryManager, SnesDmaController *dmaController) : BaseEventManager(debugger)
 {
-	_debugger = debugger;
 	_cpu = cpu;
 	_ppu = ppu;
 	_memoryManager = memoryManager;
 	_dmaController = dmaController;
 
-	_ppuBuffer = new uint16_t[512 * 478];
-	memset(_ppuBuffer, 0, 512 * 478 * sizeof(uint16_t));
-}
-
-SnesEventManager::~SnesEventManager()
-{
-	delete[] _ppuBuffer;
+	InitSnapshots(512 * 478, 262);
 }
 
 void SnesEventManager::AddEvent(DebugEventType type, MemoryOperationInfo &operation, int32_t breakpointId)
@@ -45,7 +37,7 @@ void SnesEventManager::AddEvent(DebugEventType type, MemoryOperationInfo &operat
 
 	evt.ProgramCounter = _debugger->GetProgramCounter(CpuType::Snes, true);
 
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 void SnesEventManager::AddEvent(DebugEventType type)
@@ -59,7 +51,7 @@ void SnesEventManager::AddEvent(DebugEventType type)
 	
 	evt.ProgramCounter = (_cpu->GetState().K << 16) | _cpu->GetState().PC;
 
-	_debugEvents.push_back(evt);
+	AddDebugEvent(evt);
 }
 
 DebugEventInfo SnesEventManager::GetEvent(uint16_t y, uint16_t x)
@@ -155,52 +147,51 @@ void SnesEventManager::ConvertScanlineCycleToRowColumn(int32_t& x, int32_t& y)
 	x /= 2;
 }
 
-uint32_t SnesEventManager::TakeEventSnapshot(bool forAutoRefresh)
+void SnesEventManager::TakePpuSnapshot(EventViewerSnapshot& snapshot)
 {
-	DebugBreakHelper breakHelper(_debugger);
-	auto lock = _lock.AcquireSafe();
+	uint16_t* ppuBuffer = snapshot.PpuBuffer.data();
 
 	uint16_t cycle = _memoryManager->GetHClock();
 	uint16_t scanline = _ppu->GetScanline();
 
-	_overscanMode = _ppu->GetState().OverscanMode;
-	_useHighResOutput = _ppu->IsHighResOutput();
+	bool overscanMode = _ppu->GetState().OverscanMode;
+	bool useHighResOutput = _ppu->IsHighResOutput();
 
 	if(scanline >= _ppu->GetNmiScanline() || scanline == 0) {
-		memcpy(_ppuBuffer, _ppu->GetScreenBuffer(), (_useHighResOutput ? (512 * 478) : (256*239)) * sizeof(uint16_t));
+		memcpy(ppuBuffer, _ppu->GetScreenBuffer(), (useHighResOutput ? (512 * 478) : (256*239)) * sizeof(uint16_t));
 	} else {
-		uint16_t adjustedScanline = scanline + (_overscanMode ? 0 : 7);
-		uint32_t size = _useHighResOutput ? (512 * 478) : (256 * 239);
-		uint32_t offset = _useHighResOutput ? (512 * adjustedScanline * 2) : (256 * adjustedScanline);
-		memcpy(_ppuBuffer, _ppu->GetScreenBuffer(), offset * sizeof(uint16_t));
-		memcpy(_ppuBuffer+offset, _ppu->GetPreviousScreenBuffer()+offset, (size - offset) * sizeof(uint16_t));
+		uint16_t adjustedScanline = scanline + (overscanMode ? 0 : 7);
+		uint32_t size = useHighResOutput ? (512 * 478) : (256 * 239);
+		uint32_t offset = useHighResOutput ? (512 * adjustedScanline * 2) : (256 * adjustedScanline);
+		memcpy(ppuBuffer, _ppu->GetScreenBuffer(), offset * sizeof(uint16_t));
+		memcpy(ppuBuffer+offset, _ppu->GetPreviousScreenBuffer()+offset, (size - offset) * sizeof(uint16_t));
 	}
 
-	_snapshotCurrentFrame = _debugEvents;
-	_snapshotPrevFrame = _prevDebugEvents;
-	_snapshotScanline = scanline;
-	_snapshotCycle = cycle;
-	_forAutoRefresh = forAutoRefresh;
-	_scanlineCount = _ppu->GetVblankEndScanline() + 1;
-	return _scanlineCount;
+	snapshot.ScanlineCount = _ppu->GetVblankEndScanline() + 1;
+	snapshot.Scanline = scanline;
+	snapshot.Cycle = cycle;
+	snapshot.OverscanMode = overscanMode;
+	snapshot.HighResOutput = useHighResOutput;
 }
 
 FrameInfo SnesEventManager::GetDisplayBufferSize()
 {
 	FrameInfo size;
 	size.Width = SnesEventManager::ScanlineWidth;
-	size.Height = _scanlineCount * 2;
+	size.Height = _snapshot->ScanlineCount * 2;
 	return size;
 }
 
 void SnesEventManager::DrawScreen(uint32_t *buffer)
 {
 	//Skip the first 7 blank lines in the buffer when overscan mode is off
-	uint16_t *src = _ppuBuffer + (_overscanMode ? 0 : (_useHighResOutput ? (512 * 14) : (256 * 7)));
+	bool overscanMode = _snapshot->OverscanMode;
+	bool useHighResOutput = _snapshot->HighResOutput;
+	uint16_t *src = _snapshot->PpuBuffer.data() + (overscanMode ? 0 : (useHighResOutput ? (512 * 14) : (256 * 7)));
 
-	for(uint32_t y = 0, len = _overscanMode ? 239*2 : 224*2; y < len; y++) {
+	for(uint32_t y = 0, len = overscanMode ? 239*2 : 224*2; y < len; y++) {
 		for(uint32_t x = 0; x < 512; x++) {
-			int srcOffset = _useHighResOutput ? ((y << 9) | x) : (((y >> 1) << 8) | (x >> 1));
+			int srcOffset = useHighResOutput ? ((y << 9) | x) : (((y >> 1) << 8) | (x >> 1));
 			buffer[(y + 2)*SnesEventManager::ScanlineWidth + x + 22*2] = SnesDefaultVideoFilter::ToArgb(src[srcOffset]);
 		}
 	}
@@ -51,28 +51,21 @@ private:
 	SnesPpu *_ppu;
 	SnesMemoryManager* _memoryManager;
 	SnesDmaController *_dmaController;
-	Debugger *_debugger;
-
-	bool _overscanMode = false;
-	bool _useHighResOutput = false;
-	uint32_t _scanlineCount = 262;
-	uint16_t *_ppuBuffer = nullptr;
 
 protected:
 	void ConvertScanlineCycleToRowColumn(int32_t& x, int32_t& y) override;
 	void DrawScreen(uint32_t* buffer) override;
+	void TakePpuSnapshot(EventViewerSnapshot& snapshot) override;
 	bool ShowPreviousFrameEvents() override;
 
 public:
 	SnesEventManager(Debugger *debugger, SnesCpu *cpu, SnesPpu *ppu, SnesMemoryManager *memoryManager, SnesDmaController *dmaController);
-	~SnesEventManager();
 
 	void AddEvent(DebugEventType type, MemoryOperationInfo &operation, int32_t breakpointId = -1) override;
 	void AddEvent(DebugEventType type) override;
 	
 	EventViewerCategoryCfg GetEventConfig(DebugEventInfo& evt) override;
 
-	uint32_t TakeEventSnapshot(bool forAutoRefresh) override;
 	FrameInfo GetDisplayBufferSize() override;
 	DebugEventInfo GetEvent(uint16_t y, uint16_t x) override;
 
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include "SNES/SnesDefaultVideoFilter.h"
 #include "Shared/Video/DebugHud.h"
+#include "Shared/Video/VideoFilterKernels.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/SettingTypes.h"
@@ -111,20 +112,13 @@ void SnesDefaultVideoFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		}
 	} else {
 		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			for(uint32_t j = 0; j < frameInfo.Width; j++) {
-				out[i*frameInfo.Width+j] = GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset);
-			}
+			VideoFilterKernels::ConvertPixels(ppuOutputBuffer + i * width + yOffset + xOffset, out + i * frameInfo.Width, frameInfo.Width, _calculatedPalette, 0x7FFF);
 		}
 	}
 
 	if(_baseFrameInfo.Width == 512 && _blendHighRes) {
 		//Very basic blend effect for high resolution modes
-		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			for(uint32_t j = 0; j < frameInfo.Width; j++) {
-				uint32_t &pixel1 = out[i*frameInfo.Width + j];
-				pixel1 = BlendPixels(pixel1, out[i * frameInfo.Width + j + 1]);
-			}
-		}
+		VideoFilterKernels::BlendPixels(out, frameInfo.Width * frameInfo.Height);
 	}
 }
 
@@ -132,8 +126,3 @@ uint32_t SnesDefaultVideoFilter::GetPixel(uint16_t* ppuFrame, uint32_t offset)
 {
 	return _calculatedPalette[ppuFrame[offset]];
 }
-
-uint32_t SnesDefaultVideoFilter::BlendPixels(uint32_t a, uint32_t b)
-{
-	return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
-}
@@ -129,6 +129,7 @@ void SnesMemoryManager::IncMasterClock4()
 {
 	Exec();
 	Exec();
+	_cart->SyncCoprocessors();
 }
 
 void SnesMemoryManager::IncMasterClock6()
@@ -136,6 +137,7 @@ void SnesMemoryManager::IncMasterClock6()
 	Exec();
 	Exec();
 	Exec();
+	_cart->SyncCoprocessors();
 }
 
 void SnesMemoryManager::IncMasterClock8()
@@ -144,6 +146,7 @@ void SnesMemoryManager::IncMasterClock8()
 	Exec();
 	Exec();
 	Exec();
+	_cart->SyncCoprocessors();
 }
 
 void SnesMemoryManager::IncMasterClock40()
@@ -152,6 +155,7 @@ void SnesMemoryManager::IncMasterClock40()
 	Exec(); Exec(); Exec(); Exec(); Exec();
 	Exec(); Exec(); Exec(); Exec(); Exec();
 	Exec(); Exec(); Exec(); Exec(); Exec();
+	_cart->SyncCoprocessors();
 }
 
 void SnesMemoryManager::IncMasterClockStartup()
@@ -159,6 +163,7 @@ void SnesMemoryManager::IncMasterClockStartup()
 	for(int i = 0; i < 182 / 2; i++) {
 		Exec();
 	}
+	_cart->SyncCoprocessors();
 }
 
 void SnesMemoryManager::IncrementMasterClockValue(uint16_t cyclesToRun)
@@ -171,6 +176,7 @@ void SnesMemoryManager::IncrementMasterClockValue(uint16_t cyclesToRun)
 		case 4: Exec(); [[fallthrough]];
 		case 2: Exec(); break;
 	}
+	_cart->SyncCoprocessors();
 }
 
 void SnesMemoryManager::Exec()
@@ -186,8 +192,6 @@ void SnesMemoryManager::Exec()
 		_emu->ProcessPpuCycle<CpuType::Snes>();
 		_regs->ProcessIrqCounters();
 	}
-
-	_cart->SyncCoprocessors();
 }
 
 void SnesMemoryManager::ProcessEvent()
@@ -237,6 +241,12 @@ void SnesMemoryManager::ProcessEvent()
 }
 
 uint8_t SnesMemoryManager::Read(uint32_t addr, MemoryOperationType type)
+{
+	return _emu->HasMemoryHooks() ? InternalRead<true>(addr, type) : InternalRead<false>(addr, type);
+}
+
+template<bool withHooks>
+__forceinline uint8_t SnesMemoryManager::InternalRead(uint32_t addr, MemoryOperationType type)
 {
 	IncrementMasterClockValue(_cpuSpeed - 4);
 
@@ -251,11 +261,15 @@ uint8_t SnesMemoryManager::Read(uint32_t addr, MemoryOperationType type)
 		value = _openBus;
 		LogDebug("[Debug] Read - missing handler: $" + HexUtilities::ToHex(addr));
 	}
-	if(_cheatManager->HasCheats<CpuType::Snes>()) {
-		_cheatManager->ApplyCheat<CpuType::Snes>(addr, value);
+	if constexpr(withHooks) {
+		if(_cheatManager->HasCheats<CpuType::Snes>()) {
+			_cheatManager->ApplyCheat<CpuType::Snes>(addr, value);
+		}
 	}
 	IncMasterClock4();
-	_emu->ProcessMemoryRead<CpuType::Snes>(addr, value, type);
+	if constexpr(withHooks) {
+		_emu->ProcessMemoryRead<CpuType::Snes>(addr, value, type);
+	}
 	return value;
 }
 
@@ -313,18 +327,32 @@ void SnesMemoryManager::PeekBlock(uint32_t addr, uint8_t *dest)
 }
 
 void SnesMemoryManager::Write(uint32_t addr, uint8_t value, MemoryOperationType type)
+{
+	if(_emu->HasMemoryHooks()) {
+		InternalWrite<true>(addr, value, type);
+	} else {
+		InternalWrite<false>(addr, value, type);
+	}
+}
+
+template<bool withHooks>
+__forceinline void SnesMemoryManager::InternalWrite(uint32_t addr, uint8_t value, MemoryOperationType type)
 {
 	IncrementMasterClockValue(_cpuSpeed);
-	if(_emu->ProcessMemoryWrite<CpuType::Snes>(addr, value, type)) {
-		IMemoryHandler* handler = _mappings.GetHandler(addr);
-		if(handler) {
-			handler->Write(addr, value);
-			_memTypeBusA = handler->GetMemoryType();
-		} else {
-			LogDebug("[Debug] Write - missing handler: $" + HexUtilities::ToHex(addr) + " = " + HexUtilities::ToHex(value));
+	if constexpr(withHooks) {
+		if(!_emu->ProcessMemoryWrite<CpuType::Snes>(addr, value, type)) {
+			return;
 		}
-		_openBus = value;
 	}
+
+	IMemoryHandler* handler = _mappings.GetHandler(addr);
+	if(handler) {
+		handler->Write(addr, value);
+		_memTypeBusA = handler->GetMemoryType();
+	} else {
+		LogDebug("[Debug] Write - missing handler: $" + HexUtilities::ToHex(addr) + " = " + HexUtilities::ToHex(value));
+	}
+	_openBus = value;
 }
 
 void SnesMemoryManager::WriteDma(uint32_t addr, uint8_t value, bool forBusA)
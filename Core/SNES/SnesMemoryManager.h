@@ -63,6 +63,9 @@ private:
 
 	void ProcessEvent();
 
+	template<bool withHooks> uint8_t InternalRead(uint32_t addr, MemoryOperationType type);
+	template<bool withHooks> void InternalWrite(uint32_t addr, uint8_t value, MemoryOperationType type);
+
 public:
 	void Initialize(SnesConsole* console);
 	virtual ~SnesMemoryManager();
@@ -51,16 +51,26 @@ void SnesNtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 	uint32_t baseWidth = SNES_NTSC_OUT_WIDTH(256);
 	uint32_t xOffset = overscan.Left;
 	uint32_t yOffset = overscan.Top/2 * baseWidth;
+	int burstPhase = IsOddFrame() ? 0 : 1;
+
+	//Rows are independent (except for the burst phase, which changes on each row), so the blit is split in bands
+	uint32_t inWidth = _baseFrameInfo.Width;
+	ProcessRowBands(_baseFrameInfo.Height, [=](uint32_t start, uint32_t end) {
+		uint16_t* in = ppuOutputBuffer + start * inWidth;
+		uint32_t* out = _ntscBuffer + start * baseWidth;
+		int phase = (burstPhase + start) % snes_ntsc_burst_count;
+		if(useHighResOutput) {
+			snes_ntsc_blit_hires(&_ntscData, in, inWidth, phase, inWidth, end - start, out, baseWidth * 4);
+		} else {
+			snes_ntsc_blit(&_ntscData, in, inWidth, phase, inWidth, end - start, out, baseWidth * 4);
+		}
+	});
 
 	if(useHighResOutput) {
-		snes_ntsc_blit_hires(&_ntscData, ppuOutputBuffer, _baseFrameInfo.Width, IsOddFrame() ? 0 : 1, _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, baseWidth * 4);
-		
 		for(uint32_t i = 0; i < frameInfo.Height; i++) {
 			memcpy(GetOutputBuffer() + i * frameInfo.Width, _ntscBuffer + yOffset*2 + xOffset + i * baseWidth, frameInfo.Width * sizeof(uint32_t));
 		}
 	} else {
-		snes_ntsc_blit(&_ntscData, ppuOutputBuffer, _baseFrameInfo.Width, IsOddFrame() ? 0 : 1, _baseFrameInfo.Width, _baseFrameInfo.Height, _ntscBuffer, baseWidth * 4);
-
 		for(uint32_t i = 0; i < frameInfo.Height; i += 2) {
 			memcpy(GetOutputBuffer() + i * frameInfo.Width, _ntscBuffer + yOffset + xOffset + i / 2 * baseWidth, frameInfo.Width * sizeof(uint32_t));
 			memcpy(GetOutputBuffer() + (i + 1) * frameInfo.Width, _ntscBuffer + yOffset + xOffset + i / 2 * baseWidth, frameInfo.Width * sizeof(uint32_t));
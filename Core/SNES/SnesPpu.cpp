@@ -12,7 +12,6 @@
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/Video/VideoDecoder.h"
-#include "Shared/Video/VideoRenderer.h"
 #include "Shared/NotificationManager.h"
 #include "Shared/RenderedFrame.h"
 #include "Shared/MessageManager.h"
@@ -489,18 +488,7 @@ bool SnesPpu::ProcessEndOfScanline(uint16_t& hClock)
 			_timeOver = false;
 			_emu->ProcessEvent(EventType::StartFrame);
 
-			_skipRender = (
-				!_settings->GetSnesConfig().DisableFrameSkipping &&
-				(!_interlacedFrame || (_frameCount & 0x02)) &&
-				!_emu->GetRewindManager()->IsRewinding() &&
-				!_emu->GetVideoRenderer()->IsRecording() &&
-				(_settings->GetEmulationSpeed() == 0 || _settings->GetEmulationSpeed() > 150) &&
-				_frameSkipTimer.GetElapsedMS() < 10
-			);
-			
-			if(_emu->IsRunAheadFrame()) {
-				_skipRender = true;
-			}
+			_skipRender = _emu->ShouldSkipRender(!_settings->GetSnesConfig().DisableFrameSkipping && (!_interlacedFrame || (_frameCount & 0x02)));
 
 			//Ensure the SPC is re-enabled for the next frame
 			_spc->SetSpcState(true);
@@ -1498,11 +1486,9 @@ void SnesPpu::SendFrame()
 	}
 	_needFullFrame = false;
 
-	RenderedFrame frame(_currentBuffer, width, height, _useHighResOutput ? 0.5 : 1.0, _frameCount, _console->GetControlManager()->GetPortStates());
-	_emu->GetVideoDecoder()->UpdateFrame(frame, isRewinding, isRewinding);
-
 	if(!_skipRender) {
-		_frameSkipTimer.Reset();
+		RenderedFrame frame(_currentBuffer, width, height, _useHighResOutput ? 0.5 : 1.0, _frameCount, _console->GetControlManager()->GetPortStates());
+		_emu->GetVideoDecoder()->UpdateFrame(frame, isRewinding, isRewinding);
 	}
 }
 
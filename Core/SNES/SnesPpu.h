@@ -2,7 +2,6 @@
 #include "pch.h"
 #include "SNES/SnesPpuTypes.h"
 #include "Utilities/ISerializable.h"
-#include "Utilities/Timer.h"
 
 class Emulator;
 class SnesConsole;
@@ -104,7 +103,6 @@ private:
 	uint16_t _latchRequestX = 0;
 	uint16_t _latchRequestY = 0;
 
-	Timer _frameSkipTimer;
 	bool _skipRender = false;
 	uint8_t _configVisibleLayers = 0xFF;
 
@@ -31,6 +31,23 @@ struct CueFileEntry
 	vector<CueTrackEntry> Tracks;
 };
 
+static void LogTracks(DiscInfo& disc)
+{
+	MessageManager::Log("---- DISC TRACKS ----");
+	int i = 1;
+	for(TrackInfo& trk : disc.Tracks) {
+		MessageManager::Log("Track " + std::to_string(i) + " (" + string(magic_enum::enum_name(trk.Format)) + ")");
+		if(trk.HasLeadIn) {
+			MessageManager::Log("  Lead-in: " + trk.LeadInPosition.ToString());
+		}
+		MessageManager::Log("  Time: " + trk.StartPosition.ToString() + " - " + trk.EndPosition.ToString());
+		MessageManager::Log("  Sectors: " + std::to_string(trk.FirstSector) + " - " + std::to_string(trk.LastSector));
+		MessageManager::Log("  File offset: " + std::to_string(trk.FileOffset) + " - " + std::to_string(trk.FileOffset+trk.Size-1));
+		i++;
+	}
+	MessageManager::Log("---- END TRACKS ----");
+}
+
 bool CdReader::LoadCue(VirtualFile& cueFile, DiscInfo& disc)
 {
 	vector<CueFileEntry> files;
@@ -226,20 +243,30 @@ bool CdReader::LoadCue(VirtualFile& cueFile, DiscInfo& disc)
 	disc.EndPosition = discLastTrk.EndPosition;
 	disc.DiscSize = discLastTrk.FileOffset + discLastTrk.Size;
 	disc.DiscSectorCount = discLastTrk.LastSector + 1;
+	disc.InitSectorTracks();
 
-	MessageManager::Log("---- DISC TRACKS ----");
-	int i = 1;
-	for(TrackInfo& trk : disc.Tracks) {
-		MessageManager::Log("Track " + std::to_string(i) + " (" + string(magic_enum::enum_name(trk.Format)) + ")");
-		if(trk.HasLeadIn) {
-			MessageManager::Log("  Lead-in: " + trk.LeadInPosition.ToString());
-		}
-		MessageManager::Log("  Time: " + trk.StartPosition.ToString() + " - " + trk.EndPosition.ToString());
-		MessageManager::Log("  Sectors: " + std::to_string(trk.FirstSector) + " - " + std::to_string(trk.LastSector));
-		MessageManager::Log("  File offset: " + std::to_string(trk.FileOffset) + " - " + std::to_string(trk.FileOffset+trk.Size-1));
-		i++;
+	LogTracks(disc);
+
+	return disc.Tracks.size() > 0;
+}
+
+bool CdReader::LoadCompressedImage(VirtualFile& file, DiscInfo& disc)
+{
+	shared_ptr<CompressedDiscImage> image = std::make_shared<CompressedDiscImage>();
+	if(!image->Load(file, disc)) {
+		return false;
 	}
-	MessageManager::Log("---- END TRACKS ----");
 
+	disc.Image = image;
+	LogTracks(disc);
 	return disc.Tracks.size() > 0;
 }
+
+bool CdReader::CreateCompressedImage(VirtualFile& cueFile, string outFile)
+{
+	DiscInfo disc = {};
+	if(!LoadCue(cueFile, disc)) {
+		return false;
+	}
+	return CompressedDiscImage::Create(disc, outFile);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "pch.h"
+#include "Shared/CompressedDiscImage.h"
 #include "Utilities/VirtualFile.h"
 #include "Shared/MessageManager.h"
 
@@ -79,13 +80,38 @@ struct DiscInfo
 	static constexpr int SectorSize = 2352;
 
 	vector<VirtualFile> Files;
+
+	//Set when the disc is loaded from a compressed image (all tracks then refer to the image's data)
+	shared_ptr<CompressedDiscImage> Image;
 	vector<TrackInfo> Tracks;
 	uint32_t DiscSize;
 	uint32_t DiscSectorCount;
 	DiscPosition EndPosition;
 
+	//Track index for each sector of the disc (NoTrack for pregaps)
+	static constexpr uint8_t NoTrack = 0xFF;
+	vector<uint8_t> SectorTracks;
+
+	void InitSectorTracks()
+	{
+		SectorTracks.clear();
+		SectorTracks.resize(DiscSectorCount, DiscInfo::NoTrack);
+		for(size_t i = 0; i < Tracks.size() && i < DiscInfo::NoTrack; i++) {
+			for(uint32_t sector = Tracks[i].FirstSector; sector <= Tracks[i].LastSector && sector < DiscSectorCount; sector++) {
+				SectorTracks[sector] = (uint8_t)i;
+			}
+		}
+	}
+
 	int32_t GetTrack(uint32_t sector)
 	{
+		if(!SectorTracks.empty()) {
+			if(sector < SectorTracks.size() && SectorTracks[sector] != DiscInfo::NoTrack) {
+				return SectorTracks[sector];
+			}
+			return -1;
+		}
+
 		for(size_t i = 0; i < Tracks.size(); i++) {
 			if(sector >= Tracks[i].FirstSector && sector <= Tracks[i].LastSector) {
 				return (int32_t)i;
@@ -110,6 +136,25 @@ struct DiscInfo
 		return -1;
 	}
 
+	template<typename T>
+	bool ReadFileData(uint32_t fileIndex, uint32_t offset, uint32_t length, T& outData)
+	{
+		if(Image) {
+			uint8_t buffer[DiscInfo::SectorSize];
+			while(length > 0) {
+				uint32_t count = std::min<uint32_t>(length, DiscInfo::SectorSize);
+				if(!Image->Read(offset, count, buffer)) {
+					return false;
+				}
+				outData.insert(outData.end(), buffer, buffer + count);
+				offset += count;
+				length -= count;
+			}
+			return true;
+		}
+		return Files[fileIndex].ReadChunk(outData, offset, length);
+	}
+
 	template<typename T>
 	void ReadDataSector(uint32_t sector, T& outData)
 	{
@@ -125,40 +170,19 @@ struct DiscInfo
 			uint32_t sectorSize = trk.GetSectorSize();
 			uint32_t sectorHeaderSize = trk.Format == TrackFormat::Mode1_2352 ? Mode1_2352_SectorHeaderSize : 0;
 			uint32_t byteOffset = trk.FileOffset + (sector - trk.FirstSector) * sectorSize;
-			if(!Files[trk.FileIndex].ReadChunk(outData, byteOffset + sectorHeaderSize, 2048)) {
+			if(!ReadFileData(trk.FileIndex, byteOffset + sectorHeaderSize, 2048, outData)) {
 				LogDebug("Invalid read offsets");
 			}
 		}
 	}
-
-	int16_t ReadAudioSample(uint32_t sector, uint32_t sample, uint32_t byteOffset)
-	{
-		int32_t track = GetTrack(sector);
-		if(track < 0) {
-			LogDebug("Invalid sector/track");
-			return 0;
-		}
-
-		uint32_t fileIndex = Tracks[track].FileIndex;
-		uint32_t startByte = Tracks[track].FileOffset + (sector - Tracks[track].FirstSector) * DiscInfo::SectorSize;
-		return (int16_t)(Files[fileIndex].ReadByte(startByte + sample * 4 + byteOffset) | (Files[fileIndex].ReadByte(startByte + sample * 4 + 1 + byteOffset) << 8));
-	}
-
-	int16_t ReadLeftSample(uint32_t sector, uint32_t sample)
-	{
-		return ReadAudioSample(sector, sample, 0);
-	}
-
-	int16_t ReadRightSample(uint32_t sector, uint32_t sample)
-	{
-		return ReadAudioSample(sector, sample, 2);
-	}
 };
 
 class CdReader
 {
 public:
 	static bool LoadCue(VirtualFile& file, DiscInfo& disc);
+	static bool LoadCompressedImage(VirtualFile& file, DiscInfo& disc);
+	static bool CreateCompressedImage(VirtualFile& cueFile, string outFile);
 
 	static uint8_t ToBcd(uint8_t value)
 	{
@@ -47,11 +47,22 @@ bool CheatManager::AddCheat(CheatCode code)
 		_cheatsByAddress[cpuIndex].emplace(convertedCode->Address, convertedCode.value());
 		_hasCheats[cpuIndex] = true;
 		_bankHasCheats[cpuIndex][convertedCode->Address >> GetBankShift(convertedCode->Cpu)] = true;
+		_emu->UpdateMemoryHooks();
 	}
 
 	return true;
 }
 
+bool CheatManager::HasAddressCheats()
+{
+	for(int i = 0; i < CpuTypeUtilities::GetCpuTypeCount(); i++) {
+		if(_hasCheats[i]) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void CheatManager::SetCheats(vector<CheatCode>& codes)
 {
 	auto lock = _emu->AcquireLock();
@@ -90,6 +101,7 @@ void CheatManager::InternalClearCheats()
 	}
 	memset(_hasCheats, 0, sizeof(_hasCheats));
 	memset(_bankHasCheats, 0, sizeof(_bankHasCheats));
+	_emu->UpdateMemoryHooks();
 }
 
 void CheatManager::ClearCheats(bool showMessage)
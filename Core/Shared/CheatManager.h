@@ -100,6 +100,9 @@ public:
 		return _hasCheats[(int)cpuType];
 	}
 
+	//True when any CPU has cheats that must be applied on reads (RAM cheats don't need the memory hooks)
+	bool HasAddressCheats();
+
 	template<CpuType cpuType>
 	__noinline void ApplyCheat(uint32_t addr, uint8_t& value);
 };
\ No newline at end of file
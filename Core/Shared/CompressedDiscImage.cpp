@@ -0,0 +1,325 @@
+#include "pch.h"
+#include "Shared/CompressedDiscImage.h"
+#include "Shared/CdReader.h"
+#include "Shared/MessageManager.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/FolderUtilities.h"
+#include "Utilities/miniz.h"
+
+struct CompressedDiscHeader
+{
+	char Magic[4];
+	uint32_t Version;
+	uint32_t HunkSize;
+	uint32_t HunkCount;
+	uint64_t ImageSize;
+	uint32_t TrackCount;
+	uint32_t DiscSize;
+	uint32_t DiscSectorCount;
+	uint32_t EndPosition;
+};
+
+struct CompressedDiscTrack
+{
+	uint8_t Format;
+	uint8_t HasLeadIn;
+	uint16_t Reserved;
+	uint32_t LeadInPosition;
+	uint32_t StartPosition;
+	uint32_t EndPosition;
+	uint32_t Size;
+	uint32_t SectorCount;
+	uint32_t FileOffset;
+	uint32_t FirstSector;
+	uint32_t LastSector;
+};
+
+bool CompressedDiscImage::Load(VirtualFile& file, DiscInfo& disc)
+{
+	if(!file.IsArchive() && _mappedFile.Open(file.GetFilePath())) {
+		_data = _mappedFile.GetData();
+		_size = _mappedFile.GetSize();
+	} else if(file.ReadFile(_fileData)) {
+		_data = _fileData.data();
+		_size = _fileData.size();
+	} else {
+		return false;
+	}
+
+	CompressedDiscHeader header = {};
+	if(_size < sizeof(header)) {
+		return false;
+	}
+	memcpy(&header, _data, sizeof(header));
+
+	if(memcmp(header.Magic, "MDCZ", 4) != 0 || header.Version > CompressedDiscImage::FileVersion) {
+		MessageManager::Log("[DCZ] Invalid or unsupported file");
+		return false;
+	}
+
+	uint64_t trackTableSize = (uint64_t)header.TrackCount * sizeof(CompressedDiscTrack);
+	uint64_t hunkTableSize = ((uint64_t)header.HunkCount + 1) * sizeof(uint64_t);
+	uint64_t headerEnd = sizeof(header) + trackTableSize + hunkTableSize;
+	if(header.TrackCount == 0 || header.HunkSize == 0 || headerEnd > _size) {
+		MessageManager::Log("[DCZ] Invalid header");
+		return false;
+	}
+
+	//Every hunk is full, except the last one which contains the rest of the image
+	uint64_t hunkCount = (header.ImageSize + header.HunkSize - 1) / header.HunkSize;
+	if(header.ImageSize == 0 || header.ImageSize > UINT32_MAX || hunkCount != header.HunkCount) {
+		MessageManager::Log("[DCZ] Invalid image size");
+		return false;
+	}
+
+	const uint8_t* src = _data + sizeof(header);
+	for(uint32_t i = 0; i < header.TrackCount; i++) {
+		CompressedDiscTrack entry;
+		memcpy(&entry, src, sizeof(entry));
+		src += sizeof(entry);
+
+		if(entry.Format > (uint8_t)TrackFormat::Mode1_2048 || entry.FirstSector > entry.LastSector || entry.LastSector >= header.DiscSectorCount) {
+			MessageManager::Log("[DCZ] Invalid track #" + std::to_string(i + 1));
+			return false;
+		}
+
+		TrackInfo trk = {};
+		trk.Format = (TrackFormat)entry.Format;
+		trk.HasLeadIn = entry.HasLeadIn != 0;
+		trk.LeadInPosition = DiscPosition::FromLba(entry.LeadInPosition);
+		trk.StartPosition = DiscPosition::FromLba(entry.StartPosition);
+		trk.EndPosition = DiscPosition::FromLba(entry.EndPosition);
+		trk.Size = entry.Size;
+		trk.SectorCount = entry.SectorCount;
+		trk.FileIndex = 0;
+		trk.FileOffset = entry.FileOffset;
+		trk.FirstSector = entry.FirstSector;
+		trk.LastSector = entry.LastSector;
+
+		//The track's sectors must be within the image
+		uint64_t trackEnd = (uint64_t)trk.FileOffset + (uint64_t)(trk.LastSector - trk.FirstSector + 1) * trk.GetSectorSize();
+		if(trackEnd > header.ImageSize || (uint64_t)trk.FileOffset + trk.Size > header.ImageSize) {
+			MessageManager::Log("[DCZ] Invalid track #" + std::to_string(i + 1));
+			return false;
+		}
+
+		disc.Tracks.push_back(trk);
+	}
+
+	_hunkOffsets.resize(header.HunkCount + 1);
+	memcpy(_hunkOffsets.data(), src, hunkTableSize);
+	if(_hunkOffsets[0] < headerEnd) {
+		MessageManager::Log("[DCZ] Invalid hunk index");
+		return false;
+	}
+	for(size_t i = 1; i < _hunkOffsets.size(); i++) {
+		if(_hunkOffsets[i] < _hunkOffsets[i - 1] || _hunkOffsets[i] > _size) {
+			MessageManager::Log("[DCZ] Invalid hunk index");
+			return false;
+		}
+	}
+
+	_imageSize = header.ImageSize;
+	_hunkSize = header.HunkSize;
+
+	disc.DiscSize = header.DiscSize;
+	disc.DiscSectorCount = header.DiscSectorCount;
+	disc.EndPosition = DiscPosition::FromLba(header.EndPosition);
+	disc.InitSectorTracks();
+	return true;
+}
+
+CompressedDiscImage::CachedHunk* CompressedDiscImage::GetHunk(uint32_t hunk)
+{
+	CachedHunk* lru = &_cache[0];
+	for(CachedHunk& entry : _cache) {
+		if(entry.Hunk == hunk) {
+			entry.LastUse = ++_useCounter;
+			return &entry;
+		} else if(entry.LastUse < lru->LastUse) {
+			lru = &entry;
+		}
+	}
+
+	if(hunk + 1 >= _hunkOffsets.size()) {
+		return nullptr;
+	}
+
+	uint64_t start = (uint64_t)hunk * _hunkSize;
+	uint32_t hunkSize = (uint32_t)std::min<uint64_t>(_hunkSize, _imageSize - start);
+	uint64_t compressedSize = _hunkOffsets[hunk + 1] - _hunkOffsets[hunk];
+	const uint8_t* compressedData = _data + _hunkOffsets[hunk];
+
+	lru->Hunk = -1;
+	lru->Data.resize(hunkSize);
+	if(compressedSize == hunkSize) {
+		//Hunk was stored without compression
+		memcpy(lru->Data.data(), compressedData, hunkSize);
+	} else {
+		unsigned long decompSize = hunkSize;
+		if(uncompress(lru->Data.data(), &decompSize, compressedData, (unsigned long)compressedSize) != MZ_OK || decompSize != hunkSize) {
+			MessageManager::Log("[DCZ] Could not decompress hunk #" + std::to_string(hunk));
+			return nullptr;
+		}
+	}
+
+	lru->Hunk = hunk;
+	lru->LastUse = ++_useCounter;
+	return lru;
+}
+
+bool CompressedDiscImage::Read(uint32_t offset, uint32_t length, uint8_t* out)
+{
+	if((uint64_t)offset + length > _imageSize) {
+		return false;
+	}
+
+	auto lock = _lock.AcquireSafe();
+	while(length > 0) {
+		CachedHunk* hunk = GetHunk(offset / _hunkSize);
+		if(!hunk) {
+			return false;
+		}
+
+		uint32_t hunkOffset = offset % _hunkSize;
+		uint32_t count = std::min<uint32_t>(length, (uint32_t)hunk->Data.size() - hunkOffset);
+		memcpy(out, hunk->Data.data() + hunkOffset, count);
+		out += count;
+		offset += count;
+		length -= count;
+	}
+	return true;
+}
+
+bool CompressedDiscImage::Create(DiscInfo& disc, string outFile)
+{
+	//Write to a temporary file first, to avoid leaving a partial image behind if the conversion fails
+	string tmpFile = outFile + ".tmp";
+	ofstream out(tmpFile, std::ios::out | std::ios::binary);
+	if(!out) {
+		MessageManager::Log("[DCZ] Could not write file: " + outFile);
+		return false;
+	}
+
+	bool result = WriteImage(disc, out);
+	out.close();
+	if(!result || !out || !FolderUtilities::RenameFile(tmpFile, outFile)) {
+		std::remove(tmpFile.c_str());
+		MessageManager::Log("[DCZ] Could not write file: " + outFile);
+		return false;
+	}
+	return true;
+}
+
+bool CompressedDiscImage::WriteImage(DiscInfo& disc, ofstream& out)
+{
+	//All data files are stored one after the other, as a single image
+	vector<uint64_t> fileStart;
+	uint64_t imageSize = 0;
+	for(VirtualFile& file : disc.Files) {
+		fileStart.push_back(imageSize);
+		imageSize += file.GetSize();
+	}
+
+	if(disc.Tracks.empty() || imageSize == 0 || imageSize > UINT32_MAX) {
+		return false;
+	}
+
+	uint32_t hunkCount = (uint32_t)((imageSize + CompressedDiscImage::HunkSize - 1) / CompressedDiscImage::HunkSize);
+
+	CompressedDiscHeader header = {};
+	memcpy(header.Magic, "MDCZ", 4);
+	header.Version = CompressedDiscImage::FileVersion;
+	header.HunkSize = CompressedDiscImage::HunkSize;
+	header.HunkCount = hunkCount;
+	header.ImageSize = imageSize;
+	header.TrackCount = (uint32_t)disc.Tracks.size();
+	header.DiscSize = disc.DiscSize;
+	header.DiscSectorCount = disc.DiscSectorCount;
+	header.EndPosition = disc.EndPosition.ToLba();
+	out.write((char*)&header, sizeof(header));
+
+	for(TrackInfo& trk : disc.Tracks) {
+		CompressedDiscTrack entry = {};
+		entry.Format = (uint8_t)trk.Format;
+		entry.HasLeadIn = trk.HasLeadIn ? 1 : 0;
+		entry.LeadInPosition = trk.LeadInPosition.ToLba();
+		entry.StartPosition = trk.StartPosition.ToLba();
+		entry.EndPosition = trk.EndPosition.ToLba();
+		entry.Size = trk.Size;
+		entry.SectorCount = trk.SectorCount;
+		entry.FileOffset = (uint32_t)(fileStart[trk.FileIndex] + trk.FileOffset);
+		entry.FirstSector = trk.FirstSector;
+		entry.LastSector = trk.LastSector;
+		out.write((char*)&entry, sizeof(entry));
+	}
+
+	//The offset table is written once all hunks have been compressed
+	vector<uint64_t> hunkOffsets(hunkCount + 1);
+	std::streamoff hunkTablePos = out.tellp();
+	out.write((char*)hunkOffsets.data(), hunkOffsets.size() * sizeof(uint64_t));
+	uint64_t currentOffset = (uint64_t)out.tellp();
+
+	//Hunks are compressed in batches, over multiple threads
+	uint32_t threadCount = std::max<uint32_t>(1, std::min<uint32_t>(8, std::thread::hardware_concurrency()));
+	uint32_t batchSize = threadCount * 16;
+	vector<vector<uint8_t>> rawHunks(batchSize);
+	vector<vector<uint8_t>> compressedHunks(batchSize);
+
+	uint32_t fileIndex = 0;
+	for(uint32_t batchStart = 0; batchStart < hunkCount; batchStart += batchSize) {
+		uint32_t batchCount = std::min(batchSize, hunkCount - batchStart);
+
+		//Read the batch's data (the files are read sequentially on this thread)
+		for(uint32_t i = 0; i < batchCount; i++) {
+			uint64_t pos = (uint64_t)(batchStart + i) * CompressedDiscImage::HunkSize;
+			uint32_t remaining = (uint32_t)std::min<uint64_t>(CompressedDiscImage::HunkSize, imageSize - pos);
+			rawHunks[i].clear();
+			while(remaining > 0) {
+				while(pos >= fileStart[fileIndex] + disc.Files[fileIndex].GetSize()) {
+					fileIndex++;
+				}
+				uint64_t fileOffset = pos - fileStart[fileIndex];
+				uint32_t count = (uint32_t)std::min<uint64_t>(remaining, disc.Files[fileIndex].GetSize() - fileOffset);
+				if(!disc.Files[fileIndex].ReadChunk(rawHunks[i], (uint32_t)fileOffset, count)) {
+					MessageManager::Log("[DCZ] Could not read " + disc.Files[fileIndex].GetFileName());
+					return false;
+				}
+				pos += count;
+				remaining -= count;
+			}
+		}
+
+		vector<thread> threads;
+		for(uint32_t t = 0; t < threadCount; t++) {
+			threads.push_back(std::thread([&, t]() {
+				for(uint32_t i = t; i < batchCount; i += threadCount) {
+					vector<uint8_t>& src = rawHunks[i];
+					vector<uint8_t>& dst = compressedHunks[i];
+					unsigned long compressedSize = compressBound((unsigned long)src.size());
+					dst.resize(compressedSize);
+					if(compress2(dst.data(), &compressedSize, src.data(), (unsigned long)src.size(), MZ_BEST_COMPRESSION) != MZ_OK || compressedSize >= src.size()) {
+						//Store the hunk as is when it can't be compressed
+						dst = src;
+					} else {
+						dst.resize(compressedSize);
+					}
+				}
+			}));
+		}
+		for(thread& t : threads) {
+			t.join();
+		}
+
+		for(uint32_t i = 0; i < batchCount; i++) {
+			hunkOffsets[batchStart + i] = currentOffset;
+			out.write((char*)compressedHunks[i].data(), compressedHunks[i].size());
+			currentOffset += compressedHunks[i].size();
+		}
+	}
+	hunkOffsets[hunkCount] = currentOffset;
+
+	out.seekp(hunkTablePos, std::ios::beg);
+	out.write((char*)hunkOffsets.data(), hunkOffsets.size() * sizeof(uint64_t));
+	return out.good();
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "pch.h"
+#include "Utilities/MemoryMappedFile.h"
+#include "Utilities/SimpleLock.h"
+
+class VirtualFile;
+struct DiscInfo;
+
+//Disc image made of individually deflated hunks of sectors, with an offset index to allow random access
+//Layout: header, track list, hunk offset table (HunkCount + 1 entries), hunk data
+class CompressedDiscImage
+{
+private:
+	static constexpr uint32_t FileVersion = 1;
+	static constexpr uint32_t HunkSectors = 16;
+	static constexpr uint32_t HunkSize = HunkSectors * 2352;
+	static constexpr int MaxCachedHunks = 16;
+
+	struct CachedHunk
+	{
+		int64_t Hunk = -1;
+		uint64_t LastUse = 0;
+		vector<uint8_t> Data;
+	};
+
+	MemoryMappedFile _mappedFile;
+	vector<uint8_t> _fileData;
+	const uint8_t* _data = nullptr;
+	size_t _size = 0;
+
+	uint64_t _imageSize = 0;
+	uint32_t _hunkSize = 0;
+	vector<uint64_t> _hunkOffsets;
+
+	CachedHunk _cache[MaxCachedHunks];
+	uint64_t _useCounter = 0;
+	SimpleLock _lock;
+
+	CachedHunk* GetHunk(uint32_t hunk);
+	static bool WriteImage(DiscInfo& disc, ofstream& out);
+
+public:
+	static constexpr const char* Extension = ".dcz";
+
+	bool Load(VirtualFile& file, DiscInfo& disc);
+
+	//Copies [length] bytes of the uncompressed image (all of the disc's data files, one after the other)
+	bool Read(uint32_t offset, uint32_t length, uint8_t* out);
+
+	static bool Create(DiscInfo& disc, string outFile);
+};
@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "Shared/DiscSectorCache.h"
+#include "Shared/CdReader.h"
+
+DiscSectorCache::DiscSectorCache(DiscInfo& disc)
+{
+	_disc = &disc;
+	_ring.resize(DiscSectorCache::RingSize);
+
+	_stopThread = false;
+	_thread = std::thread([=]() {
+		PrefetchThread();
+	});
+}
+
+DiscSectorCache::~DiscSectorCache()
+{
+	_stopThread = true;
+	_prefetchSignal.Signal();
+	_thread.join();
+}
+
+void DiscSectorCache::ReadFromDisc(uint32_t sector, CachedSector& out)
+{
+	constexpr int Mode1_2352_SectorHeaderSize = 16;
+
+	out.Sector = sector;
+	out.Size = 0;
+	out.HeaderSize = 0;
+	out.Track = _disc->GetTrack(sector);
+	if(out.Track < 0) {
+		return;
+	}
+
+	TrackInfo& trk = _disc->Tracks[out.Track];
+	uint32_t sectorSize = trk.GetSectorSize();
+	uint32_t byteOffset = trk.FileOffset + (sector - trk.FirstSector) * sectorSize;
+
+	auto lock = _fileLock.AcquireSafe();
+	_readBuffer.clear();
+	if(_disc->ReadFileData(trk.FileIndex, byteOffset, sectorSize, _readBuffer)) {
+		memcpy(out.Data, _readBuffer.data(), sectorSize);
+		out.Size = sectorSize;
+		out.HeaderSize = trk.Format == TrackFormat::Mode1_2352 ? Mode1_2352_SectorHeaderSize : 0;
+	}
+}
+
+DiscSectorCache::CachedSector& DiscSectorCache::GetSector(uint32_t sector)
+{
+	CachedSector& slot = _ring[sector % DiscSectorCache::RingSize];
+	if(slot.Sector == sector) {
+		_stats.Hits++;
+	} else {
+		_stats.Misses++;
+		ReadFromDisc(sector, slot);
+	}
+	return slot;
+}
+
+void DiscSectorCache::Prefetch(uint32_t sector, uint32_t sectorCount)
+{
+	{
+		auto lock = _ringLock.AcquireSafe();
+		uint32_t endSector = sector + std::min<uint32_t>(sectorCount, DiscSectorCache::ReadAheadSectors);
+		if(sector >= _prefetchStartSector && sector <= _prefetchEndSector) {
+			//Sequential read, extend the current read-ahead window
+			_nextPrefetchSector = std::max(_nextPrefetchSector, sector);
+			_prefetchEndSector = std::max(_prefetchEndSector, endSector);
+		} else {
+			//Seek, restart the read-ahead from the new position
+			_prefetchStartSector = sector;
+			_nextPrefetchSector = sector;
+			_prefetchEndSector = endSector;
+		}
+	}
+	_prefetchSignal.Signal();
+}
+
+void DiscSectorCache::ReadDataSector(uint32_t sector, deque<uint8_t>& outData)
+{
+	{
+		auto lock = _ringLock.AcquireSafe();
+		CachedSector& slot = GetSector(sector);
+		if(slot.Track < 0) {
+			//TODO support reading pregap when it's available
+			LogDebug("Invalid sector/track (or inside pregap)");
+			outData.insert(outData.end(), 2048, 0);
+		} else if(slot.Size >= slot.HeaderSize + 2048) {
+			outData.insert(outData.end(), slot.Data + slot.HeaderSize, slot.Data + slot.HeaderSize + 2048);
+		} else {
+			LogDebug("Invalid read offsets");
+		}
+	}
+
+	Prefetch(sector + 1);
+}
+
+void DiscSectorCache::ReadAudioSector(uint32_t sector, int16_t outSamples[588 * 2])
+{
+	{
+		auto lock = _ringLock.AcquireSafe();
+		CachedSector& slot = GetSector(sector);
+		for(uint32_t i = 0; i < 588 * 2; i++) {
+			uint32_t offset = i * 2;
+			outSamples[i] = offset + 1 < slot.Size ? (int16_t)(slot.Data[offset] | (slot.Data[offset + 1] << 8)) : 0;
+		}
+	}
+
+	Prefetch(sector + 1);
+}
+
+void DiscSectorCache::PrefetchThread()
+{
+	CachedSector sectorData;
+	while(!_stopThread) {
+		_prefetchSignal.Wait();
+
+		while(!_stopThread) {
+			uint32_t sector;
+			{
+				auto lock = _ringLock.AcquireSafe();
+				if(_nextPrefetchSector >= _prefetchEndSector) {
+					break;
+				}
+				sector = _nextPrefetchSector++;
+				if(_ring[sector % DiscSectorCache::RingSize].Sector == sector) {
+					continue;
+				}
+			}
+
+			//Read the sector without holding the ring lock, to avoid blocking the emulation thread
+			ReadFromDisc(sector, sectorData);
+
+			auto lock = _ringLock.AcquireSafe();
+			_ring[sector % DiscSectorCache::RingSize] = sectorData;
+			_stats.PrefetchedSectors++;
+		}
+	}
+}
+
+DiscSectorCacheStats DiscSectorCache::GetStats()
+{
+	auto lock = _ringLock.AcquireSafe();
+	return _stats;
+}
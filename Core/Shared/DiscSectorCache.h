@@ -0,0 +1,68 @@
+#pragma once
+#include "pch.h"
+#include "Utilities/AutoResetEvent.h"
+#include "Utilities/SimpleLock.h"
+
+struct DiscInfo;
+
+struct DiscSectorCacheStats
+{
+	uint64_t Hits;
+	uint64_t Misses;
+	uint64_t PrefetchedSectors;
+};
+
+class DiscSectorCache
+{
+private:
+	static constexpr int RingSize = 128;
+	static constexpr int ReadAheadSectors = 48;
+	static constexpr int MaxSectorSize = 2352;
+
+	struct CachedSector
+	{
+		int64_t Sector = -1;
+		int32_t Track = -1;
+		uint32_t Size = 0;
+		uint32_t HeaderSize = 0;
+		uint8_t Data[MaxSectorSize];
+	};
+
+	DiscInfo* _disc = nullptr;
+
+	//Sectors are stored in the slot matching their sector number (modulo the ring size)
+	vector<CachedSector> _ring;
+	SimpleLock _ringLock;
+
+	//VirtualFile instances are not thread-safe, all disc reads go through this lock
+	SimpleLock _fileLock;
+	vector<uint8_t> _readBuffer;
+
+	thread _thread;
+	AutoResetEvent _prefetchSignal;
+	atomic<bool> _stopThread;
+	uint32_t _prefetchStartSector = 0;
+	uint32_t _nextPrefetchSector = 0;
+	uint32_t _prefetchEndSector = 0;
+
+	//Updated under _ringLock
+	DiscSectorCacheStats _stats = {};
+
+	void ReadFromDisc(uint32_t sector, CachedSector& out);
+	CachedSector& GetSector(uint32_t sector);
+	void PrefetchThread();
+
+public:
+	DiscSectorCache(DiscInfo& disc);
+	~DiscSectorCache();
+
+	//Queues the sectors that follow the specified sector to be read in the background
+	void Prefetch(uint32_t sector, uint32_t sectorCount = DiscSectorCache::ReadAheadSectors);
+
+	void ReadDataSector(uint32_t sector, deque<uint8_t>& outData);
+
+	//Copies the sector's 588 stereo samples (or 0s if the sector can't be read)
+	void ReadAudioSector(uint32_t sector, int16_t outSamples[588 * 2]);
+
+	DiscSectorCacheStats GetStats();
+};
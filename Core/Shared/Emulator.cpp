@@ -6,6 +6,7 @@
 #include "Shared/Audio/AudioPlayerHud.h"
 #include "Shared/Video/VideoDecoder.h"
 #include "Shared/Video/VideoRenderer.h"
+#include "Shared/Video/VideoFilterThreadPool.h"
 #include "Shared/Video/DebugHud.h"
 #include "Shared/FrameLimiter.h"
 #include "Shared/MessageManager.h"
@@ -24,6 +25,7 @@
 #include "Shared/Movies/MovieManager.h"
 #include "Shared/TimingInfo.h"
 #include "Shared/HistoryViewer.h"
+#include "Shared/RomIndex.h"
 #include "Netplay/GameServer.h"
 #include "Netplay/GameClient.h"
 #include "Shared/Interfaces/IConsole.h"
@@ -55,6 +57,7 @@ Emulator::Emulator() :
 	_notificationManager(new NotificationManager()),
 	_batteryManager(new BatteryManager()),
 	_soundMixer(new SoundMixer(this)),
+	_videoFilterThreadPool(new VideoFilterThreadPool()),
 	_videoRenderer(new VideoRenderer(this)),
 	_videoDecoder(new VideoDecoder(this)),
 	_saveStateManager(new SaveStateManager(this)),
@@ -63,7 +66,8 @@ Emulator::Emulator() :
 	_historyViewer(new HistoryViewer(this)),
 	_gameServer(new GameServer(this)),
 	_gameClient(new GameClient(this)),
-	_rewindManager(new RewindManager(this))
+	_rewindManager(new RewindManager(this)),
+	_romIndex(new RomIndex())
 {
 	_paused = false;
 	_pauseOnNextFrame = false;
@@ -75,6 +79,7 @@ Emulator::Emulator() :
 	_debugRequestCount = 0;
 	_blockDebuggerRequestCount = 0;
 
+	_frameLimiter.reset(new FrameLimiter(0));
 	_videoDecoder->Init();
 }
 
@@ -103,6 +108,7 @@ void Emulator::Release()
 
 	_videoDecoder->StopThread();
 	_videoRenderer->StopThread();
+	_romIndex->StopScan();
 	_shortcutKeyHandler.reset();
 }
 
@@ -128,21 +134,26 @@ void Emulator::Run()
 
 	_frameDelay = GetFrameDelay();
 	_stats.reset(new DebugStats());
-	_frameLimiter.reset(new FrameLimiter(_frameDelay));
+	_frameLimiter->Reset(_frameDelay);
 	_lastFrameTimer.Reset();
 
 	while(!_stopFlag) {
-		bool useRunAhead = _settings->GetEmulationConfig().RunAheadFrames > 0 && !_debugger && !_audioPlayerHud && !_rewindManager->IsRewinding() && _settings->GetEmulationSpeed() > 0 && _settings->GetEmulationSpeed() <= 100;
-		if(useRunAhead) {
-			RunFrameWithRunAhead();
-		} else {
-			_console->RunFrame();
-			_rewindManager->ProcessEndOfFrame();
-			_historyViewer->ProcessEndOfFrame();
-			ProcessSystemActions();
+		if(!_movieManager->ProcessPendingSeek()) {
+			bool useRunAhead = _settings->GetEmulationConfig().RunAheadFrames > 0 && !_debugger && !_audioPlayerHud && !_rewindManager->IsRewinding() && _settings->GetEmulationSpeed() > 0 && _settings->GetEmulationSpeed() <= 100;
+			if(useRunAhead) {
+				RunFrameWithRunAhead();
+			} else {
+				_console->RunFrame();
+				_rewindManager->ProcessEndOfFrame();
+				_historyViewer->ProcessEndOfFrame();
+				ProcessSystemActions();
+			}
+
+			_movieManager->ProcessEndOfFrame();
+			ProcessAutoSaveState();
 		}
 
-		ProcessAutoSaveState();
+		_saveStateManager->ProcessSavedStates();
 
 		WaitForLock();
 
@@ -231,6 +242,34 @@ void Emulator::RunFrameWithRunAhead()
 	}
 }
 
+bool Emulator::ShouldSkipRender(bool allowFrameSkip)
+{
+	if(_isRunAheadFrame) {
+		return true;
+	}
+
+	//When running faster than normal, only render about 1 frame every 10ms
+	bool skipRender = (
+		allowFrameSkip &&
+		!_rewindManager->IsRewinding() &&
+		!_videoRenderer->IsRecording() &&
+		(_settings->GetEmulationSpeed() == 0 || _settings->GetEmulationSpeed() > 150) &&
+		_frameSkipTimer.GetElapsedMS() < 10
+	);
+
+	if(!skipRender) {
+		_frameSkipTimer.Reset();
+	}
+	return skipRender;
+}
+
+void Emulator::RunFrame(bool withOutput)
+{
+	_isRunAheadFrame = !withOutput;
+	_console->RunFrame();
+	_isRunAheadFrame = false;
+}
+
 void Emulator::OnBeforeSendFrame()
 {
 	if(!_isRunAheadFrame) {
@@ -249,6 +288,7 @@ void Emulator::OnBeforeSendFrame()
 void Emulator::ProcessEndOfFrame()
 {
 	if(!_isRunAheadFrame) {
+		_frameLimiter->SetLowLatencyMode(_settings->GetEmulationConfig().LowLatencyFramePacing, _settings->GetVideoConfig().VerticalSync);
 		_frameLimiter->ProcessFrame();
 		while(_frameLimiter->WaitForNextFrame()) {
 			if(_stopFlag || _frameDelay != GetFrameDelay() || _paused || _pauseOnNextFrame || _lockCounter > 0) {
@@ -268,6 +308,21 @@ void Emulator::ProcessEndOfFrame()
 	_frameRunning = false;
 }
 
+FramePacingStats Emulator::GetFramePacingStats()
+{
+	return _frameLimiter->GetStats();
+}
+
+double Emulator::GetFrameInputTimestamp()
+{
+	return _frameLimiter->GetFrameStartTime();
+}
+
+void Emulator::ProcessFramePresented(double inputTimestamp, double renderTime)
+{
+	_frameLimiter->ProcessFramePresented(inputTimestamp, renderTime);
+}
+
 void Emulator::Stop(bool sendNotification, bool preventRecentGameSave, bool saveBattery)
 {
 	BlockDebuggerRequests();
@@ -805,8 +860,8 @@ void Emulator::WaitForPauseEnd()
 		//Sleep until emulation is resumed
 		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(30));
 
-		if(_systemActionManager->IsResetPending()) {
-			//Reset/power cycle was pressed, stop waiting and process it now
+		if(_systemActionManager->IsResetPending() || _movieManager->IsSeekPending()) {
+			//Reset/power cycle was pressed or a movie seek was requested, stop waiting and process it now
 			break;
 		}
 	}
@@ -991,7 +1046,7 @@ void Emulator::BlockDebuggerRequests()
 
 DebuggerRequest Emulator::GetDebugger(bool autoInit)
 {
-	if(IsRunning() && _blockDebuggerRequestCount == 0) {
+	if(Emulator::DebuggerSupported && IsRunning() && _blockDebuggerRequestCount == 0) {
 		auto lock = _debuggerLock.AcquireSafe();
 		if(IsRunning() && _blockDebuggerRequestCount == 0) {
 			if(!_debugger && autoInit) {
@@ -1012,16 +1067,23 @@ void Emulator::ResetDebugger(bool startDebugger)
 
 	if(_emulationThreadId == std::this_thread::get_id()) {
 		_debugger.reset(startDebugger ? new Debugger(this, _console.get()) : nullptr);
+		UpdateMemoryHooks();
 	} else {
 		//Need to pause emulator to change _debugger (when not called from the emulation thread)
 		auto emuLock = AcquireLock();
 		_debugger.reset(startDebugger ? new Debugger(this, _console.get()) : nullptr);
+		UpdateMemoryHooks();
 	}
 }
 
+void Emulator::UpdateMemoryHooks()
+{
+	_memoryHooksEnabled = IsDebugging() || _cheatManager->HasAddressCheats();
+}
+
 void Emulator::InitDebugger()
 {
-	if(!_debugger) {
+	if(Emulator::DebuggerSupported && !_debugger) {
 		//Lock to make sure we don't try to start debuggers in 2 separate threads at once
 		auto lock = _debuggerLock.AcquireSafe();
 		if(!_debugger) {
@@ -16,6 +16,7 @@ class DebugHud;
 class SoundMixer;
 class VideoRenderer;
 class VideoDecoder;
+class VideoFilterThreadPool;
 class NotificationManager;
 class EmuSettings;
 class SaveStateManager;
@@ -24,6 +25,7 @@ class BatteryManager;
 class CheatManager;
 class MovieManager;
 class HistoryViewer;
+class RomIndex;
 class FrameLimiter;
 class DebugStats;
 class BaseControlManager;
@@ -40,6 +42,7 @@ class IInputProvider;
 
 struct RomInfo;
 struct TimingInfo;
+struct FramePacingStats;
 
 enum class MemoryOperationType;
 enum class MemoryType;
@@ -75,6 +78,7 @@ private:
 	const unique_ptr<NotificationManager> _notificationManager;
 	const unique_ptr<BatteryManager> _batteryManager;
 	const unique_ptr<SoundMixer> _soundMixer;
+	const unique_ptr<VideoFilterThreadPool> _videoFilterThreadPool;
 	const unique_ptr<VideoRenderer> _videoRenderer;
 	const unique_ptr<VideoDecoder> _videoDecoder;
 	const unique_ptr<SaveStateManager> _saveStateManager;
@@ -85,6 +89,7 @@ private:
 	const shared_ptr<GameServer> _gameServer;
 	const shared_ptr<GameClient> _gameClient;
 	const shared_ptr<RewindManager> _rewindManager;
+	const unique_ptr<RomIndex> _romIndex;
 
 	thread::id _emulationThreadId;
 
@@ -98,6 +103,9 @@ private:
 	atomic<bool> _pauseOnNextFrame;
 	atomic<bool> _threadPaused;
 
+	//Set while a debugger (and its scripts) is attached or cheats are active, see HasMemoryHooks()
+	bool _memoryHooksEnabled = false;
+
 	atomic<int> _debugRequestCount;
 	atomic<int> _blockDebuggerRequestCount;
 
@@ -112,6 +120,7 @@ private:
 	unique_ptr<DebugStats> _stats;
 	unique_ptr<FrameLimiter> _frameLimiter;
 	Timer _lastFrameTimer;
+	Timer _frameSkipTimer;
 	double _frameDelay = 0;
 	
 	uint32_t _autoSaveStateFrameCounter = 0;
@@ -185,6 +194,7 @@ public:
 	SoundMixer* GetSoundMixer() { return _soundMixer.get(); }
 	VideoRenderer* GetVideoRenderer() { return _videoRenderer.get(); }
 	VideoDecoder* GetVideoDecoder() { return _videoDecoder.get(); }
+	VideoFilterThreadPool* GetVideoFilterThreadPool() { return _videoFilterThreadPool.get(); }
 	ShortcutKeyHandler* GetShortcutKeyHandler() { return _shortcutKeyHandler.get(); }
 	NotificationManager* GetNotificationManager() { return _notificationManager.get(); }
 	EmuSettings* GetSettings() { return _settings.get(); }
@@ -195,6 +205,7 @@ public:
 	BatteryManager* GetBatteryManager() { return _batteryManager.get(); }
 	CheatManager* GetCheatManager() { return _cheatManager.get(); }
 	MovieManager* GetMovieManager() { return _movieManager.get(); }
+	RomIndex* GetRomIndex() { return _romIndex.get(); }
 	HistoryViewer* GetHistoryViewer() { return _historyViewer.get(); }
 	GameServer* GetGameServer() { return _gameServer.get(); }
 	GameClient* GetGameClient() { return _gameClient.get(); }
@@ -208,12 +219,24 @@ public:
 	ShortcutState IsShortcutAllowed(EmulatorShortcut shortcut, uint32_t shortcutParam);
 	bool IsKeyboardConnected();
 
+#ifdef MESEN_DISABLE_DEBUGGER
+	static constexpr bool DebuggerSupported = false;
+#else
+	static constexpr bool DebuggerSupported = true;
+#endif
+
 	void InitDebugger();
 	void StopDebugger();
 	DebuggerRequest GetDebugger(bool autoInit = false);
-	bool IsDebugging() { return !!_debugger; }
+	//Always false when the debugger is compiled out (MESEN_DISABLE_DEBUGGER), which removes the debugger hooks from all cores
+	__forceinline bool IsDebugging() { return Emulator::DebuggerSupported && !!_debugger; }
 	Debugger* InternalGetDebugger() { return _debugger.get(); }
 
+	//The memory managers switch between their instrumented read/write paths (cheats + debugger hooks) and their hook-free
+	//paths based on this flag, which is refreshed when the debugger is attached/detached and when cheats change
+	__forceinline bool HasMemoryHooks() { return _memoryHooksEnabled; }
+	void UpdateMemoryHooks();
+
 	thread::id GetEmulationThreadId() { return _emulationThreadId; }
 	bool IsEmulationThread();
 
@@ -230,6 +253,13 @@ public:
 	bool IsRunning() { return _console != nullptr; }
 	bool IsRunAheadFrame() { return _isRunAheadFrame; }
 
+	//Called by the PPUs at the start of each frame - returns true when the frame will not be displayed
+	//(run ahead frames, or frames skipped while fast forwarding), in which case rendering can be skipped
+	bool ShouldSkipRender(bool allowFrameSkip);
+
+	//Runs a single frame, with or without audio/video output (must be called on the emulation thread)
+	void RunFrame(bool withOutput);
+
 	TimingInfo GetTimingInfo(CpuType cpuType);
 	uint32_t GetFrameCount();
 
@@ -242,24 +272,27 @@ public:
 	void UnregisterInputProvider(IInputProvider* provider);
 
 	double GetFps();
+	FramePacingStats GetFramePacingStats();
+	double GetFrameInputTimestamp();
+	void ProcessFramePresented(double inputTimestamp, double renderTime);
 	
 	template<CpuType type> __forceinline void ProcessInstruction()
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessInstruction<type>();
 		}
 	}
 
 	template<CpuType type, MemoryAccessFlags flags = MemoryAccessFlags::None, typename T> __forceinline void ProcessMemoryRead(uint32_t addr, T& value, MemoryOperationType opType)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessMemoryRead<type, flags>(addr, value, opType);
 		}
 	}
 
 	template<CpuType type, MemoryAccessFlags flags = MemoryAccessFlags::None, typename T> __forceinline bool ProcessMemoryWrite(uint32_t addr, T& value, MemoryOperationType opType)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			return _debugger->ProcessMemoryWrite<type, flags>(addr, value, opType);
 		}
 		return true;
@@ -267,49 +300,49 @@ public:
 
 	template<CpuType cpuType, MemoryType memType, MemoryOperationType opType> __forceinline void ProcessMemoryAccess(uint32_t addr, uint8_t value)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessMemoryAccess<cpuType, memType, opType>(addr, value);
 		}
 	}
 
 	template<CpuType type> __forceinline void ProcessIdleCycle()
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessIdleCycle<type>();
 		}
 	}
 
 	template<CpuType type> __forceinline void ProcessHaltedCpu()
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessHaltedCpu<type>();
 		}
 	}
 
 	template<CpuType type, typename T> __forceinline void ProcessPpuRead(uint32_t addr, T& value, MemoryType memoryType, MemoryOperationType opType = MemoryOperationType::Read)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessPpuRead<type>(addr, value, memoryType, opType);
 		}
 	}
 
 	template<CpuType type, typename T> __forceinline void ProcessPpuWrite(uint32_t addr, T& value, MemoryType memoryType)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessPpuWrite<type>(addr, value, memoryType);
 		}
 	}
 
 	template<CpuType type> __forceinline void ProcessPpuCycle()
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessPpuCycle<type>();
 		}
 	}
 
 	__forceinline void DebugLog(string log)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->Log(log);
 		}
 	}
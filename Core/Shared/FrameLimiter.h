@@ -1,19 +1,156 @@
 #pragma once
+#include "pch.h"
 #include "Utilities/Timer.h"
+#include "Utilities/SimpleLock.h"
+
+struct FramePacingStats
+{
+	//Buckets: < 0.1ms, < 0.25ms, < 0.5ms, < 1ms, < 2ms, >= 2ms
+	static constexpr int BucketCount = 6;
+
+	uint32_t WakeUpError[BucketCount];
+	uint32_t DeadlineMisses[BucketCount];
+	uint32_t FrameCount;
+
+	//Average time left between the end of a frame and its deadline, in ms (negative when frames end late)
+	double DeadlineSlack;
+
+	//Time between the input poll for a frame and the end of its presentation by the renderer, in ms
+	//(when vsync is enabled, the presentation ends when the frame is shown on the screen)
+	uint32_t PresentedFrameCount;
+	double InputLatency;
+	double MinInputLatency;
+	double MaxInputLatency;
+};
 
 class FrameLimiter
 {
 private:
+	static constexpr int FrameCostHistorySize = 16;
+	static constexpr int PendingFrameCount = 4;
+	static constexpr double LowLatencyMargin = 1.0;
+	static constexpr double SpinThreshold = 0.25;
+
+	struct PendingFrame
+	{
+		double InputTime;
+		double EndTime;
+	};
+
+	//Never reset, all timestamps (including the ones from the render thread) use this clock
 	Timer _clockTimer;
 	double _targetTime;
 	double _delay;
 	bool _resetRunTimers;
 
+	//Time at which the current frame started (and polled its input)
+	double _frameStartTime = 0;
+
+	//Low latency mode (only used with vsync) - the start of each frame (and input polling) is delayed so that the frame is
+	//ready to be presented right before the next vertical blank, based on the time at which the previous frames were presented
+	bool _lowLatency = false;
+	bool _vsync = false;
+	double _frameDeadline = 0;
+	double _frameCosts[FrameCostHistorySize] = {};
+	uint32_t _frameCostIndex = 0;
+	double _sleepOvershoot = 1.0;
+
+	//Updated by the render thread when a frame is presented
+	SimpleLock _presentLock;
+	PendingFrame _pendingFrames[PendingFrameCount] = {};
+	uint32_t _pendingFrameIndex = 0;
+	double _lastPresentTime = 0;
+	double _presentCosts[FrameCostHistorySize] = {};
+	uint32_t _presentCostIndex = 0;
+
+	SimpleLock _statsLock;
+	FramePacingStats _stats = {};
+
+	static int GetBucket(double lateness)
+	{
+		if(lateness < 0.1) {
+			return 0;
+		} else if(lateness < 0.25) {
+			return 1;
+		} else if(lateness < 0.5) {
+			return 2;
+		} else if(lateness < 1) {
+			return 3;
+		} else if(lateness < 2) {
+			return 4;
+		}
+		return 5;
+	}
+
+	static double GetMax(double (&values)[FrameCostHistorySize])
+	{
+		double result = 0;
+		for(int i = 0; i < FrameCostHistorySize; i++) {
+			result = std::max(result, values[i]);
+		}
+		return result;
+	}
+
+	//Returns the time at which the current frame must be ready to be shown at the next vertical blank, or 0 if unknown
+	double GetPresentDeadline(double frameCost)
+	{
+		auto lock = _presentLock.AcquireSafe();
+		if(_lastPresentTime <= 0 || _targetTime - _lastPresentTime > 1000) {
+			return 0;
+		}
+
+		//Vertical blanks occur every frame after the last present (the refresh rate matches the frame rate with vsync)
+		//Use the first one that can be reached when the frame starts on schedule
+		double presentCost = GetMax(_presentCosts) + LowLatencyMargin;
+		double earliestPresent = _targetTime + frameCost + presentCost;
+		double vblank = _lastPresentTime + std::ceil((earliestPresent - _lastPresentTime) / _delay) * _delay;
+		return vblank - presentCost;
+	}
+
+	double GetWaitTarget()
+	{
+		if(!_lowLatency) {
+			return _targetTime;
+		}
+
+		//Use the slowest recent frame as the expected cost of the next one
+		double frameCost = GetMax(_frameCosts);
+		double deadline = _vsync ? GetPresentDeadline(frameCost) : 0;
+		if(deadline <= 0) {
+			//Without vsync, frames are presented as soon as they are done, delaying them would only shift them
+			_frameDeadline = _targetTime + _delay;
+			return _targetTime;
+		}
+
+		_frameDeadline = deadline;
+		return std::max(_targetTime, deadline - frameCost - LowLatencyMargin);
+	}
+
+	void PreciseWaitUntil(double target)
+	{
+		//Sleep while the remaining time is longer than the usual amount of oversleep, then spin until the target
+		double remaining;
+		while((remaining = target - _clockTimer.GetElapsedMS()) > _sleepOvershoot + SpinThreshold) {
+			int sleepTime = std::max(1, (int)(remaining - _sleepOvershoot));
+			double start = _clockTimer.GetElapsedMS();
+			std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(sleepTime));
+
+			//Calibrate the oversleep estimate (quickly increase it, slowly decrease it)
+			double overshoot = std::max(0.0, _clockTimer.GetElapsedMS() - start - sleepTime);
+			_sleepOvershoot = overshoot > _sleepOvershoot ? overshoot : (_sleepOvershoot * 0.95 + overshoot * 0.05);
+			_sleepOvershoot = std::min(4.0, std::max(0.1, _sleepOvershoot));
+		}
+
+		while(_clockTimer.GetElapsedMS() < target) {
+			std::this_thread::yield();
+		}
+	}
+
 public:
 	FrameLimiter(double delay)
 	{
 		_delay = delay;
-		_targetTime = _delay;
+		_targetTime = _clockTimer.GetElapsedMS() + _delay;
 		_resetRunTimers = false;
 	}
 
@@ -23,16 +160,67 @@ public:
 		_resetRunTimers = true;
 	}
 
+	//Called when the emulation starts, the limiter is kept for the emulator's lifetime because the render thread uses it
+	void Reset(double delay)
+	{
+		SetDelay(delay);
+		_frameStartTime = 0;
+		_frameDeadline = 0;
+		memset(_frameCosts, 0, sizeof(_frameCosts));
+		{
+			auto lock = _presentLock.AcquireSafe();
+			memset(_pendingFrames, 0, sizeof(_pendingFrames));
+			memset(_presentCosts, 0, sizeof(_presentCosts));
+			_lastPresentTime = 0;
+		}
+		auto lock = _statsLock.AcquireSafe();
+		_stats = {};
+	}
+
+	void SetLowLatencyMode(bool enabled, bool vsync)
+	{
+		if(_lowLatency && !enabled) {
+			//Clear the pacing stats, they only apply to the low latency mode
+			auto lock = _statsLock.AcquireSafe();
+			memset(_stats.WakeUpError, 0, sizeof(_stats.WakeUpError));
+			memset(_stats.DeadlineMisses, 0, sizeof(_stats.DeadlineMisses));
+			_stats.FrameCount = 0;
+			_stats.DeadlineSlack = 0;
+			_frameDeadline = 0;
+		}
+		_lowLatency = enabled;
+		_vsync = vsync;
+	}
+
 	void ProcessFrame()
 	{
-		if(_resetRunTimers || (_clockTimer.GetElapsedMS() - _targetTime) > 100) {
+		double now = _clockTimer.GetElapsedMS();
+		if(_frameStartTime > 0) {
+			auto lock = _presentLock.AcquireSafe();
+			_pendingFrames[_pendingFrameIndex] = { _frameStartTime, now };
+			_pendingFrameIndex = (_pendingFrameIndex + 1) % PendingFrameCount;
+		}
+
+		if(_lowLatency && _frameDeadline > 0) {
+			_frameCosts[_frameCostIndex] = std::min(_delay, now - _frameStartTime);
+			_frameCostIndex = (_frameCostIndex + 1) % FrameCostHistorySize;
+
+			auto lock = _statsLock.AcquireSafe();
+			double slack = _frameDeadline - now;
+			_stats.DeadlineSlack = _stats.FrameCount <= 1 ? slack : (_stats.DeadlineSlack * 0.95 + slack * 0.05);
+			if(now > _frameDeadline) {
+				_stats.DeadlineMisses[GetBucket(now - _frameDeadline)]++;
+			}
+			_frameDeadline = 0;
+		}
+
+		if(_resetRunTimers || (now - _targetTime) > 100) {
 			//Reset the timers, this can happen in 3 scenarios:
 			//1) Target frame rate changed
 			//2) The console was reset/power cycled or the emulation was paused (with or without the debugger)
 			//3) As a satefy net, if we overshoot our target by over 100 milliseconds, the timer is reset, too.
 			//   This can happen when something slows the emulator down severely (or when breaking execution in VS when debugging Mesen itself, etc.)
-			_clockTimer.Reset();
-			_targetTime = 0;
+			_targetTime = now;
 			_resetRunTimers = false;
 		}
 
@@ -41,13 +229,66 @@ public:
 
 	bool WaitForNextFrame()
 	{
-		if(_targetTime - _clockTimer.GetElapsedMS() > 50) {
+		double waitTarget = GetWaitTarget();
+		if(waitTarget - _clockTimer.GetElapsedMS() > 50) {
 			//When sleeping for a long time (e.g <= 25% speed), sleep in small chunks and check to see if we need to stop sleeping between each sleep call
 			_clockTimer.WaitUntil(_clockTimer.GetElapsedMS() + 40);
 			return true;
 		}
 
-		_clockTimer.WaitUntil(_targetTime);
+		if(_lowLatency) {
+			PreciseWaitUntil(waitTarget);
+			_frameStartTime = _clockTimer.GetElapsedMS();
+
+			auto lock = _statsLock.AcquireSafe();
+			_stats.WakeUpError[GetBucket(std::max(0.0, _frameStartTime - waitTarget))]++;
+			_stats.FrameCount++;
+		} else {
+			_clockTimer.WaitUntil(_targetTime);
+			_frameStartTime = _clockTimer.GetElapsedMS();
+		}
 		return false;
 	}
-};
\ No newline at end of file
+
+	//Timestamp of the input poll for the frame that is currently running, sent along with the frame to the renderer
+	double GetFrameStartTime()
+	{
+		return _frameStartTime;
+	}
+
+	//Called by the render thread once it's done presenting the frame whose input was polled at [inputTime]
+	//[renderTime] is the time spent in the renderer (with vsync, this includes the wait for the vertical blank)
+	void ProcessFramePresented(double inputTime, double renderTime)
+	{
+		double now = _clockTimer.GetElapsedMS();
+		{
+			auto lock = _presentLock.AcquireSafe();
+			for(PendingFrame& frame : _pendingFrames) {
+				if(frame.InputTime == inputTime) {
+					//Time needed to decode the frame and start rendering it (excludes the wait for the vertical blank)
+					_presentCosts[_presentCostIndex] = std::clamp(now - renderTime - frame.EndTime, 0.0, _delay);
+					_presentCostIndex = (_presentCostIndex + 1) % FrameCostHistorySize;
+					break;
+				}
+			}
+			_lastPresentTime = now;
+		}
+
+		auto lock = _statsLock.AcquireSafe();
+		double latency = now - inputTime;
+		if(_stats.PresentedFrameCount == 0) {
+			_stats.InputLatency = _stats.MinInputLatency = _stats.MaxInputLatency = latency;
+		} else {
+			_stats.InputLatency = _stats.InputLatency * 0.95 + latency * 0.05;
+			_stats.MinInputLatency = std::min(_stats.MinInputLatency, latency);
+			_stats.MaxInputLatency = std::max(_stats.MaxInputLatency, latency);
+		}
+		_stats.PresentedFrameCount++;
+	}
+
+	FramePacingStats GetStats()
+	{
+		auto lock = _statsLock.AcquireSafe();
+		return _stats;
+	}
+};
@@ -177,7 +177,7 @@ bool HistoryViewer::SetInput(BaseControlDevice *device)
 {
 	uint8_t port = device->GetPort();
 	if(_position < _history.size()) {
-		std::deque<ControlDeviceState> &stateData = _history[_position].InputLogs[port];
+		const std::deque<ControlDeviceState> &stateData = _history[_position].GetInputLog(port);
 		if(_pollCounter < stateData.size()) {
 			ControlDeviceState state = stateData[_pollCounter];
 			device->SetRawState(state);
@@ -11,6 +11,8 @@
 #include "Shared/NotificationManager.h"
 #include "Shared/BatteryManager.h"
 #include "Shared/CheatManager.h"
+#include "Shared/Audio/SoundMixer.h"
+#include "Shared/RomFinder.h"
 #include "Utilities/ZipReader.h"
 #include "Utilities/StringUtilities.h"
 #include "Utilities/HexUtilities.h"
@@ -22,6 +24,7 @@ MesenMovie::MesenMovie(Emulator* emu, bool forTest)
 {
 	_emu = emu;
 	_forTest = forTest;
+	_seekTarget = -1;
 }
 
 MesenMovie::~MesenMovie()
@@ -32,7 +35,7 @@ MesenMovie::~MesenMovie()
 void MesenMovie::Stop()
 {
 	if(_playing) {
-		bool isEndOfMovie = _lastPollCounter >= _inputData.size();
+		bool isEndOfMovie = _lastPollCounter >= GetInputRowCount();
 
 		if(!_forTest) {
 			MessageManager::DisplayMessage("Movies", isEndOfMovie ? "MovieEnded" : "MovieStopped");
@@ -62,11 +65,20 @@ bool MesenMovie::SetInput(BaseControlDevice *device)
 	uint32_t inputRowIndex = _controlManager->GetPollCounter();
 	_lastPollCounter = inputRowIndex;
 
-	if(_inputData.size() > inputRowIndex && _inputData[inputRowIndex].size() > _deviceIndex) {
-		device->SetTextState(_inputData[inputRowIndex][_deviceIndex]);
+	const uint8_t* row = inputRowIndex < GetInputRowCount() ? _inputStates.data() + _inputRowOffsets[inputRowIndex] : nullptr;
+	if(row && row[0] > _deviceIndex) {
+		//Skip over the previous devices' entries
+		const uint8_t* entry = row + 1;
+		for(size_t i = 0; i < _deviceIndex; i++) {
+			entry += 2 + (entry[0] | (entry[1] << 8));
+		}
+
+		ControlDeviceState state;
+		state.State.assign(entry + 2, entry + 2 + (entry[0] | (entry[1] << 8)));
+		device->SetRawState(state);
 
 		_deviceIndex++;
-		if(_deviceIndex >= _inputData[inputRowIndex].size()) {
+		if(_deviceIndex >= row[0]) {
 			//Move to the next frame's data
 			_deviceIndex = 0;
 		}
@@ -100,6 +112,119 @@ void MesenMovie::ProcessNotification(ConsoleNotificationType type, void* paramet
 	}
 }
 
+void MesenMovie::ProcessEndOfFrame()
+{
+	//Checkpoints are only taken between frames, so that restoring them resumes emulation at a frame boundary
+	BaseControlManager* controlManager = _controlManager;
+	if(_playing && controlManager && _deviceIndex == 0) {
+		uint32_t inputRow = controlManager->GetPollCounter();
+		auto prev = _checkpoints.upper_bound(inputRow);
+		if(prev == _checkpoints.begin() || inputRow - std::prev(prev)->first >= _checkpointInterval) {
+			SaveCheckpoint(inputRow);
+		}
+	}
+}
+
+void MesenMovie::SaveCheckpoint(uint32_t inputRow)
+{
+	stringstream state;
+	_emu->Serialize(state, false, 1);
+	string& checkpoint = _checkpoints[inputRow];
+	_checkpointMemory -= checkpoint.size();
+	checkpoint = state.str();
+	_checkpointMemory += checkpoint.size();
+
+	if(_checkpointMemory > MesenMovie::MaxCheckpointMemory) {
+		TrimCheckpoints();
+	}
+}
+
+void MesenMovie::TrimCheckpoints()
+{
+	//Double the interval between checkpoints until the memory budget is respected again
+	while(_checkpointMemory > MesenMovie::MaxCheckpointMemory && _checkpoints.size() > 1) {
+		_checkpointInterval *= 2;
+
+		uint32_t lastKept = _checkpoints.begin()->first;
+		for(auto it = std::next(_checkpoints.begin()); it != _checkpoints.end();) {
+			if(it->first - lastKept < _checkpointInterval) {
+				_checkpointMemory -= it->second.size();
+				it = _checkpoints.erase(it);
+			} else {
+				lastKept = it->first;
+				it++;
+			}
+		}
+	}
+}
+
+uint32_t MesenMovie::GetInputRowCount()
+{
+	//The last offset marks the end of the last row
+	return _inputRowOffsets.empty() ? 0 : (uint32_t)_inputRowOffsets.size() - 1;
+}
+
+bool MesenMovie::SeekTo(uint32_t inputRow)
+{
+	if(!_playing || inputRow >= GetInputRowCount()) {
+		return false;
+	}
+
+	_seekTarget = inputRow;
+	return true;
+}
+
+bool MesenMovie::IsSeekPending()
+{
+	return _seekTarget >= 0;
+}
+
+bool MesenMovie::ProcessPendingSeek()
+{
+	int64_t target = _seekTarget.exchange(-1);
+	BaseControlManager* controlManager = _controlManager;
+	if(target < 0 || !_playing || !controlManager) {
+		return false;
+	}
+
+	uint32_t inputRow = (uint32_t)target;
+	uint32_t currentRow = controlManager->GetPollCounter();
+
+	//Use a checkpoint before the target row (when possible), so the target frame is always run and displayed
+	auto checkpoint = inputRow > 0 ? _checkpoints.lower_bound(inputRow) : _checkpoints.upper_bound(inputRow);
+	if(checkpoint != _checkpoints.begin()) {
+		checkpoint--;
+		if(currentRow > inputRow || checkpoint->first > currentRow) {
+			//Restore the nearest checkpoint, unless the current position is closer to the target
+			stringstream state(checkpoint->second);
+			if(!_emu->Deserialize(state, SaveStateManager::FileFormatVersion, false)) {
+				return false;
+			}
+			_deviceIndex = 0;
+			currentRow = controlManager->GetPollCounter();
+		}
+	}
+
+	//Run the remaining frames without audio/video output, except the frame that reaches the target row
+	//Checkpoints are still recorded along the way
+	uint32_t lagFrames = 0;
+	while(_playing && currentRow < inputRow && lagFrames < MesenMovie::MaxSeekLagFrames) {
+		_emu->RunFrame(currentRow + 1 >= inputRow);
+		ProcessEndOfFrame();
+		uint32_t newRow = controlManager->GetPollCounter();
+		lagFrames = newRow == currentRow ? lagFrames + 1 : 0;
+		currentRow = newRow;
+	}
+
+	if(_playing && currentRow < inputRow) {
+		MessageManager::Log("[Movie] Seek stopped at input row " + std::to_string(currentRow) + " instead of " + std::to_string(inputRow) + " (no input was read for " + std::to_string(MesenMovie::MaxSeekLagFrames) + " frames)");
+	}
+
+	_lastPollCounter = currentRow;
+	_emu->GetSoundMixer()->StopAudio(true);
+	return true;
+}
+
 bool MesenMovie::Play(VirtualFile &file)
 {
 	_movieFile = file;
@@ -120,14 +245,6 @@ bool MesenMovie::Play(VirtualFile &file)
 		return false;
 	}
 
-	while(inputData) {
-		string line;
-		std::getline(inputData, line);
-		if(line.substr(0, 1) == "|") {
-			_inputData.push_back(StringUtilities::Split(line.substr(1), '|'));
-		}
-	}
-
 	_deviceIndex = 0;
 
 	ParseSettings(settingsData);
@@ -144,6 +261,10 @@ bool MesenMovie::Play(VirtualFile &file)
 		return false;
 	}
 
+	if(!LoadGame()) {
+		return false;
+	}
+
 	auto emuLock = _emu->AcquireLock(false);
 
 	if(!ApplySettings(settingsData)) {
@@ -172,12 +293,61 @@ bool MesenMovie::Play(VirtualFile &file)
 	}
 
 	_controlManager->UpdateControlDevices();
+	LoadInputData(inputData);
 	_controlManager->SetPollCounter(0);
 	_playing = true;
 
+	_checkpoints.clear();
+	_checkpointMemory = 0;
+	_checkpointInterval = MesenMovie::DefaultCheckpointInterval;
+	SaveCheckpoint(0);
+
 	return true;
 }
 
+void MesenMovie::LoadInputData(istream& inputData)
+{
+	//Parse the text input log once, using the current devices to convert each entry to its raw state
+	//This keeps the log compact in memory and avoids parsing text on every input poll
+	vector<shared_ptr<BaseControlDevice>> devices = _controlManager->GetControlDevices();
+	vector<ControlDeviceState> originalStates;
+	for(shared_ptr<BaseControlDevice>& device : devices) {
+		originalStates.push_back(device->GetRawState());
+	}
+
+	_inputStates.clear();
+	_inputRowOffsets.clear();
+
+	string line;
+	while(std::getline(inputData, line)) {
+		if(line.substr(0, 1) != "|") {
+			continue;
+		}
+
+		vector<string> row = StringUtilities::Split(line.substr(1), '|');
+		size_t deviceCount = std::min(row.size(), devices.size());
+
+		_inputRowOffsets.push_back((uint32_t)_inputStates.size());
+		_inputStates.push_back((uint8_t)deviceCount);
+		for(size_t i = 0; i < deviceCount; i++) {
+			devices[i]->SetTextState(row[i]);
+			ControlDeviceState state = devices[i]->GetRawState();
+			uint16_t size = (uint16_t)state.State.size();
+			_inputStates.push_back(size & 0xFF);
+			_inputStates.push_back(size >> 8);
+			_inputStates.insert(_inputStates.end(), state.State.begin(), state.State.begin() + size);
+		}
+	}
+	_inputRowOffsets.push_back((uint32_t)_inputStates.size());
+
+	_inputStates.shrink_to_fit();
+	_inputRowOffsets.shrink_to_fit();
+
+	for(size_t i = 0; i < devices.size(); i++) {
+		devices[i]->SetRawState(originalStates[i]);
+	}
+}
+
 template<typename T>
 T FromString(string name, const vector<string> &enumNames, T defaultValue)
 {
@@ -211,6 +381,25 @@ void MesenMovie::ParseSettings(stringstream &data)
 	}
 }
 
+bool MesenMovie::LoadGame()
+{
+	string sha1 = LoadString(_settings, MovieKeys::Sha1);
+	if(sha1.empty() || (_emu->IsRunning() && _emu->GetHash(HashType::Sha1) == sha1)) {
+		//Current game matches (or the movie doesn't specify which game it was recorded with)
+		return true;
+	}
+
+	string gameFile = LoadString(_settings, MovieKeys::GameFile);
+	string romFile = RomFinder::FindMatchingRom(_emu, gameFile, sha1);
+	if(romFile.empty()) {
+		MessageManager::DisplayMessage("Movies", "MovieMissingRom", gameFile);
+		return false;
+	}
+
+	VirtualFile patchFile(_movieFile.GetFilePath(), "PatchData.dat");
+	return _emu->LoadRom(romFile, patchFile.IsValid() ? patchFile : VirtualFile(""));
+}
+
 bool MesenMovie::ApplySettings(istream& settingsData)
 {
 	EmuSettings* settings = _emu->GetSettings();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pch.h"
+#include <map>
 #include "Utilities/VirtualFile.h"
 #include "Shared/BatteryManager.h"
 #include "Shared/Interfaces/INotificationListener.h"
@@ -23,7 +24,12 @@ private:
 	bool _playing = false;
 	size_t _deviceIndex = 0;
 	uint32_t _lastPollCounter = 0;
-	vector<vector<string>> _inputData;
+
+	//Input log, converted to raw device states when the movie is loaded
+	//Each row is made of a device count, followed by a [16-bit size, state] entry for each device
+	vector<uint8_t> _inputStates;
+	vector<uint32_t> _inputRowOffsets;
+
 	vector<string> _cheats;
 	vector<CheatCode> _originalCheats;
 	stringstream _emuSettingsBackup;
@@ -31,17 +37,33 @@ private:
 	string _filename;
 	bool _forTest = false;
 
+	//Compressed save states taken during playback, indexed by input row, used to seek within the movie
+	static constexpr uint32_t DefaultCheckpointInterval = 300;
+	static constexpr size_t MaxCheckpointMemory = 64 * 1024 * 1024;
+	static constexpr uint32_t MaxSeekLagFrames = 3600;
+
+	std::map<uint32_t, string> _checkpoints;
+	size_t _checkpointMemory = 0;
+	uint32_t _checkpointInterval = DefaultCheckpointInterval;
+	atomic<int64_t> _seekTarget;
+
 private:
 	void ParseSettings(stringstream &data);
+	bool LoadGame();
 	bool ApplySettings(istream& settingsData);
 
 	uint32_t LoadInt(std::unordered_map<string, string> &settings, string name, uint32_t defaultValue = 0);
 	bool LoadBool(std::unordered_map<string, string> &settings, string name);
 	string LoadString(std::unordered_map<string, string> &settings, string name);
 
+	void LoadInputData(istream& inputData);
+
 	void LoadCheats();
 	bool LoadCheat(string cheatData, CheatCode &code);
 
+	void SaveCheckpoint(uint32_t inputRow);
+	void TrimCheckpoints();
+
 public:
 	MesenMovie(Emulator* emu, bool silent);
 	virtual ~MesenMovie();
@@ -52,6 +74,12 @@ public:
 	bool SetInput(BaseControlDevice* device) override;
 	bool IsPlaying() override;
 
+	uint32_t GetInputRowCount() override;
+	bool SeekTo(uint32_t inputRow) override;
+	bool IsSeekPending() override;
+	bool ProcessPendingSeek() override;
+	void ProcessEndOfFrame() override;
+
 	//Inherited via IBatteryProvider
 	vector<uint8_t> LoadBattery(string extension) override;
 
@@ -71,3 +71,35 @@ bool MovieManager::Recording()
 {
 	return _recorder != nullptr;
 }
+
+uint32_t MovieManager::GetInputRowCount()
+{
+	shared_ptr<IMovie> player = _player.lock();
+	return player ? player->GetInputRowCount() : 0;
+}
+
+bool MovieManager::SeekTo(uint32_t inputRow)
+{
+	shared_ptr<IMovie> player = _player.lock();
+	return player ? player->SeekTo(inputRow) : false;
+}
+
+bool MovieManager::IsSeekPending()
+{
+	shared_ptr<IMovie> player = _player.lock();
+	return player ? player->IsSeekPending() : false;
+}
+
+bool MovieManager::ProcessPendingSeek()
+{
+	shared_ptr<IMovie> player = _player.lock();
+	return player ? player->ProcessPendingSeek() : false;
+}
+
+void MovieManager::ProcessEndOfFrame()
+{
+	shared_ptr<IMovie> player = _player.lock();
+	if(player) {
+		player->ProcessEndOfFrame();
+	}
+}
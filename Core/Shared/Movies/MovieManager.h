@@ -17,6 +17,12 @@ public:
 	virtual bool Play(VirtualFile& file) = 0;
 	virtual void Stop() = 0;
 	virtual bool IsPlaying() = 0;
+
+	virtual uint32_t GetInputRowCount() = 0;
+	virtual bool SeekTo(uint32_t inputRow) = 0;
+	virtual bool IsSeekPending() = 0;
+	virtual bool ProcessPendingSeek() = 0;
+	virtual void ProcessEndOfFrame() = 0;
 };
 
 class MovieManager
@@ -34,4 +40,11 @@ public:
 	void Stop();
 	bool Playing();
 	bool Recording();
+
+	//Seeking is done by the emulation thread, at the end of the current frame
+	uint32_t GetInputRowCount();
+	bool SeekTo(uint32_t inputRow);
+	bool IsSeekPending();
+	bool ProcessPendingSeek();
+	void ProcessEndOfFrame();
 };
\ No newline at end of file
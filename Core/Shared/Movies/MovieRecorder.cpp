@@ -216,12 +216,13 @@ bool MovieRecorder::CreateMovie(string movieFile, deque<RewindData> &data, uint3
 		_inputData = stringstream();
 
 		for(uint32_t i = startPosition; i < endPosition; i++) {
-			RewindData rewindData = data[i];
+			RewindData& rewindData = data[i];
 			for(uint32_t j = 0; j < RewindManager::BufferSize; j++) {
 				for(shared_ptr<BaseControlDevice> &device : devices) {
 					uint8_t port = device->GetPort();
-					if(j < rewindData.InputLogs[port].size()) {
-						device->SetRawState(rewindData.InputLogs[port][j]);
+					const std::deque<ControlDeviceState>& inputLog = rewindData.GetInputLog(port);
+					if(j < inputLog.size()) {
+						device->SetRawState(inputLog[j]);
 						_inputData << ("|" + device->GetTextState());
 					}
 				}
@@ -14,6 +14,9 @@ struct RenderedFrame
 	uint32_t VideoPhase = 0;
 	vector<ControllerData> InputData;
 
+	//Time at which the input for this frame was polled (see FrameLimiter), 0 when unknown
+	double InputTimestamp = 0;
+
 	RenderedFrame()
 	{}
 
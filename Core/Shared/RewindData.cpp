@@ -4,10 +4,31 @@
 #include "Shared/SaveStateManager.h"
 #include "Utilities/CompressionHelper.h"
 
+const std::deque<ControlDeviceState>& RewindData::GetInputLog(uint8_t port)
+{
+	static const std::deque<ControlDeviceState> emptyLog;
+	return _inputLogs ? _inputLogs->Ports[port] : emptyLog;
+}
+
+std::deque<ControlDeviceState>& RewindData::GetWritableInputLog(uint8_t port)
+{
+	if(!_inputLogs) {
+		_inputLogs = std::make_shared<RewindInputLogs>();
+	} else if(_inputLogs.use_count() > 1) {
+		//Logs are shared with another copy of this block, copy them before modifying them
+		_inputLogs = std::make_shared<RewindInputLogs>(*_inputLogs);
+	}
+	return _inputLogs->Ports[port];
+}
+
 void RewindData::GetStateData(stringstream &stateData, deque<RewindData>& prevStates, int32_t position)
 {
+	if(!_saveStateData) {
+		return;
+	}
+
 	vector<uint8_t> data;
-	CompressionHelper::Decompress(_saveStateData, data);
+	CompressionHelper::Decompress(*_saveStateData, data);
 
 	if(!IsFullState) {
 		position = (position > 0 ? position : (int32_t)prevStates.size()) - 1;
@@ -26,7 +47,7 @@ void RewindData::ProcessXorState(T& data, deque<RewindData>& prevStates, int32_t
 		if(prevState.IsFullState) {
 			//XOR with previous state to restore state data to its initial state
 			vector<uint8_t> prevStateData;
-			CompressionHelper::Decompress(prevState._saveStateData, prevStateData);
+			CompressionHelper::Decompress(*prevState._saveStateData, prevStateData);
 			for(size_t i = 0, len = std::min(prevStateData.size(), data.size()); i < len; i++) {
 				data[i] ^= prevStateData[i];
 			}
@@ -38,12 +59,12 @@ void RewindData::ProcessXorState(T& data, deque<RewindData>& prevStates, int32_t
 
 void RewindData::LoadState(Emulator* emu, deque<RewindData>& prevStates, int32_t position)
 {
-	if(_saveStateData.size() == 0) {
+	if(!_saveStateData || _saveStateData->size() == 0) {
 		return;
 	}
 		
 	vector<uint8_t> data;
-	CompressionHelper::Decompress(_saveStateData, data);
+	CompressionHelper::Decompress(*_saveStateData, data);
 
 	if(!IsFullState) {
 		position = (position > 0 ? position : (int32_t)prevStates.size()) - 1;
@@ -73,6 +94,8 @@ void RewindData::SaveState(Emulator* emu, deque<RewindData>& prevStates, int32_t
 		IsFullState = true;
 	}
 
-	CompressionHelper::Compress(data, 1, _saveStateData);
+	vector<uint8_t> compressedData;
+	CompressionHelper::Compress(data, 1, compressedData);
+	_saveStateData = std::make_shared<const vector<uint8_t>>(std::move(compressedData));
 	FrameCount = 0;
 }
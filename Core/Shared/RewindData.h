@@ -5,22 +5,32 @@
 
 class Emulator;
 
+struct RewindInputLogs
+{
+	std::deque<ControlDeviceState> Ports[BaseControlDevice::PortCount];
+};
+
 class RewindData
 {
 private:
-	vector<uint8_t> _saveStateData;
+	//The state and input data is shared between all copies of a block (e.g with the history viewer)
+	//The state data is never modified once saved, and the input logs are copied before being modified
+	shared_ptr<const vector<uint8_t>> _saveStateData;
+	shared_ptr<RewindInputLogs> _inputLogs;
 
 	template<typename T>
 	void ProcessXorState(T& data, deque<RewindData>& prevStates, int32_t position);
 
 public:
-	std::deque<ControlDeviceState> InputLogs[BaseControlDevice::PortCount];
 	int32_t FrameCount = 0;
 	bool EndOfSegment = false;
 	bool IsFullState = false;
 
 	void GetStateData(stringstream& stateData, deque<RewindData>& prevStates, int32_t position);
-	uint32_t GetStateSize() { return (uint32_t)_saveStateData.size(); }
+	uint32_t GetStateSize() { return _saveStateData ? (uint32_t)_saveStateData->size() : 0; }
+
+	const std::deque<ControlDeviceState>& GetInputLog(uint8_t port);
+	std::deque<ControlDeviceState>& GetWritableInputLog(uint8_t port);
 
 	void LoadState(Emulator* emu, deque<RewindData>& prevStates, int32_t position = -1);
 	void SaveState(Emulator* emu, deque<RewindData>& prevStates, int32_t position = -1);
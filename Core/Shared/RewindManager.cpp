@@ -76,10 +76,11 @@ void RewindManager::ProcessNotification(ConsoleNotificationType type, void * par
 					_currentHistory.FrameCount++;
 					if(_framesToFastForward == 0) {
 						for(int i = 0; i < 4; i++) {
-							size_t numberToRemove = _currentHistory.InputLogs[i].size();
-							_currentHistory.InputLogs[i] = _historyBackup.front().InputLogs[i];
+							std::deque<ControlDeviceState>& inputLog = _currentHistory.GetWritableInputLog(i);
+							size_t numberToRemove = inputLog.size();
+							inputLog = _historyBackup.front().GetInputLog(i);
 							for(size_t j = 0; j < numberToRemove; j++) {
-								_currentHistory.InputLogs[i].pop_back();
+								inputLog.pop_back();
 							}
 						}
 						_historyBackup.clear();
@@ -340,7 +341,7 @@ void RewindManager::RecordInput(vector<shared_ptr<BaseControlDevice>> devices)
 {
 	if(_settings->GetPreferences().RewindBufferSize > 0 && _rewindState == RewindState::Stopped) {
 		for(shared_ptr<BaseControlDevice> &device : devices) {
-			_currentHistory.InputLogs[device->GetPort()].push_back(device->GetRawState());
+			_currentHistory.GetWritableInputLog(device->GetPort()).push_back(device->GetRawState());
 		}
 	}
 }
@@ -348,9 +349,10 @@ void RewindManager::RecordInput(vector<shared_ptr<BaseControlDevice>> devices)
 bool RewindManager::SetInput(BaseControlDevice *device)
 {
 	uint8_t port = device->GetPort();
-	if(!_currentHistory.InputLogs[port].empty() && IsRewinding()) {
-		ControlDeviceState state = _currentHistory.InputLogs[port].front();
-		_currentHistory.InputLogs[port].pop_front();
+	if(!_currentHistory.GetInputLog(port).empty() && IsRewinding()) {
+		std::deque<ControlDeviceState>& inputLog = _currentHistory.GetWritableInputLog(port);
+		ControlDeviceState state = inputLog.front();
+		inputLog.pop_front();
 		device->SetRawState(state);
 		return true;
 	} else {
@@ -407,6 +409,7 @@ bool RewindManager::HasHistory()
 
 deque<RewindData> RewindManager::GetHistory()
 {
+	//Blocks share their (immutable) state data and input logs, so this only copies pointers
 	deque<RewindData> history = _history;
 	history.push_back(_currentHistory);
 	return history;
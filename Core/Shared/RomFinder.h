@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "Shared/Emulator.h"
 #include "Shared/MessageManager.h"
+#include "Shared/RomIndex.h"
 #include "Utilities/VirtualFile.h"
 #include "Utilities/FolderUtilities.h"
 #include "Utilities/HexUtilities.h"
@@ -16,6 +17,14 @@ private:
 			return emu->GetRomInfo().RomFile;
 		}
 
+		string indexedRom = emu->GetRomIndex()->FindRom(crc32, romName);
+		if(!indexedRom.empty()) {
+			return indexedRom;
+		}
+
+		//Not in the index (e.g large or recently added file), look for it in the known folders
+		emu->GetRomIndex()->Refresh();
+
 		string lcRomname = romName;
 		std::transform(lcRomname.begin(), lcRomname.end(), lcRomname.begin(), ::tolower);
 
@@ -49,6 +58,45 @@ private:
 	}
 
 public:
+	static string FindMatchingRom(Emulator* emu, string romName, string sha1)
+	{
+		if(emu->IsRunning() && emu->GetHash(HashType::Sha1) == sha1) {
+			//Current game matches
+			return emu->GetRomInfo().RomFile;
+		}
+
+		string indexedRom = emu->GetRomIndex()->FindRomBySha1(sha1);
+		if(!indexedRom.empty()) {
+			return indexedRom;
+		}
+
+		//Not in the index (e.g large or recently added file), look for a file with the same name in the known folders
+		emu->GetRomIndex()->Refresh();
+
+		string lcRomname = romName;
+		std::transform(lcRomname.begin(), lcRomname.end(), lcRomname.begin(), ::tolower);
+
+		unordered_set<string> checkedFolders;
+		for(string folder : FolderUtilities::GetKnownGameFolders()) {
+			if(!checkedFolders.emplace(folder).second) {
+				continue;
+			}
+
+			for(string romFilename : FolderUtilities::GetFilesInFolder(folder, VirtualFile::RomExtensions, true)) {
+				string lcRomFile = romFilename;
+				std::transform(lcRomFile.begin(), lcRomFile.end(), lcRomFile.begin(), ::tolower);
+
+				if(FolderUtilities::GetFilename(lcRomname, false) == FolderUtilities::GetFilename(lcRomFile, false) && VirtualFile(romFilename).GetSha1Hash() == sha1) {
+					return romFilename;
+				}
+			}
+		}
+
+		MessageManager::Log("Could not find matching file: " + romName + "  SHA1: " + sha1);
+
+		return "";
+	}
+
 	static bool LoadMatchingRom(Emulator* emu, string romName, uint32_t crc32)
 	{
 		if(emu->IsRunning() && emu->GetCrc32() == crc32) {
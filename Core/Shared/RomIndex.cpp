@@ -0,0 +1,341 @@
+#include "pch.h"
+#include "Shared/RomIndex.h"
+#include "Shared/MessageManager.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/FolderUtilities.h"
+#include "Utilities/ArchiveReader.h"
+#include "Utilities/CRC32.h"
+#include "Utilities/sha1.h"
+
+RomIndex::RomIndex()
+{
+	_scanRunning = false;
+	_rescanRequested = false;
+	_stopScan = false;
+}
+
+RomIndex::~RomIndex()
+{
+	StopScan();
+}
+
+string RomIndex::GetIndexPath()
+{
+	return FolderUtilities::CombinePath(FolderUtilities::GetHomeFolder(), "RomIndex.dat");
+}
+
+bool RomIndex::IsArchive(const string& filepath)
+{
+	string ext = FolderUtilities::GetExtension(filepath);
+	return ext == ".zip" || ext == ".7z";
+}
+
+static string ToLower(string str)
+{
+	std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+	return str;
+}
+
+static void WriteString(ofstream& out, const string& str)
+{
+	uint32_t len = (uint32_t)str.size();
+	out.write((char*)&len, sizeof(len));
+	out.write(str.c_str(), len);
+}
+
+static bool ReadString(ifstream& in, string& str)
+{
+	uint32_t len = 0;
+	in.read((char*)&len, sizeof(len));
+	if(!in || len > 0x10000) {
+		return false;
+	}
+	str.resize(len);
+	in.read(&str[0], len);
+	return (bool)in;
+}
+
+template<typename T>
+static bool ReadValue(ifstream& in, T& value)
+{
+	in.read((char*)&value, sizeof(T));
+	return (bool)in;
+}
+
+void RomIndex::LoadIndex()
+{
+	auto lock = _lock.AcquireSafe();
+	if(_loaded) {
+		return;
+	}
+	_loaded = true;
+
+	ifstream in(GetIndexPath(), std::ios::in | std::ios::binary);
+	if(!in) {
+		return;
+	}
+
+	char magic[4] = {};
+	uint32_t version = 0;
+	uint32_t fileCount = 0;
+	in.read(magic, 4);
+	if(!in || memcmp(magic, "MRIX", 4) != 0 || !ReadValue(in, version) || version != RomIndex::FileVersion || !ReadValue(in, fileCount)) {
+		return;
+	}
+
+	for(uint32_t i = 0; i < fileCount; i++) {
+		string path;
+		RomIndexFile file = {};
+		uint32_t romCount = 0;
+		if(!ReadString(in, path) || !ReadValue(in, file.Size) || !ReadValue(in, file.ModifiedTime) || !ReadValue(in, romCount)) {
+			break;
+		}
+
+		for(uint32_t j = 0; j < romCount; j++) {
+			RomIndexEntry entry = {};
+			if(!ReadString(in, entry.Path) || !ReadValue(in, entry.Crc32) || !ReadString(in, entry.Sha1)) {
+				break;
+			}
+			file.Roms.push_back(entry);
+		}
+
+		if(file.Roms.size() != romCount) {
+			//Truncated file
+			break;
+		}
+		_files[path] = std::move(file);
+	}
+
+	UpdateLookups();
+}
+
+void RomIndex::SaveIndex()
+{
+	auto lock = _lock.AcquireSafe();
+
+	ofstream out(GetIndexPath(), std::ios::out | std::ios::binary);
+	if(!out) {
+		return;
+	}
+
+	uint32_t version = RomIndex::FileVersion;
+	uint32_t fileCount = (uint32_t)_files.size();
+	out.write("MRIX", 4);
+	out.write((char*)&version, sizeof(version));
+	out.write((char*)&fileCount, sizeof(fileCount));
+
+	for(auto& kvp : _files) {
+		uint32_t romCount = (uint32_t)kvp.second.Roms.size();
+		WriteString(out, kvp.first);
+		out.write((char*)&kvp.second.Size, sizeof(kvp.second.Size));
+		out.write((char*)&kvp.second.ModifiedTime, sizeof(kvp.second.ModifiedTime));
+		out.write((char*)&romCount, sizeof(romCount));
+
+		for(RomIndexEntry& entry : kvp.second.Roms) {
+			WriteString(out, entry.Path);
+			out.write((char*)&entry.Crc32, sizeof(entry.Crc32));
+			WriteString(out, entry.Sha1);
+		}
+	}
+}
+
+void RomIndex::UpdateLookups()
+{
+	_pathsByCrc32.clear();
+	_pathsBySha1.clear();
+	for(auto& kvp : _files) {
+		for(RomIndexEntry& entry : kvp.second.Roms) {
+			_pathsByCrc32.emplace(entry.Crc32, entry.Path);
+			_pathsBySha1.emplace(entry.Sha1, entry.Path);
+		}
+	}
+}
+
+void RomIndex::IndexFile(const string& filepath, RomIndexFile& file)
+{
+	if(file.Size > RomIndex::MaxIndexedFileSize) {
+		//Large files (e.g disc images) are only hashed on demand
+		return;
+	}
+
+	if(IsArchive(filepath)) {
+		unique_ptr<ArchiveReader> reader = ArchiveReader::GetReader(filepath);
+		if(reader) {
+			for(string& romName : reader->GetFileList(VirtualFile::RomExtensions)) {
+				vector<uint8_t> data;
+				if(reader->ExtractFile(romName, data)) {
+					file.Roms.push_back({ VirtualFile(filepath, romName), CRC32::GetCRC(data), SHA1::GetHash(data) });
+				}
+			}
+		}
+	} else {
+		VirtualFile romFile(filepath);
+		file.Roms.push_back({ filepath, romFile.GetCrc32(), romFile.GetSha1Hash() });
+	}
+}
+
+bool RomIndex::IsUnchanged(const string& filepath, RomIndexFile& file)
+{
+	return file.ModifiedTime == FolderUtilities::GetFileModificationTime(filepath) && file.Size == VirtualFile(filepath).GetSize();
+}
+
+void RomIndex::ScanFolders()
+{
+	while(true) {
+		_rescanRequested = false;
+
+		std::unordered_set<string> extensions(VirtualFile::RomExtensions);
+		extensions.emplace(".zip");
+		extensions.emplace(".7z");
+
+		vector<string> filePaths;
+		std::unordered_set<string> checkedFiles;
+		std::unordered_set<string> checkedFolders;
+		for(string& folder : FolderUtilities::GetKnownGameFolders()) {
+			if(!checkedFolders.emplace(folder).second) {
+				continue;
+			}
+			for(string& filepath : FolderUtilities::GetFilesInFolder(folder, extensions, true)) {
+				if(checkedFiles.emplace(filepath).second) {
+					filePaths.push_back(filepath);
+				}
+			}
+		}
+
+		unordered_map<string, RomIndexFile> files;
+		for(string& filepath : filePaths) {
+			RomIndexFile file = {};
+			file.Size = VirtualFile(filepath).GetSize();
+			file.ModifiedTime = FolderUtilities::GetFileModificationTime(filepath);
+			files[filepath] = std::move(file);
+		}
+
+		//Reuse the hashes of the files that have not changed since the last scan
+		vector<std::pair<const string*, RomIndexFile*>> filesToIndex;
+		bool indexChanged;
+		{
+			auto lock = _lock.AcquireSafe();
+			indexChanged = files.size() != _files.size();
+			for(auto& kvp : files) {
+				auto result = _files.find(kvp.first);
+				if(result != _files.end() && result->second.Size == kvp.second.Size && result->second.ModifiedTime == kvp.second.ModifiedTime) {
+					kvp.second.Roms = result->second.Roms;
+				} else {
+					filesToIndex.push_back({ &kvp.first, &kvp.second });
+				}
+			}
+		}
+
+		if(!filesToIndex.empty()) {
+			indexChanged = true;
+
+			atomic<size_t> nextFile(0);
+			uint32_t threadCount = std::max<uint32_t>(1, std::min<uint32_t>(RomIndex::MaxScanThreads, std::thread::hardware_concurrency()));
+			vector<thread> threads;
+			for(uint32_t i = 0; i < threadCount; i++) {
+				threads.push_back(std::thread([&]() {
+					size_t index;
+					while(!_stopScan && (index = nextFile++) < filesToIndex.size()) {
+						IndexFile(*filesToIndex[index].first, *filesToIndex[index].second);
+					}
+				}));
+			}
+			for(thread& t : threads) {
+				t.join();
+			}
+		}
+
+		if(_stopScan) {
+			//Incomplete scan, keep the previous index
+			_scanRunning = false;
+			return;
+		}
+
+		if(indexChanged) {
+			size_t fileCount = files.size();
+			{
+				auto lock = _lock.AcquireSafe();
+				_files = std::move(files);
+				UpdateLookups();
+			}
+			SaveIndex();
+			MessageManager::Log("[RomIndex] Indexed " + std::to_string(filesToIndex.size()) + " new or modified file(s), " + std::to_string(fileCount) + " file(s) total.");
+		}
+
+		auto lock = _scanLock.AcquireSafe();
+		if(!_rescanRequested) {
+			_scanRunning = false;
+			return;
+		}
+	}
+}
+
+void RomIndex::Refresh()
+{
+	LoadIndex();
+
+	auto lock = _scanLock.AcquireSafe();
+	_rescanRequested = true;
+	if(_scanRunning) {
+		//The current scan will run again once it's done
+		return;
+	}
+
+	if(_scanThread) {
+		_scanThread->join();
+	}
+	_scanRunning = true;
+	_stopScan = false;
+	_scanThread.reset(new thread(&RomIndex::ScanFolders, this));
+}
+
+void RomIndex::StopScan()
+{
+	_stopScan = true;
+	if(_scanThread) {
+		_scanThread->join();
+		_scanThread.reset();
+	}
+}
+
+string RomIndex::FindRom(uint32_t crc32, string romName)
+{
+	LoadIndex();
+
+	string lcRomName = ToLower(FolderUtilities::GetFilename(romName, false));
+	string match;
+
+	auto lock = _lock.AcquireSafe();
+	auto range = _pathsByCrc32.equal_range(crc32);
+	for(auto it = range.first; it != range.second; it++) {
+		VirtualFile romFile(it->second);
+		auto result = _files.find(romFile.GetFilePath());
+		if(result == _files.end() || !IsUnchanged(result->first, result->second)) {
+			//File was modified or deleted since it was indexed
+			continue;
+		}
+
+		if(ToLower(FolderUtilities::GetFilename(romFile.GetFileName(), false)) == lcRomName) {
+			return it->second;
+		} else if(match.empty()) {
+			match = it->second;
+		}
+	}
+
+	return match;
+}
+
+string RomIndex::FindRomBySha1(string sha1)
+{
+	LoadIndex();
+
+	auto lock = _lock.AcquireSafe();
+	auto result = _pathsBySha1.find(sha1);
+	if(result != _pathsBySha1.end()) {
+		auto file = _files.find(VirtualFile(result->second).GetFilePath());
+		if(file != _files.end() && IsUnchanged(file->first, file->second)) {
+			return result->second;
+		}
+	}
+	return "";
+}
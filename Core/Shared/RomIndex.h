@@ -0,0 +1,64 @@
+#pragma once
+#include "pch.h"
+#include <unordered_set>
+#include "Utilities/SimpleLock.h"
+
+struct RomIndexEntry
+{
+	//VirtualFile path (includes the name of the file for archives)
+	string Path;
+	uint32_t Crc32;
+	string Sha1;
+};
+
+struct RomIndexFile
+{
+	uint64_t Size;
+	int64_t ModifiedTime;
+	vector<RomIndexEntry> Roms;
+};
+
+//Persistent CRC32/SHA1 index of the roms (and archive content) found in the known game folders
+class RomIndex
+{
+private:
+	static constexpr uint32_t FileVersion = 3;
+	static constexpr uint64_t MaxIndexedFileSize = 64 * 1024 * 1024;
+	static constexpr uint32_t MaxScanThreads = 4;
+
+	unordered_map<string, RomIndexFile> _files;
+	std::unordered_multimap<uint32_t, string> _pathsByCrc32;
+	unordered_map<string, string> _pathsBySha1;
+	SimpleLock _lock;
+	bool _loaded = false;
+
+	unique_ptr<thread> _scanThread;
+	SimpleLock _scanLock;
+	atomic<bool> _scanRunning;
+	atomic<bool> _rescanRequested;
+	atomic<bool> _stopScan;
+
+	static string GetIndexPath();
+	static bool IsArchive(const string& filepath);
+	static void IndexFile(const string& filepath, RomIndexFile& file);
+	static bool IsUnchanged(const string& filepath, RomIndexFile& file);
+
+	void LoadIndex();
+	void SaveIndex();
+	void UpdateLookups();
+	void ScanFolders();
+
+public:
+	RomIndex();
+	~RomIndex();
+
+	//Starts (or queues) an incremental scan of the known game folders in the background
+	void Refresh();
+	void StopScan();
+
+	//Returns the path of a rom with a matching CRC32 (preferring files named [romName]), or an empty string
+	string FindRom(uint32_t crc32, string romName = "");
+
+	//Returns the path of a rom with a matching SHA1, or an empty string
+	string FindRomBySha1(string sha1);
+};
@@ -3,6 +3,7 @@
 #include "Utilities/ZipWriter.h"
 #include "Utilities/ZipReader.h"
 #include "Utilities/PNGHelper.h"
+#include "Utilities/Serializer.h"
 #include "Shared/SaveStateManager.h"
 #include "Shared/MessageManager.h"
 #include "Shared/Emulator.h"
@@ -20,6 +21,19 @@ SaveStateManager::SaveStateManager(Emulator* emu)
 {
 	_emu = emu;
 	_lastIndex = 1;
+	_stopWriteThread = false;
+	_pendingCount = 0;
+	_savedStateCount = 0;
+}
+
+SaveStateManager::~SaveStateManager()
+{
+	if(_writeThread) {
+		WaitForPendingSaves();
+		_stopWriteThread = true;
+		_writeEvent.Signal();
+		_writeThread->join();
+	}
 }
 
 string SaveStateManager::GetStateFilepath(int stateIndex)
@@ -58,7 +72,31 @@ bool SaveStateManager::LoadState()
 	return LoadState(_lastIndex);
 }
 
-void SaveStateManager::GetSaveStateHeader(ostream &stream)
+void SaveStateManager::CaptureHeader(SaveStateData& data)
+{
+	data.ConsoleType = (uint32_t)_emu->GetConsoleType();
+
+	RomInfo romInfo = _emu->GetRomInfo();
+	data.RomName = FolderUtilities::GetFilename(romInfo.RomFile.GetFileName(), true);
+
+	PpuFrameInfo frame = _emu->GetPpuFrame();
+	data.FrameBuffer.assign(frame.FrameBuffer, frame.FrameBuffer + frame.FrameBufferSize);
+	data.FrameWidth = frame.Width;
+	data.FrameHeight = frame.Height;
+	data.FrameScale = (uint32_t)(_emu->GetVideoDecoder()->GetLastFrameScale() * 100);
+}
+
+void SaveStateManager::CaptureState(SaveStateData& data)
+{
+	//Only copies the data, all compression is done by WriteState
+	CaptureHeader(data);
+
+	std::stringstream stateStream;
+	_emu->Serialize(stateStream, false, 0);
+	data.State = stateStream.str();
+}
+
+void SaveStateManager::WriteHeader(ostream& stream, SaveStateData& data)
 {
 	uint32_t emuVersion = _emu->GetSettings()->GetVersion();
 	uint32_t formatVersion = SaveStateManager::FileFormatVersion;
@@ -66,63 +104,156 @@ void SaveStateManager::GetSaveStateHeader(ostream &stream)
 	WriteValue(stream, emuVersion);
 	WriteValue(stream, formatVersion);
 
-	WriteValue(stream, (uint32_t)_emu->GetConsoleType());
+	WriteValue(stream, data.ConsoleType);
 
-	SaveVideoData(stream);
+	SaveVideoData(stream, data);
 
-	RomInfo romInfo = _emu->GetRomInfo();
-	string romName = FolderUtilities::GetFilename(romInfo.RomFile.GetFileName(), true);
-	WriteValue(stream, (uint32_t)romName.size());
-	stream.write(romName.c_str(), romName.size());
+	WriteValue(stream, (uint32_t)data.RomName.size());
+	stream.write(data.RomName.c_str(), data.RomName.size());
+}
+
+void SaveStateManager::WriteState(ostream& stream, SaveStateData& data)
+{
+	WriteHeader(stream, data);
+
+	//The state was captured without compression, compress it now
+	Serializer::CompressSavedData(stream, data.State);
+}
+
+void SaveStateManager::GetSaveStateHeader(ostream &stream)
+{
+	SaveStateData data;
+	CaptureHeader(data);
+	WriteHeader(stream, data);
 }
 
 void SaveStateManager::SaveState(ostream &stream)
 {
-	GetSaveStateHeader(stream);
-	_emu->Serialize(stream, false);
+	SaveStateData data;
+	CaptureState(data);
+	WriteState(stream, data);
 }
 
 bool SaveStateManager::SaveState(string filepath, bool showSuccessMessage)
 {
-	ofstream file(filepath, ios::out | ios::binary);
+	//States saved to a specific file are written on the calling thread, to be able to return the result
+	PendingSaveState save;
+	save.Filepath = filepath;
+	save.ShowSuccessMessage = showSuccessMessage;
+	{
+		auto lock = _emu->AcquireLock();
+		CaptureState(save.Data);
+	}
 
-	if(file) {
-		{
-			auto lock = _emu->AcquireLock();
-			SaveState(file);
+	//Make sure a queued save to the same file can't overwrite this one
+	WaitForPendingSaves();
+	return ProcessPendingSave(save);
+}
+
+void SaveStateManager::SaveState(int stateIndex, bool displayMessage)
+{
+	PendingSaveState save;
+	save.Filepath = SaveStateManager::GetStateFilepath(stateIndex);
+	save.StateIndex = displayMessage ? stateIndex : -1;
+	{
+		auto lock = _emu->AcquireLock();
+		CaptureState(save.Data);
+	}
+	QueueSave(save);
+}
+
+void SaveStateManager::QueueSave(PendingSaveState& save)
+{
+	{
+		auto lock = _pendingLock.AcquireSafe();
+		_pendingSaves.push_back(std::move(save));
+		_pendingCount++;
+
+		if(!_writeThread) {
+			_writeThread.reset(new std::thread([=]() {
+				while(!_stopWriteThread) {
+					_writeEvent.Wait();
+
+					while(true) {
+						PendingSaveState pending;
+						{
+							auto lock = _pendingLock.AcquireSafe();
+							if(_pendingSaves.empty()) {
+								break;
+							}
+							pending = std::move(_pendingSaves.front());
+							_pendingSaves.pop_front();
+						}
+
+						ProcessPendingSave(pending);
+						_pendingCount--;
+						_writeDoneEvent.Signal();
+					}
+				}
+			}));
 		}
+	}
+	_writeEvent.Signal();
+}
+
+bool SaveStateManager::ProcessPendingSave(PendingSaveState& save)
+{
+	std::stringstream stream;
+	WriteState(stream, save.Data);
+
+	//Write to a temporary file first, to avoid leaving a truncated state behind if the write fails
+	string tmpFilepath = save.Filepath + ".tmp";
+	ofstream file(tmpFilepath, ios::out | ios::binary);
+	if(file) {
+		string data = stream.str();
+		file.write(data.c_str(), data.size());
 		file.close();
+	}
 
-		_emu->ProcessEvent(EventType::StateSaved);
-		if(showSuccessMessage) {
-			MessageManager::DisplayMessage("SaveStates", "SaveStateSavedFile", filepath);
-		}
-		return true;
+	if(!file || !FolderUtilities::RenameFile(tmpFilepath, save.Filepath)) {
+		std::remove(tmpFilepath.c_str());
+		MessageManager::Log("[SaveState] Could not write file: " + save.Filepath);
+		MessageManager::DisplayMessage("SaveStates", "CouldNotWriteToFile", save.Filepath);
+		return false;
 	}
-	return false;
+
+	_savedStateCount++;
+	if(save.StateIndex >= 0) {
+		MessageManager::DisplayMessage("SaveStates", "SaveStateSaved", std::to_string(save.StateIndex));
+	} else if(save.ShowSuccessMessage) {
+		MessageManager::DisplayMessage("SaveStates", "SaveStateSavedFile", save.Filepath);
+	}
+	return true;
 }
 
-void SaveStateManager::SaveState(int stateIndex, bool displayMessage)
+void SaveStateManager::ProcessSavedStates()
 {
-	string filepath = SaveStateManager::GetStateFilepath(stateIndex);
-	if(SaveState(filepath, false)) {
-		if(displayMessage) {
-			MessageManager::DisplayMessage("SaveStates", "SaveStateSaved", std::to_string(stateIndex));
+	if(_savedStateCount > 0) {
+		uint32_t count = _savedStateCount.exchange(0);
+		for(uint32_t i = 0; i < count; i++) {
+			_emu->ProcessEvent(EventType::StateSaved);
 		}
 	}
 }
 
-void SaveStateManager::SaveVideoData(ostream& stream)
+void SaveStateManager::WaitForPendingSaves()
 {
-	PpuFrameInfo frame = _emu->GetPpuFrame();
-	WriteValue(stream, frame.FrameBufferSize);
-	WriteValue(stream, frame.Width);
-	WriteValue(stream, frame.Height);
-	WriteValue(stream, (uint32_t)(_emu->GetVideoDecoder()->GetLastFrameScale() * 100));
+	while(_pendingCount > 0) {
+		_writeDoneEvent.Wait(50);
+	}
+}
+
+void SaveStateManager::SaveVideoData(ostream& stream, SaveStateData& data)
+{
+	uint32_t frameBufferSize = (uint32_t)data.FrameBuffer.size();
+	WriteValue(stream, frameBufferSize);
+	WriteValue(stream, data.FrameWidth);
+	WriteValue(stream, data.FrameHeight);
+	WriteValue(stream, data.FrameScale);
 
-	unsigned long compressedSize = compressBound(frame.FrameBufferSize);
+	unsigned long compressedSize = compressBound(frameBufferSize);
 	vector<uint8_t> compressedData(compressedSize, 0);
-	compress2(compressedData.data(), &compressedSize, (const unsigned char*)frame.FrameBuffer, frame.FrameBufferSize, MZ_DEFAULT_LEVEL);
+	compress2(compressedData.data(), &compressedSize, data.FrameBuffer.data(), frameBufferSize, MZ_DEFAULT_LEVEL);
 
 	WriteValue(stream, (uint32_t)compressedSize);
 	stream.write((char*)compressedData.data(), (uint32_t)compressedSize);
@@ -220,6 +351,8 @@ bool SaveStateManager::LoadState(istream &stream)
 
 bool SaveStateManager::LoadState(string filepath, bool showSuccessMessage)
 {
+	WaitForPendingSaves();
+
 	ifstream file(filepath, ios::in | ios::binary);
 	bool result = false;
 
@@ -264,12 +397,15 @@ void SaveStateManager::SaveRecentGame(string romName, string romPath, string pat
 	ZipWriter writer;
 	writer.Initialize(FolderUtilities::CombinePath(FolderUtilities::GetRecentGamesFolder(), filename));
 
-	std::stringstream pngStream;
-	_emu->GetVideoDecoder()->TakeScreenshot(pngStream);
-	writer.AddFile(pngStream, "Screenshot.png");
+	//The screenshot is encoded while the save state is being saved
+	std::future<string> screenshot = _emu->GetVideoDecoder()->TakeScreenshotAsync();
 
 	std::stringstream stateStream;
 	SaveStateManager::SaveState(stateStream);
+
+	std::stringstream pngStream;
+	pngStream << screenshot.get();
+	writer.AddFile(pngStream, "Screenshot.png");
 	writer.AddFile(stateStream, "Savestate.mss");
 
 	std::stringstream romInfoStream;
@@ -314,6 +450,8 @@ void SaveStateManager::LoadRecentGame(string filename, bool resetGame)
 
 int32_t SaveStateManager::GetSaveStatePreview(string saveStatePath, uint8_t* pngData)
 {
+	WaitForPendingSaves();
+
 	ifstream stream(saveStatePath, ios::binary);
 
 	if(!stream) {
@@ -1,9 +1,34 @@
 #pragma once
 #include "pch.h"
+#include "Utilities/SimpleLock.h"
+#include "Utilities/AutoResetEvent.h"
 
 class Emulator;
 struct RenderedFrame;
 
+//Copy of everything needed to write a save state, taken while the emulation is paused
+struct SaveStateData
+{
+	uint32_t ConsoleType = 0;
+	string RomName;
+
+	vector<uint8_t> FrameBuffer;
+	uint32_t FrameWidth = 0;
+	uint32_t FrameHeight = 0;
+	uint32_t FrameScale = 0;
+
+	//Uncompressed serializer output
+	string State;
+};
+
+struct PendingSaveState
+{
+	SaveStateData Data;
+	string Filepath;
+	int StateIndex = -1;
+	bool ShowSuccessMessage = false;
+};
+
 class SaveStateManager
 {
 private:
@@ -12,19 +37,45 @@ private:
 	atomic<uint32_t> _lastIndex;
 	Emulator* _emu;
 
+	//Save states written to disk are compressed and written on a separate thread
+	unique_ptr<std::thread> _writeThread;
+	deque<PendingSaveState> _pendingSaves;
+	SimpleLock _pendingLock;
+	AutoResetEvent _writeEvent;
+	AutoResetEvent _writeDoneEvent;
+	atomic<bool> _stopWriteThread;
+	atomic<uint32_t> _pendingCount;
+
+	//Number of saves written since the last call to ProcessSavedStates (the StateSaved event is raised on the emulation thread)
+	atomic<uint32_t> _savedStateCount;
+
 	string GetStateFilepath(int stateIndex);
-	void SaveVideoData(ostream& stream);
+	void CaptureHeader(SaveStateData& data);
+	void CaptureState(SaveStateData& data);
+	void WriteHeader(ostream& stream, SaveStateData& data);
+	void WriteState(ostream& stream, SaveStateData& data);
+	void SaveVideoData(ostream& stream, SaveStateData& data);
 	bool GetVideoData(vector<uint8_t>& out, RenderedFrame& frame, istream& stream);
 
 	void WriteValue(ostream& stream, uint32_t value);
 	uint32_t ReadValue(istream& stream);
 
+	void QueueSave(PendingSaveState& save);
+	bool ProcessPendingSave(PendingSaveState& save);
+
 public:
 	static constexpr uint32_t FileFormatVersion = 4;
 	static constexpr uint32_t MinimumSupportedVersion = 3;
 	static constexpr uint32_t AutoSaveStateIndex = 11;
 
 	SaveStateManager(Emulator* emu);
+	~SaveStateManager();
+
+	//Blocks until all queued save states have been written to disk
+	void WaitForPendingSaves();
+
+	//Raises the StateSaved event for the states that were written since the last call (called by the emulation thread)
+	void ProcessSavedStates();
 
 	void SaveState();
 	bool LoadState();
@@ -352,6 +352,7 @@ struct EmulationConfig
 	uint32_t RewindSpeed = 100;
 
 	uint32_t RunAheadFrames = 0;
+	bool LowLatencyFramePacing = false;
 };
 
 struct OverscanDimensions
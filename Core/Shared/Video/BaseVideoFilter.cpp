@@ -1,13 +1,8 @@
 #include "pch.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
-#include "Shared/MessageManager.h"
 #include "Shared/Video/BaseVideoFilter.h"
-#include "Shared/Video/RotateFilter.h"
-#include "Shared/Video/ScaleFilter.h"
-#include "Shared/Video/ScanlineFilter.h"
-#include "Utilities/PNGHelper.h"
-#include "Utilities/FolderUtilities.h"
+#include "Shared/Video/VideoFilterThreadPool.h"
 #include "Utilities/NTSC/nes_ntsc.h"
 #include "Utilities/NTSC/snes_ntsc.h"
 
@@ -80,6 +75,15 @@ uint32_t BaseVideoFilter::GetBufferSize()
 	return _bufferSize * sizeof(uint32_t);
 }
 
+void BaseVideoFilter::ProcessRowBands(uint32_t rowCount, const std::function<void(uint32_t startRow, uint32_t endRow)>& job)
+{
+	if(_referenceMode) {
+		job(0, rowCount);
+	} else {
+		_emu->GetVideoFilterThreadPool()->Run(rowCount, job);
+	}
+}
+
 FrameInfo BaseVideoFilter::SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber, uint32_t videoPhase, void* frameData, bool enableOverscan)
 {
 	auto lock = _frameLock.AcquireSafe();
@@ -192,76 +196,17 @@ void BaseVideoFilter::InitNtscFilter(T& ntscSetup)
 	ntscSetup.sharpness = cfg.NtscSharpness;
 }
 
-void BaseVideoFilter::TakeScreenshot(VideoFilterType filterType, string filename, std::stringstream *stream)
-{
-	uint32_t* pngBuffer;
-	FrameInfo frameInfo;
-	uint32_t* frameBuffer = nullptr;
-	{
-		auto lock = _frameLock.AcquireSafe();
-		if(_bufferSize == 0 || !GetOutputBuffer()) {
-			return;
-		}
-
-		frameBuffer = new uint32_t[_bufferSize];
-		memcpy(frameBuffer, GetOutputBuffer(), _bufferSize * sizeof(frameBuffer[0]));
-		frameInfo = _frameInfo;
-	}
-
-	pngBuffer = frameBuffer;
-	
-	uint8_t scale = 1;
-
-	uint32_t screenRotation = _emu->GetSettings()->GetVideoConfig().ScreenRotation;
-	unique_ptr<RotateFilter> rotateFilter(new RotateFilter(screenRotation));
-	if(screenRotation != 0) {
-		pngBuffer = rotateFilter->ApplyFilter(pngBuffer, frameInfo.Width, frameInfo.Height);
-		frameInfo = rotateFilter->GetFrameInfo(frameInfo);
-	}
-
-	unique_ptr<ScaleFilter> scaleFilter = ScaleFilter::GetScaleFilter(filterType);
-	if(scaleFilter) {
-		pngBuffer = scaleFilter->ApplyFilter(pngBuffer, frameInfo.Width, frameInfo.Height);
-		frameInfo = scaleFilter->GetFrameInfo(frameInfo);
-		scale = scaleFilter->GetScale();
-	}
-
-	ScanlineFilter::ApplyFilter(pngBuffer, frameInfo.Width, frameInfo.Height, _emu->GetSettings()->GetVideoConfig().ScanlineIntensity, scale);
-	
-	if(!filename.empty()) {
-		PNGHelper::WritePNG(filename, pngBuffer, frameInfo.Width, frameInfo.Height);
-	} else {
-		PNGHelper::WritePNG(*stream, pngBuffer, frameInfo.Width, frameInfo.Height);
-	}
-
-	delete[] frameBuffer;
-}
-
-void BaseVideoFilter::TakeScreenshot(string romName, VideoFilterType filterType)
+bool BaseVideoFilter::CopyOutputBuffer(vector<uint32_t>& buffer, FrameInfo& frameInfo)
 {
-	string romFilename = FolderUtilities::GetFilename(romName, false);
-
-	int counter = 0;
-	string baseFilename = FolderUtilities::CombinePath(FolderUtilities::GetScreenshotFolder(), romFilename);
-	string ssFilename;
-	while(true) {
-		string counterStr = std::to_string(counter);
-		while(counterStr.length() < 3) {
-			counterStr = "0" + counterStr;
-		}
-		ssFilename = baseFilename + "_" + counterStr + ".png";
-		ifstream file(ssFilename, ios::in);
-		if(file) {
-			file.close();
-		} else {
-			break;
-		}
-		counter++;
+	auto lock = _frameLock.AcquireSafe();
+	if(_bufferSize == 0 || !GetOutputBuffer()) {
+		return false;
 	}
 
-	TakeScreenshot(filterType, ssFilename);
-
-	MessageManager::DisplayMessage("ScreenshotSaved", FolderUtilities::GetFilename(ssFilename, true));
+	buffer.resize(_bufferSize);
+	memcpy(buffer.data(), GetOutputBuffer(), _bufferSize * sizeof(uint32_t));
+	frameInfo = _frameInfo;
+	return true;
 }
 
 template bool BaseVideoFilter::NtscFilterOptionsChanged<nes_ntsc_setup_t>(nes_ntsc_setup_t& ntscSetup);
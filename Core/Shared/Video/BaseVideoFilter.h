@@ -1,5 +1,6 @@
 #pragma once
 #include "pch.h"
+#include <functional>
 #include "Utilities/SimpleLock.h"
 #include "Shared/SettingTypes.h"
 
@@ -15,6 +16,7 @@ private:
 	OverscanDimensions _overscan = {};
 	bool _isOddFrame = false;
 	uint32_t _videoPhase = 0;
+	bool _referenceMode = false;
 
 	void UpdateBufferSize();
 
@@ -35,6 +37,10 @@ protected:
 	bool IsOddFrame();
 	uint32_t GetVideoPhase();
 	uint32_t GetBufferSize();
+
+	//Calls job(startRow, endRow) for bands of rows in parallel, on the emulator's video filter threads
+	void ProcessRowBands(uint32_t rowCount, const std::function<void(uint32_t startRow, uint32_t endRow)>& job);
+	bool IsReferenceMode() { return _referenceMode; }
 	
 	template<typename T> bool NtscFilterOptionsChanged(T& ntscSetup);
 	template<typename T> void InitNtscFilter(T& ntscSetup);
@@ -45,12 +51,14 @@ public:
 
 	uint32_t* GetOutputBuffer();
 	FrameInfo SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber, uint32_t videoPhase, void* frameData, bool enableOverscan = true);
-	void TakeScreenshot(string romName, VideoFilterType filterType);
-	void TakeScreenshot(VideoFilterType filterType, string filename, std::stringstream *stream = nullptr);
+	bool CopyOutputBuffer(vector<uint32_t>& buffer, FrameInfo& frameInfo);
 
 	virtual OverscanDimensions GetOverscan();
 	void SetOverscan(OverscanDimensions dimensions);
 	virtual FrameInfo GetFrameInfo();
 
 	void SetBaseFrameInfo(FrameInfo frameInfo);
+
+	//Processes frames on a single thread with the scalar kernels, used by VideoFilterTest to validate the regular output
+	void SetReferenceMode(bool enabled) { _referenceMode = enabled; }
 };
@@ -6,6 +6,10 @@
 #include "Shared/Emulator.h"
 #include "Shared/RewindManager.h"
 #include "Shared/EmuSettings.h"
+#include "Shared/FrameLimiter.h"
+#include "Shared/DiscSectorCache.h"
+#include "PCE/PceConsole.h"
+#include "PCE/CdRom/PceCdRom.h"
 
 void DebugStats::DisplayStats(Emulator *emu, double lastFrameTime)
 {
@@ -103,4 +107,59 @@ void DebugStats::DisplayStats(Emulator *emu, double lastFrameTime)
 		ss << "   Per min.: " << std::fixed << std::setprecision(2) << (memUsage * 60 * 60 / rewindStats.HistoryDuration) << " MB";
 		hud->DrawString(9, 82, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
 	}
+
+	FramePacingStats pacingStats = emu->GetFramePacingStats();
+	if(pacingStats.PresentedFrameCount > 0) {
+		//The deadline/histogram lines are only available when low latency frame pacing is enabled
+		int height = pacingStats.FrameCount > 0 ? 61 : 25;
+		hud->DrawRectangle(8, 96, 239, height, 0x40000000, true, 1, startFrame);
+		hud->DrawRectangle(8, 96, 239, height, 0xFFFFFF, false, 1, startFrame);
+		hud->DrawString(10, 98, "Frame Pacing", 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+		ss = std::stringstream();
+		ss << "Input latency: " << std::fixed << std::setprecision(2) << pacingStats.InputLatency << " ms";
+		ss << " (" << std::setprecision(1) << pacingStats.MinInputLatency << "-" << pacingStats.MaxInputLatency << ")";
+		hud->DrawString(10, 109, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+	}
+
+	if(pacingStats.PresentedFrameCount > 0 && pacingStats.FrameCount > 0) {
+		uint32_t missCount = 0;
+		for(int i = 0; i < FramePacingStats::BucketCount; i++) {
+			missCount += pacingStats.DeadlineMisses[i];
+		}
+
+		ss = std::stringstream();
+		ss << "Deadline slack: " << std::fixed << std::setprecision(2) << pacingStats.DeadlineSlack << " ms";
+		ss << " - Missed: " << missCount << " (" << std::setprecision(1) << (missCount * 100.0 / pacingStats.FrameCount) << "%)";
+		hud->DrawString(10, 118, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+		hud->DrawString(10, 127, "Histogram (ms):  <.1  <.25  <.5  <1  <2  2+", 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+		auto drawHistogram = [&](int y, string label, uint32_t* buckets) {
+			ss = std::stringstream();
+			ss << label;
+			for(int i = 0; i < FramePacingStats::BucketCount; i++) {
+				ss << " " << buckets[i];
+			}
+			hud->DrawString(10, y, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+		};
+		drawHistogram(136, "Wake-up error:", pacingStats.WakeUpError);
+		drawHistogram(145, "Deadline misses:", pacingStats.DeadlineMisses);
+	}
+
+	shared_ptr<IConsole> console = emu->GetConsole();
+	PceConsole* pce = dynamic_cast<PceConsole*>(console.get());
+	if(pce && pce->GetCdRom()) {
+		int top = pacingStats.PresentedFrameCount > 0 ? (pacingStats.FrameCount > 0 ? 159 : 123) : 96;
+		hud->DrawRectangle(8, top, 239, 25, 0x40000000, true, 1, startFrame);
+		hud->DrawRectangle(8, top, 239, 25, 0xFFFFFF, false, 1, startFrame);
+		hud->DrawString(10, top + 2, "CD-ROM Sector Cache", 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+		DiscSectorCacheStats cdStats = pce->GetCdRom()->GetSectorCacheStats();
+		uint64_t reads = cdStats.Hits + cdStats.Misses;
+		ss = std::stringstream();
+		ss << "Hits: " << cdStats.Hits << " (" << std::fixed << std::setprecision(1) << (reads ? cdStats.Hits * 100.0 / reads : 0.0) << "%)";
+		ss << " - Misses: " << cdStats.Misses << " - Prefetched: " << cdStats.PrefetchedSectors;
+		hud->DrawString(10, top + 13, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+	}
 }
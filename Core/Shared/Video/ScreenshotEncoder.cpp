@@ -0,0 +1,122 @@
+#include "pch.h"
+#include <sstream>
+#include "Shared/Video/ScreenshotEncoder.h"
+#include "Shared/Video/RotateFilter.h"
+#include "Shared/Video/ScaleFilter.h"
+#include "Shared/Video/ScanlineFilter.h"
+
+ScreenshotEncoder::~ScreenshotEncoder()
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_stopThreads = true;
+	}
+	_jobAdded.notify_all();
+
+	//Pending jobs are completed before the threads exit
+	for(std::thread& t : _threads) {
+		t.join();
+	}
+}
+
+vector<uint32_t> ScreenshotEncoder::GetBuffer()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	if(_freeBuffers.empty()) {
+		return {};
+	}
+	vector<uint32_t> buffer = std::move(_freeBuffers.back());
+	_freeBuffers.pop_back();
+	return buffer;
+}
+
+std::future<string> ScreenshotEncoder::Encode(vector<uint32_t>&& frame, FrameInfo frameSize, ScreenshotRequest request)
+{
+	unique_ptr<Job> job(new Job());
+	job->Frame = std::move(frame);
+	job->Size = frameSize;
+	job->Request = std::move(request);
+	std::future<string> result = job->Result.get_future();
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	if(_threads.empty()) {
+		uint32_t threadCount = std::max<uint32_t>(1, std::min<uint32_t>(ScreenshotEncoder::MaxThreads, std::thread::hardware_concurrency()));
+		for(uint32_t i = 0; i < threadCount; i++) {
+			_threads.push_back(std::thread(&ScreenshotEncoder::ProcessJobs, this));
+		}
+	}
+
+	_jobRemoved.wait(lock, [this] { return _jobs.size() < ScreenshotEncoder::MaxPendingJobs; });
+	_jobs.push_back(std::move(job));
+	lock.unlock();
+
+	_jobAdded.notify_one();
+	return result;
+}
+
+void ScreenshotEncoder::ProcessJobs()
+{
+	while(true) {
+		unique_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_jobAdded.wait(lock, [this] { return _stopThreads || !_jobs.empty(); });
+			if(_jobs.empty()) {
+				break;
+			}
+			job = std::move(_jobs.front());
+			_jobs.pop_front();
+		}
+		_jobRemoved.notify_one();
+
+		string pngData = EncodeFrame(job->Frame.data(), job->Size, job->Request);
+		if(job->Request.Callback) {
+			job->Request.Callback(pngData);
+		}
+		job->Result.set_value(std::move(pngData));
+
+		//Keep the frame's buffer to reuse it for the next screenshots
+		std::unique_lock<std::mutex> lock(_mutex);
+		if(_freeBuffers.size() < ScreenshotEncoder::MaxPendingJobs) {
+			_freeBuffers.push_back(std::move(job->Frame));
+		}
+	}
+}
+
+string ScreenshotEncoder::EncodeFrame(uint32_t* frame, FrameInfo frameSize, const ScreenshotRequest& request)
+{
+	uint32_t* pngBuffer = frame;
+	FrameInfo frameInfo = frameSize;
+	uint8_t scale = 1;
+
+	unique_ptr<RotateFilter> rotateFilter(new RotateFilter(request.ScreenRotation));
+	if(request.ScreenRotation != 0) {
+		pngBuffer = rotateFilter->ApplyFilter(pngBuffer, frameInfo.Width, frameInfo.Height);
+		frameInfo = rotateFilter->GetFrameInfo(frameInfo);
+	}
+
+	unique_ptr<ScaleFilter> scaleFilter = ScaleFilter::GetScaleFilter(request.FilterType);
+	if(scaleFilter) {
+		pngBuffer = scaleFilter->ApplyFilter(pngBuffer, frameInfo.Width, frameInfo.Height);
+		frameInfo = scaleFilter->GetFrameInfo(frameInfo);
+		scale = scaleFilter->GetScale();
+	}
+
+	ScanlineFilter::ApplyFilter(pngBuffer, frameInfo.Width, frameInfo.Height, request.ScanlineIntensity, scale);
+
+	std::stringstream stream;
+	if(!PNGHelper::WritePNG(stream, pngBuffer, frameInfo.Width, frameInfo.Height, 24, request.CompressionLevel)) {
+		return "";
+	}
+
+	string pngData = stream.str();
+	if(!request.Filename.empty()) {
+		ofstream file(request.Filename, std::ios::out | std::ios::binary);
+		file.write(pngData.data(), pngData.size());
+		file.close();
+		if(file.fail()) {
+			return "";
+		}
+	}
+	return pngData;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "pch.h"
+#include <future>
+#include <functional>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include "Shared/SettingTypes.h"
+#include "Utilities/PNGHelper.h"
+
+struct ScreenshotRequest
+{
+	VideoFilterType FilterType = VideoFilterType::None;
+	uint32_t ScreenRotation = 0;
+	double ScanlineIntensity = 0;
+	int CompressionLevel = PNGHelper::DefaultCompressionLevel;
+
+	//When set, the PNG file is also written to this path (the request fails if the file can't be written)
+	string Filename;
+
+	//Called on the encoder's thread with the PNG data (empty on failure)
+	std::function<void(const string& pngData)> Callback;
+};
+
+//Applies the screenshot filters (rotation, scale filter, scanlines) and encodes frames to PNG on background threads
+class ScreenshotEncoder
+{
+private:
+	static constexpr uint32_t MaxThreads = 2;
+	static constexpr uint32_t MaxPendingJobs = 8;
+
+	struct Job
+	{
+		vector<uint32_t> Frame;
+		FrameInfo Size;
+		ScreenshotRequest Request;
+		std::promise<string> Result;
+	};
+
+	vector<std::thread> _threads;
+	std::deque<unique_ptr<Job>> _jobs;
+	vector<vector<uint32_t>> _freeBuffers;
+	std::mutex _mutex;
+	std::condition_variable _jobAdded;
+	std::condition_variable _jobRemoved;
+	bool _stopThreads = false;
+
+	void ProcessJobs();
+
+public:
+	ScreenshotEncoder() = default;
+	~ScreenshotEncoder();
+
+	//Returns a (pooled) buffer for the caller to copy the frame into before calling Encode
+	vector<uint32_t> GetBuffer();
+
+	//Queues the frame for encoding - blocks while too many frames are already waiting to be encoded (e.g when capturing every frame)
+	std::future<string> Encode(vector<uint32_t>&& frame, FrameInfo frameSize, ScreenshotRequest request);
+
+	//Encodes the frame on the calling thread
+	static string EncodeFrame(uint32_t* frame, FrameInfo frameSize, const ScreenshotRequest& request);
+};
@@ -11,6 +11,8 @@
 #include "Shared/Video/ScaleFilter.h"
 #include "Shared/Video/RotateFilter.h"
 #include "Shared/Video/ScanlineFilter.h"
+#include "Shared/MessageManager.h"
+#include "Utilities/FolderUtilities.h"
 #include "Shared/Video/DebugHud.h"
 #include "Shared/InputHud.h"
 #include "Shared/RenderedFrame.h"
@@ -133,6 +135,7 @@ void VideoDecoder::DecodeFrame(bool forRewind)
 	}
 
 	RenderedFrame convertedFrame((void*)outputBuffer, frameSize.Width, frameSize.Height, _frame.Scale, _frame.FrameNumber, _frame.InputData);
+	convertedFrame.InputTimestamp = _frame.InputTimestamp;
 
 	double aspectRatio = _emu->GetSettings()->GetAspectRatio(_emu->GetRegion(), _baseFrameSize);
 	if(frameSize.Height != _lastFrameSize.Height || frameSize.Width != _lastFrameSize.Width || aspectRatio != _lastAspectRatio) {
@@ -185,6 +188,7 @@ void VideoDecoder::UpdateFrame(RenderedFrame frame, bool sync, bool forRewind)
 	_emu->OnBeforeSendFrame();
 
 	_frame = frame;
+	_frame.InputTimestamp = _emu->GetFrameInputTimestamp();
 	if(sync) {
 		DecodeFrame(forRewind);
 	} else {
@@ -232,16 +236,74 @@ bool VideoDecoder::IsRunning()
 	return _decodeThread != nullptr;
 }
 
+string VideoDecoder::GetScreenshotFilename()
+{
+	string romFilename = FolderUtilities::GetFilename(_emu->GetRomInfo().RomFile.GetFileName(), false);
+
+	int counter = 0;
+	string baseFilename = FolderUtilities::CombinePath(FolderUtilities::GetScreenshotFolder(), romFilename);
+	string ssFilename;
+	while(true) {
+		string counterStr = std::to_string(counter);
+		while(counterStr.length() < 3) {
+			counterStr = "0" + counterStr;
+		}
+		ssFilename = baseFilename + "_" + counterStr + ".png";
+		ifstream file(ssFilename, ios::in);
+		if(file) {
+			file.close();
+		} else {
+			break;
+		}
+		counter++;
+	}
+
+	//Create the file right away, so the next screenshot doesn't pick the same name while this one is being encoded
+	ofstream file(ssFilename, ios::out | ios::binary);
+	return ssFilename;
+}
+
 void VideoDecoder::TakeScreenshot()
 {
 	if(_videoFilter) {
-		_videoFilter->TakeScreenshot(_emu->GetRomInfo().RomFile.GetFileName(), _videoFilterType);
+		string ssFilename = GetScreenshotFilename();
+		TakeScreenshotAsync(ssFilename, PNGHelper::DefaultCompressionLevel, [=](const string& pngData) {
+			if(!pngData.empty()) {
+				MessageManager::DisplayMessage("ScreenshotSaved", FolderUtilities::GetFilename(ssFilename, true));
+			} else {
+				//Remove the placeholder file created by GetScreenshotFilename (or the partially written screenshot)
+				std::remove(ssFilename.c_str());
+				MessageManager::DisplayMessage("Error", "CouldNotWriteToFile", FolderUtilities::GetFilename(ssFilename, true));
+			}
+		});
 	}
 }
 
 void VideoDecoder::TakeScreenshot(std::stringstream &stream)
 {
-	if(_videoFilter) {
-		_videoFilter->TakeScreenshot(_videoFilterType, "", &stream);
+	stream << TakeScreenshotAsync().get();
+}
+
+std::future<string> VideoDecoder::TakeScreenshotAsync(string filename, int compressionLevel, std::function<void(const string&)> callback)
+{
+	ScreenshotRequest request;
+	request.FilterType = _videoFilterType;
+	request.ScreenRotation = _emu->GetSettings()->GetVideoConfig().ScreenRotation;
+	request.ScanlineIntensity = _emu->GetSettings()->GetVideoConfig().ScanlineIntensity;
+	request.CompressionLevel = compressionLevel;
+	request.Filename = filename;
+	request.Callback = callback;
+
+	vector<uint32_t> frame = _screenshotEncoder.GetBuffer();
+	FrameInfo frameInfo = {};
+	if(!_videoFilter || !_videoFilter->CopyOutputBuffer(frame, frameInfo)) {
+		std::promise<string> noScreenshot;
+		noScreenshot.set_value("");
+		if(callback) {
+			callback("");
+		}
+		return noScreenshot.get_future();
 	}
+
+	return _screenshotEncoder.Encode(std::move(frame), frameInfo, request);
 }
@@ -4,6 +4,7 @@
 #include "Utilities/AutoResetEvent.h"
 #include "Shared/SettingTypes.h"
 #include "Shared/RenderedFrame.h"
+#include "Shared/Video/ScreenshotEncoder.h"
 
 class BaseVideoFilter;
 class ScaleFilter;
@@ -39,7 +40,10 @@ private:
 	unique_ptr<ScaleFilter> _scaleFilter;
 	unique_ptr<RotateFilter> _rotateFilter;
 
+	ScreenshotEncoder _screenshotEncoder;
+
 	void UpdateVideoFilter();
+	string GetScreenshotFilename();
 
 	void DecodeThread();
 
@@ -52,6 +56,9 @@ public:
 	void DecodeFrame(bool synchronous = false);
 	void TakeScreenshot();
 	void TakeScreenshot(std::stringstream &stream);
+
+	//Copies the current frame and returns immediately - filtering/PNG encoding is done on a background thread
+	std::future<string> TakeScreenshotAsync(string filename = "", int compressionLevel = PNGHelper::DefaultCompressionLevel, std::function<void(const string&)> callback = {});
 	
 	void ForceFilterUpdate() { _forceFilterUpdate = true; }
 
@@ -0,0 +1,159 @@
+#include "pch.h"
+#include "Shared/Video/VideoFilterKernels.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define VIDEO_KERNELS_SSE2
+	#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+	#define VIDEO_KERNELS_NEON
+	#include <arm_neon.h>
+#endif
+
+#ifdef VIDEO_KERNELS_SSE2
+static __m128i MultiplyLow32(__m128i a, __m128i b)
+{
+	//SSE2 has no 32-bit multiply (_mm_mullo_epi32 is SSE4.1), multiply the even and odd lanes separately
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+#endif
+
+void VideoFilterKernels::ConvertPixels(const uint16_t* in, uint32_t* out, uint32_t count, const uint32_t* palette, uint16_t indexMask)
+{
+	//Palette lookups are done with scalar loads - AVX2 gathers only save ~0.04ms per frame,
+	//and are much slower on CPUs with the Gather Data Sampling (Downfall) microcode mitigation
+	for(uint32_t i = 0; i < count; i++) {
+		out[i] = palette[in[i] & indexMask];
+	}
+}
+
+void VideoFilterKernels::BlendPixels(uint32_t* buffer, uint32_t count)
+{
+	if(count == 0) {
+		return;
+	}
+
+	//Each pixel only depends on itself and the next (not yet modified) pixel, so blocks can be processed front to back
+	uint32_t i = 0;
+#if defined(VIDEO_KERNELS_SSE2)
+	__m128i mask = _mm_set1_epi32((int)0xfffefefe);
+	for(; i + 5 <= count; i += 4) {
+		__m128i a = _mm_loadu_si128((__m128i*)(buffer + i));
+		__m128i b = _mm_loadu_si128((__m128i*)(buffer + i + 1));
+		__m128i result = _mm_add_epi32(_mm_srli_epi32(_mm_and_si128(_mm_xor_si128(a, b), mask), 1), _mm_and_si128(a, b));
+		_mm_storeu_si128((__m128i*)(buffer + i), result);
+	}
+#elif defined(VIDEO_KERNELS_NEON)
+	uint32x4_t mask = vdupq_n_u32(0xfffefefe);
+	for(; i + 5 <= count; i += 4) {
+		uint32x4_t a = vld1q_u32(buffer + i);
+		uint32x4_t b = vld1q_u32(buffer + i + 1);
+		vst1q_u32(buffer + i, vaddq_u32(vshrq_n_u32(vandq_u32(veorq_u32(a, b), mask), 1), vandq_u32(a, b)));
+	}
+#endif
+
+	BlendPixelsScalar(buffer + i, count - i);
+}
+
+void VideoFilterKernels::BlendPixelsScalar(uint32_t* buffer, uint32_t count)
+{
+	for(uint32_t i = 0; i + 1 < count; i++) {
+		buffer[i] = BlendPixel(buffer[i], buffer[i + 1]);
+	}
+}
+
+void VideoFilterKernels::DarkenPixels(uint32_t* buffer, uint32_t count, uint8_t intensity)
+{
+	//x / 255 is computed as (x + 1 + (x >> 8)) >> 8, which gives the same result for all products of 2 bytes
+	uint32_t i = 0;
+#if defined(VIDEO_KERNELS_SSE2)
+	__m128i zero = _mm_setzero_si128();
+	__m128i one = _mm_set1_epi16(1);
+	__m128i factor = _mm_set1_epi16(intensity);
+	__m128i alpha = _mm_set1_epi32((int)0xFF000000);
+	for(; i + 4 <= count; i += 4) {
+		__m128i pixels = _mm_loadu_si128((__m128i*)(buffer + i));
+		__m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), factor);
+		__m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), factor);
+		lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, one), _mm_srli_epi16(lo, 8)), 8);
+		hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, one), _mm_srli_epi16(hi, 8)), 8);
+		_mm_storeu_si128((__m128i*)(buffer + i), _mm_or_si128(_mm_packus_epi16(lo, hi), alpha));
+	}
+#elif defined(VIDEO_KERNELS_NEON)
+	uint8x8_t factor = vdup_n_u8(intensity);
+	uint16x8_t one = vdupq_n_u16(1);
+	uint32x4_t alpha = vdupq_n_u32(0xFF000000);
+	for(; i + 4 <= count; i += 4) {
+		uint8x16_t pixels = vreinterpretq_u8_u32(vld1q_u32(buffer + i));
+		uint16x8_t lo = vmull_u8(vget_low_u8(pixels), factor);
+		uint16x8_t hi = vmull_u8(vget_high_u8(pixels), factor);
+		uint8x8_t loResult = vshrn_n_u16(vaddq_u16(vaddq_u16(lo, one), vshrq_n_u16(lo, 8)), 8);
+		uint8x8_t hiResult = vshrn_n_u16(vaddq_u16(vaddq_u16(hi, one), vshrq_n_u16(hi, 8)), 8);
+		vst1q_u32(buffer + i, vorrq_u32(vreinterpretq_u32_u8(vcombine_u8(loResult, hiResult)), alpha));
+	}
+#endif
+
+	DarkenPixelsScalar(buffer + i, count - i, intensity);
+}
+
+void VideoFilterKernels::DarkenPixelsScalar(uint32_t* buffer, uint32_t count, uint8_t intensity)
+{
+	for(uint32_t i = 0; i < count; i++) {
+		buffer[i] = DarkenPixel(buffer[i], intensity);
+	}
+}
+
+void VideoFilterKernels::YiqToArgb(const int32_t* y, const int32_t* i, const int32_t* q, uint32_t* out, uint32_t count, const YiqToRgbCoefficients& c)
+{
+	//The vectorized versions shift instead of dividing by 65536 - both only differ for negative values, which are clamped to 0 either way
+	uint32_t n = 0;
+#if defined(VIDEO_KERNELS_SSE2)
+	__m128i yFactor = _mm_set1_epi32(c.Y);
+	__m128i ir = _mm_set1_epi32(c.IR), ig = _mm_set1_epi32(c.IG), ib = _mm_set1_epi32(c.IB);
+	__m128i qr = _mm_set1_epi32(c.QR), qg = _mm_set1_epi32(c.QG), qb = _mm_set1_epi32(c.QB);
+	__m128i alpha = _mm_set1_epi32(0xFF);
+	for(; n + 4 <= count; n += 4) {
+		__m128i ys = MultiplyLow32(_mm_loadu_si128((__m128i*)(y + n)), yFactor);
+		__m128i is = _mm_loadu_si128((__m128i*)(i + n));
+		__m128i qs = _mm_loadu_si128((__m128i*)(q + n));
+		__m128i r = _mm_srai_epi32(_mm_add_epi32(ys, _mm_add_epi32(MultiplyLow32(is, ir), MultiplyLow32(qs, qr))), 16);
+		__m128i g = _mm_srai_epi32(_mm_add_epi32(ys, _mm_add_epi32(MultiplyLow32(is, ig), MultiplyLow32(qs, qg))), 16);
+		__m128i b = _mm_srai_epi32(_mm_add_epi32(ys, _mm_add_epi32(MultiplyLow32(is, ib), MultiplyLow32(qs, qb))), 16);
+
+		//Saturating packs clamp to 0-255 - bytes are in b0-b3, g0-g3, r0-r3, a0-a3 order, then interleaved into BGRA pixels
+		__m128i channels = _mm_packus_epi16(_mm_packs_epi32(b, g), _mm_packs_epi32(r, alpha));
+		__m128i bg = _mm_unpacklo_epi8(channels, _mm_srli_si128(channels, 4));
+		__m128i ra = _mm_unpacklo_epi8(_mm_srli_si128(channels, 8), _mm_srli_si128(channels, 12));
+		_mm_storeu_si128((__m128i*)(out + n), _mm_unpacklo_epi16(bg, ra));
+	}
+#elif defined(VIDEO_KERNELS_NEON)
+	int32x4_t zero = vdupq_n_s32(0);
+	int32x4_t max = vdupq_n_s32(255);
+	uint32x4_t alpha = vdupq_n_u32(0xFF000000);
+	for(; n + 4 <= count; n += 4) {
+		int32x4_t ys = vmulq_n_s32(vld1q_s32(y + n), c.Y);
+		int32x4_t is = vld1q_s32(i + n);
+		int32x4_t qs = vld1q_s32(q + n);
+		int32x4_t r = vshrq_n_s32(vmlaq_n_s32(vmlaq_n_s32(ys, is, c.IR), qs, c.QR), 16);
+		int32x4_t g = vshrq_n_s32(vmlaq_n_s32(vmlaq_n_s32(ys, is, c.IG), qs, c.QG), 16);
+		int32x4_t b = vshrq_n_s32(vmlaq_n_s32(vmlaq_n_s32(ys, is, c.IB), qs, c.QB), 16);
+		uint32x4_t ur = vreinterpretq_u32_s32(vminq_s32(vmaxq_s32(r, zero), max));
+		uint32x4_t ug = vreinterpretq_u32_s32(vminq_s32(vmaxq_s32(g, zero), max));
+		uint32x4_t ub = vreinterpretq_u32_s32(vminq_s32(vmaxq_s32(b, zero), max));
+		vst1q_u32(out + n, vorrq_u32(vorrq_u32(alpha, vshlq_n_u32(ur, 16)), vorrq_u32(vshlq_n_u32(ug, 8), ub)));
+	}
+#endif
+
+	YiqToArgbScalar(y + n, i + n, q + n, out + n, count - n, c);
+}
+
+void VideoFilterKernels::YiqToArgbScalar(const int32_t* y, const int32_t* i, const int32_t* q, uint32_t* out, uint32_t count, const YiqToRgbCoefficients& c)
+{
+	for(uint32_t n = 0; n < count; n++) {
+		int r = std::min(255, std::max(0, (y[n] * c.Y + i[n] * c.IR + q[n] * c.QR) / 65536));
+		int g = std::min(255, std::max(0, (y[n] * c.Y + i[n] * c.IG + q[n] * c.QG) / 65536));
+		int b = std::min(255, std::max(0, (y[n] * c.Y + i[n] * c.IB + q[n] * c.QB) / 65536));
+		out[n] = 0xFF000000 | (r << 16) | (g << 8) | b;
+	}
+}
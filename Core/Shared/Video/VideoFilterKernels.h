@@ -0,0 +1,49 @@
+#pragma once
+#include "pch.h"
+
+struct YiqToRgbCoefficients
+{
+	int32_t Y;
+	int32_t IR;
+	int32_t IG;
+	int32_t IB;
+	int32_t QR;
+	int32_t QG;
+	int32_t QB;
+};
+
+//Per-row pixel conversion kernels shared by the video filters (vectorized when the CPU supports it)
+class VideoFilterKernels
+{
+public:
+	//out[i] = palette[in[i] & indexMask]
+	static void ConvertPixels(const uint16_t* in, uint32_t* out, uint32_t count, const uint32_t* palette, uint16_t indexMask);
+
+	//buffer[i] = average of buffer[i] and buffer[i + 1] (the last pixel is left as is)
+	static void BlendPixels(uint32_t* buffer, uint32_t count);
+
+	//Multiplies each color channel by intensity/255 (and sets alpha to 0xFF)
+	static void DarkenPixels(uint32_t* buffer, uint32_t count, uint8_t intensity);
+
+	//out[n] = ARGB color for (y[n], i[n], q[n]), each channel being clamp((y*Y + i*I + q*Q) / 65536, 0, 255)
+	static void YiqToArgb(const int32_t* y, const int32_t* i, const int32_t* q, uint32_t* out, uint32_t count, const YiqToRgbCoefficients& coefficients);
+
+	//Scalar versions, used for the remaining pixels of each row (and as a reference by VideoFilterTest)
+	static void BlendPixelsScalar(uint32_t* buffer, uint32_t count);
+	static void DarkenPixelsScalar(uint32_t* buffer, uint32_t count, uint8_t intensity);
+	static void YiqToArgbScalar(const int32_t* y, const int32_t* i, const int32_t* q, uint32_t* out, uint32_t count, const YiqToRgbCoefficients& coefficients);
+
+	static uint32_t BlendPixel(uint32_t a, uint32_t b)
+	{
+		return ((((a) ^ (b)) & 0xfffefefe) >> 1) + ((a) & (b));
+	}
+
+	static uint32_t DarkenPixel(uint32_t argb, uint8_t intensity)
+	{
+		uint8_t r = ((argb & 0xFF0000) >> 16) * intensity / 255;
+		uint8_t g = ((argb & 0xFF00) >> 8) * intensity / 255;
+		uint8_t b = (argb & 0xFF) * intensity / 255;
+
+		return 0xFF000000 | (r << 16) | (g << 8) | b;
+	}
+};
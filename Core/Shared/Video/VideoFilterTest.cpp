@@ -0,0 +1,375 @@
+#include "pch.h"
+#include "Shared/Video/VideoFilterTest.h"
+#include "Shared/Video/VideoFilterKernels.h"
+#include "Shared/Video/BaseVideoFilter.h"
+#include "Shared/Video/VideoFilterThreadPool.h"
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/MessageManager.h"
+#include "NES/NesNtscFilter.h"
+#include "NES/BisqwitNtscFilter.h"
+#include "SNES/SnesNtscFilter.h"
+#include "PCE/PceNtscFilter.h"
+#include "PCE/PceConstants.h"
+#include "Utilities/Timer.h"
+
+void VideoFilterTest::LogMismatch(const char* kernel, uint32_t count, uint32_t offset, uint32_t index, uint32_t expected, uint32_t actual)
+{
+	_errorCount++;
+	if(_errorCount <= VideoFilterTest::MaxLoggedErrors) {
+		std::stringstream ss;
+		ss << "[VideoFilterTest] " << kernel << " mismatch (count: " << count << ", offset: " << offset << ", pixel: " << index << ")";
+		ss << " - expected $" << std::hex << std::uppercase << expected << ", got $" << actual;
+		MessageManager::Log(ss.str());
+	}
+}
+
+void VideoFilterTest::CompareBlendPixels(std::mt19937& rng, uint32_t count, uint32_t offset)
+{
+	vector<uint32_t> expected(count + offset);
+	for(uint32_t& pixel : expected) {
+		pixel = rng();
+	}
+	vector<uint32_t> actual = expected;
+
+	VideoFilterKernels::BlendPixelsScalar(expected.data() + offset, count);
+	VideoFilterKernels::BlendPixels(actual.data() + offset, count);
+
+	for(uint32_t i = 0; i < count + offset; i++) {
+		if(expected[i] != actual[i]) {
+			LogMismatch("BlendPixels", count, offset, i, expected[i], actual[i]);
+		}
+	}
+}
+
+void VideoFilterTest::CompareDarkenPixels(std::mt19937& rng, uint32_t count, uint32_t offset, uint8_t intensity)
+{
+	vector<uint32_t> expected(count + offset);
+	for(uint32_t& pixel : expected) {
+		pixel = rng();
+	}
+	vector<uint32_t> actual = expected;
+
+	VideoFilterKernels::DarkenPixelsScalar(expected.data() + offset, count, intensity);
+	VideoFilterKernels::DarkenPixels(actual.data() + offset, count, intensity);
+
+	for(uint32_t i = 0; i < count + offset; i++) {
+		if(expected[i] != actual[i]) {
+			LogMismatch("DarkenPixels", count, offset, i, expected[i], actual[i]);
+		}
+	}
+}
+
+void VideoFilterTest::CompareYiqToArgb(std::mt19937& rng, uint32_t count, uint32_t offset)
+{
+	//Coefficients and inputs are small enough that y*Y + i*I + q*Q can't overflow, but large enough to
+	//produce values well outside of the 0-255 range (to check clamping)
+	std::uniform_int_distribution<int32_t> coefficient(-(1 << 12), 1 << 12);
+	std::uniform_int_distribution<int32_t> value(-(1 << 17), 1 << 17);
+
+	YiqToRgbCoefficients c = { coefficient(rng), coefficient(rng), coefficient(rng), coefficient(rng), coefficient(rng), coefficient(rng), coefficient(rng) };
+	vector<int32_t> y(count + offset), i(count + offset), q(count + offset);
+	for(uint32_t n = 0; n < count + offset; n++) {
+		y[n] = value(rng);
+		i[n] = value(rng);
+		q[n] = value(rng);
+	}
+
+	vector<uint32_t> expected(count + offset, 0);
+	vector<uint32_t> actual(count + offset, 0);
+	VideoFilterKernels::YiqToArgbScalar(y.data() + offset, i.data() + offset, q.data() + offset, expected.data() + offset, count, c);
+	VideoFilterKernels::YiqToArgb(y.data() + offset, i.data() + offset, q.data() + offset, actual.data() + offset, count, c);
+
+	for(uint32_t n = 0; n < count + offset; n++) {
+		if(expected[n] != actual[n]) {
+			LogMismatch("YiqToArgb", count, offset, n, expected[n], actual[n]);
+		}
+	}
+}
+
+RomTestResult VideoFilterTest::RunKernelTest()
+{
+	_errorCount = 0;
+
+	//Fixed seed, so that failures can be reproduced
+	std::mt19937 rng(VideoFilterTest::RandomSeed);
+
+	vector<uint32_t> counts;
+	for(uint32_t count = 0; count <= 64; count++) {
+		counts.push_back(count);
+	}
+	for(ScreenSize& size : GetBenchmarkSizes()) {
+		counts.push_back(size.Width);
+	}
+
+	for(uint32_t count : counts) {
+		for(uint32_t offset = 0; offset < 4; offset++) {
+			CompareBlendPixels(rng, count, offset);
+			for(uint8_t intensity : { 0, 1, 127, 128, 254, 255 }) {
+				CompareDarkenPixels(rng, count, offset, intensity);
+			}
+			CompareDarkenPixels(rng, count, offset, (uint8_t)rng());
+			CompareYiqToArgb(rng, count, offset);
+		}
+	}
+
+	MessageManager::Log("[VideoFilterTest] Kernel test: " + (_errorCount ? std::to_string(_errorCount) + " mismatching pixel(s)" : string("passed")));
+
+	RomTestResult result = {};
+	result.State = _errorCount ? RomTestState::Failed : RomTestState::Passed;
+	result.ErrorCode = (int32_t)_errorCount;
+	return result;
+}
+
+vector<VideoFilterTest::ScreenSize> VideoFilterTest::GetBenchmarkSizes()
+{
+	return {
+		{ "Game Boy", 160, 144 },
+		{ "NES/SNES", 256, 240 },
+		{ "SNES hi-res", 512, 478 },
+		{ "NES NTSC", 602, 480 },
+		{ "4x", 1024, 960 }
+	};
+}
+
+void VideoFilterTest::RunKernelBenchmark()
+{
+	constexpr int FrameCount = 100;
+
+	std::mt19937 rng(VideoFilterTest::RandomSeed);
+	std::uniform_int_distribution<int32_t> value(-(1 << 17), 1 << 17);
+	YiqToRgbCoefficients c = { 1000, 2000, 100, -1000, 1000, -600, 1600 };
+
+	MessageManager::Log("[VideoFilterTest] Kernel benchmark - average time per frame, vectorized vs scalar (" + std::to_string(FrameCount) + " frames)");
+
+	for(ScreenSize& size : GetBenchmarkSizes()) {
+		uint32_t pixelCount = size.Width * size.Height;
+		vector<uint32_t> pixels(pixelCount);
+		vector<int32_t> y(pixelCount), i(pixelCount), q(pixelCount);
+		for(uint32_t n = 0; n < pixelCount; n++) {
+			pixels[n] = rng();
+			y[n] = value(rng);
+			i[n] = value(rng);
+			q[n] = value(rng);
+		}
+
+		//Each kernel is called once per row, as the filters do
+		auto measure = [&](auto processRow) {
+			processRow(0);
+			Timer timer;
+			for(int frame = 0; frame < FrameCount; frame++) {
+				for(uint32_t row = 0; row < size.Height; row++) {
+					processRow(row * size.Width);
+				}
+			}
+			return timer.GetElapsedMS() / FrameCount;
+		};
+
+		auto log = [&](const char* kernel, double simdTime, double scalarTime) {
+			std::stringstream ss;
+			ss << "[VideoFilterTest] " << size.Name << " (" << size.Width << "x" << size.Height << ") - " << kernel << ": ";
+			ss << std::fixed << std::setprecision(3) << simdTime << " ms (scalar: " << scalarTime << " ms, ";
+			ss << std::setprecision(2) << (simdTime > 0 ? scalarTime / simdTime : 0.0) << "x)";
+			MessageManager::Log(ss.str());
+		};
+
+		log("BlendPixels",
+			measure([&](uint32_t start) { VideoFilterKernels::BlendPixels(pixels.data() + start, size.Width); }),
+			measure([&](uint32_t start) { VideoFilterKernels::BlendPixelsScalar(pixels.data() + start, size.Width); })
+		);
+
+		log("DarkenPixels",
+			measure([&](uint32_t start) { VideoFilterKernels::DarkenPixels(pixels.data() + start, size.Width, 200); }),
+			measure([&](uint32_t start) { VideoFilterKernels::DarkenPixelsScalar(pixels.data() + start, size.Width, 200); })
+		);
+
+		log("YiqToArgb",
+			measure([&](uint32_t start) { VideoFilterKernels::YiqToArgb(y.data() + start, i.data() + start, q.data() + start, pixels.data() + start, size.Width, c); }),
+			measure([&](uint32_t start) { VideoFilterKernels::YiqToArgbScalar(y.data() + start, i.data() + start, q.data() + start, pixels.data() + start, size.Width, c); })
+		);
+	}
+}
+
+void VideoFilterTest::LogFilterMismatch(const char* filter, uint32_t frameNumber, uint32_t x, uint32_t y, uint32_t expected, uint32_t actual)
+{
+	_errorCount++;
+	if(_errorCount <= VideoFilterTest::MaxLoggedErrors) {
+		std::stringstream ss;
+		ss << "[VideoFilterTest] " << filter << " mismatch (frame: " << frameNumber << ", x: " << x << ", y: " << y << ")";
+		ss << " - expected $" << std::hex << std::uppercase << expected << ", got $" << actual;
+		MessageManager::Log(ss.str());
+	}
+}
+
+vector<VideoFilterTest::NtscFilterTestCase> VideoFilterTest::GetNtscFilterTestCases()
+{
+	auto randomPixels = [](uint16_t mask) {
+		return [=](std::mt19937& rng, vector<uint16_t>& frame) {
+			for(uint16_t& pixel : frame) {
+				pixel = rng() & mask;
+			}
+		};
+	};
+
+	//PC Engine frames are followed by the VCE clock divider used for each row (the filter uses a 4x scale when they don't all match)
+	auto pceFrame = [](bool mixedDividers) {
+		return [=](std::mt19937& rng, vector<uint16_t>& frame) {
+			constexpr uint32_t clockDividerOffset = PceConstants::MaxScreenWidth * PceConstants::ScreenHeight;
+			for(uint32_t i = 0; i < clockDividerOffset; i++) {
+				frame[i] = rng() & 0x1FF;
+			}
+			for(uint32_t i = 0; i < PceConstants::ScreenHeight; i++) {
+				frame[clockDividerOffset + i] = mixedDividers ? (2 + rng() % 3) : 4;
+			}
+		};
+	};
+
+	auto bisqwitScale = [](NtscBisqwitFilterScale scale) {
+		return [=](EmuSettings* settings) {
+			settings->GetVideoConfig().NtscScale = scale;
+		};
+	};
+
+	auto nesNtsc = [](Emulator* emu) -> BaseVideoFilter* { return new NesNtscFilter(emu); };
+	auto bisqwit = [](Emulator* emu) -> BaseVideoFilter* { return new BisqwitNtscFilter(emu); };
+	auto snesNtsc = [](Emulator* emu) -> BaseVideoFilter* { return new SnesNtscFilter(emu); };
+	auto pceNtsc = [](Emulator* emu) -> BaseVideoFilter* { return new PceNtscFilter(emu); };
+
+	constexpr uint32_t pceBufferSize = PceConstants::MaxScreenWidth * (PceConstants::ScreenHeight + 1);
+
+	return {
+		{ "NES NTSC (blargg)", { 256, 240 }, 256 * 240, nesNtsc, randomPixels(0x1FF), nullptr },
+		{ "NES NTSC (Bisqwit 2x)", { 256, 240 }, 256 * 240, bisqwit, randomPixels(0x1FF), bisqwitScale(NtscBisqwitFilterScale::_2x) },
+		{ "NES NTSC (Bisqwit 4x)", { 256, 240 }, 256 * 240, bisqwit, randomPixels(0x1FF), bisqwitScale(NtscBisqwitFilterScale::_4x) },
+		{ "NES NTSC (Bisqwit 8x)", { 256, 240 }, 256 * 240, bisqwit, randomPixels(0x1FF), bisqwitScale(NtscBisqwitFilterScale::_8x) },
+		{ "SNES NTSC", { 256, 239 }, 256 * 239, snesNtsc, randomPixels(0x7FFF), nullptr },
+		{ "SNES NTSC (hi-res)", { 512, 478 }, 512 * 478, snesNtsc, randomPixels(0x7FFF), nullptr },
+		{ "PC Engine NTSC", { PceConstants::InternalOutputWidth, PceConstants::InternalOutputHeight }, pceBufferSize, pceNtsc, pceFrame(false), nullptr },
+		{ "PC Engine NTSC (4x)", { PceConstants::InternalOutputWidth, PceConstants::InternalOutputHeight }, pceBufferSize, pceNtsc, pceFrame(true), nullptr }
+	};
+}
+
+void VideoFilterTest::InitNtscFilterSettings(Emulator& emu, std::mt19937& rng)
+{
+	//The PC Engine's default palette is empty (the UI sends it), use a random one
+	PcEngineConfig& pceCfg = emu.GetSettings()->GetPcEngineConfig();
+	for(uint32_t& color : pceCfg.Palette) {
+		color = 0xFF000000 | (rng() & 0xFFFFFF);
+	}
+}
+
+void VideoFilterTest::CompareNtscFilter(Emulator& emu, NtscFilterTestCase& testCase, std::mt19937& rng)
+{
+	if(testCase.ApplySettings) {
+		testCase.ApplySettings(emu.GetSettings());
+	}
+
+	unique_ptr<BaseVideoFilter> filter(testCase.CreateFilter(&emu));
+	unique_ptr<BaseVideoFilter> referenceFilter(testCase.CreateFilter(&emu));
+	filter->SetBaseFrameInfo(testCase.FrameSize);
+	referenceFilter->SetBaseFrameInfo(testCase.FrameSize);
+	referenceFilter->SetReferenceMode(true);
+
+	vector<uint16_t> frame(testCase.BufferSize);
+	for(bool useOverscan : { false, true }) {
+		GameConfig& gameCfg = emu.GetSettings()->GetGameConfig();
+		gameCfg.OverrideOverscan = useOverscan;
+		gameCfg.Overscan = { 8, 8, 8, 8 };
+
+		//Odd and even frames and every NES video phase (both change the burst phase of each row), split in various numbers
+		//of bands (regardless of the number of CPU cores) so that bands start on rows with every possible burst phase
+		for(uint32_t frameNumber = 0; frameNumber < 6; frameNumber++) {
+			emu.GetVideoFilterThreadPool()->SetBandCount(frameNumber + 2);
+			testCase.GenerateFrame(rng, frame);
+			vector<uint16_t> referenceFrame = frame;
+
+			FrameInfo size = filter->SendFrame(frame.data(), frameNumber, frameNumber % 3, nullptr);
+			FrameInfo referenceSize = referenceFilter->SendFrame(referenceFrame.data(), frameNumber, frameNumber % 3, nullptr);
+			if(size.Width != referenceSize.Width || size.Height != referenceSize.Height) {
+				LogFilterMismatch(testCase.Name, frameNumber, size.Width, size.Height, referenceSize.Width, referenceSize.Height);
+				continue;
+			}
+
+			uint32_t* output = filter->GetOutputBuffer();
+			uint32_t* referenceOutput = referenceFilter->GetOutputBuffer();
+			for(uint32_t y = 0; y < size.Height; y++) {
+				for(uint32_t x = 0; x < size.Width; x++) {
+					uint32_t pos = y * size.Width + x;
+					if(output[pos] != referenceOutput[pos]) {
+						LogFilterMismatch(testCase.Name, frameNumber, x, y, referenceOutput[pos], output[pos]);
+					}
+				}
+			}
+		}
+	}
+
+	emu.GetSettings()->GetGameConfig().OverrideOverscan = false;
+	emu.GetVideoFilterThreadPool()->SetBandCount(0);
+}
+
+RomTestResult VideoFilterTest::RunNtscFilterTest()
+{
+	_errorCount = 0;
+
+	//The filters only need the emulator's settings (and its video filter threads), no game needs to be loaded
+	Emulator emu;
+	std::mt19937 rng(VideoFilterTest::RandomSeed);
+	InitNtscFilterSettings(emu, rng);
+
+	for(NtscFilterTestCase& testCase : GetNtscFilterTestCases()) {
+		uint32_t errorCount = _errorCount;
+		CompareNtscFilter(emu, testCase, rng);
+		if(_errorCount != errorCount) {
+			MessageManager::Log("[VideoFilterTest] " + string(testCase.Name) + ": " + std::to_string(_errorCount - errorCount) + " mismatching pixel(s)");
+		}
+	}
+
+	MessageManager::Log("[VideoFilterTest] NTSC filter test: " + (_errorCount ? std::to_string(_errorCount) + " mismatching pixel(s)" : string("passed")));
+
+	RomTestResult result = {};
+	result.State = _errorCount ? RomTestState::Failed : RomTestState::Passed;
+	result.ErrorCode = (int32_t)_errorCount;
+	return result;
+}
+
+void VideoFilterTest::RunNtscFilterBenchmark()
+{
+	constexpr int FrameCount = 30;
+
+	Emulator emu;
+	std::mt19937 rng(VideoFilterTest::RandomSeed);
+	InitNtscFilterSettings(emu, rng);
+
+	MessageManager::Log("[VideoFilterTest] NTSC filter benchmark - average time per frame, regular vs reference mode (" + std::to_string(FrameCount) + " frames)");
+
+	for(NtscFilterTestCase& testCase : GetNtscFilterTestCases()) {
+		if(testCase.ApplySettings) {
+			testCase.ApplySettings(emu.GetSettings());
+		}
+
+		vector<uint16_t> frame(testCase.BufferSize);
+		testCase.GenerateFrame(rng, frame);
+
+		auto measure = [&](bool referenceMode) {
+			unique_ptr<BaseVideoFilter> filter(testCase.CreateFilter(&emu));
+			filter->SetBaseFrameInfo(testCase.FrameSize);
+			filter->SetReferenceMode(referenceMode);
+
+			//The first frame initializes the filter's tables and buffers (and starts the threads)
+			filter->SendFrame(frame.data(), 0, 0, nullptr);
+			Timer timer;
+			for(int i = 1; i <= FrameCount; i++) {
+				filter->SendFrame(frame.data(), i, i % 3, nullptr);
+			}
+			return timer.GetElapsedMS() / FrameCount;
+		};
+
+		double time = measure(false);
+		double referenceTime = measure(true);
+
+		std::stringstream ss;
+		ss << "[VideoFilterTest] " << testCase.Name << ": " << std::fixed << std::setprecision(3) << time << " ms (reference: " << referenceTime << " ms, ";
+		ss << std::setprecision(2) << (time > 0 ? referenceTime / time : 0.0) << "x)";
+		MessageManager::Log(ss.str());
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "pch.h"
+#include <random>
+#include <functional>
+#include "Shared/RecordedRomTest.h"
+#include "Shared/SettingTypes.h"
+
+class Emulator;
+class EmuSettings;
+class BaseVideoFilter;
+
+//Checks that the vectorized video filter kernels (and the multithreaded NTSC filters) match their scalar versions, and measures their performance
+class VideoFilterTest
+{
+private:
+	struct ScreenSize
+	{
+		const char* Name;
+		uint32_t Width;
+		uint32_t Height;
+	};
+
+	struct NtscFilterTestCase
+	{
+		const char* Name;
+		FrameInfo FrameSize;
+		uint32_t BufferSize;
+		std::function<BaseVideoFilter*(Emulator*)> CreateFilter;
+		std::function<void(std::mt19937&, vector<uint16_t>&)> GenerateFrame;
+		std::function<void(EmuSettings*)> ApplySettings;
+	};
+
+	static constexpr uint32_t RandomSeed = 0x4D455345;
+	static constexpr uint32_t MaxLoggedErrors = 10;
+
+	uint32_t _errorCount = 0;
+
+	void LogMismatch(const char* kernel, uint32_t count, uint32_t offset, uint32_t index, uint32_t expected, uint32_t actual);
+
+	void CompareBlendPixels(std::mt19937& rng, uint32_t count, uint32_t offset);
+	void CompareDarkenPixels(std::mt19937& rng, uint32_t count, uint32_t offset, uint8_t intensity);
+	void CompareYiqToArgb(std::mt19937& rng, uint32_t count, uint32_t offset);
+
+	static vector<ScreenSize> GetBenchmarkSizes();
+
+	void LogFilterMismatch(const char* filter, uint32_t frameNumber, uint32_t x, uint32_t y, uint32_t expected, uint32_t actual);
+	void CompareNtscFilter(Emulator& emu, NtscFilterTestCase& testCase, std::mt19937& rng);
+	static void InitNtscFilterSettings(Emulator& emu, std::mt19937& rng);
+	static vector<NtscFilterTestCase> GetNtscFilterTestCases();
+
+public:
+	//Runs each kernel on the same pseudo-random input with the vectorized and scalar versions, for all row sizes up to 64 pixels
+	//and a few screen widths, with unaligned buffers - ErrorCode is the number of mismatching pixels
+	RomTestResult RunKernelTest();
+
+	//Logs the average time taken by each kernel (vectorized and scalar) to process a frame at common screen sizes
+	void RunKernelBenchmark();
+
+	//Runs each NTSC filter on the same pseudo-random frames in regular mode (bands of rows processed in parallel, vectorized kernels)
+	//and in reference mode (single thread, scalar kernels), with and without overscan - ErrorCode is the number of mismatching pixels
+	RomTestResult RunNtscFilterTest();
+
+	//Logs the average time taken by each NTSC filter to process a frame, in regular and reference mode
+	void RunNtscFilterBenchmark();
+};
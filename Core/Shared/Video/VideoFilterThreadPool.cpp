@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "Shared/Video/VideoFilterThreadPool.h"
+
+VideoFilterThreadPool::VideoFilterThreadPool()
+{
+	_stopThreads = false;
+	_busy = false;
+	_activeWorkers = 0;
+	_nextBand = 0;
+}
+
+VideoFilterThreadPool::~VideoFilterThreadPool()
+{
+	_stopThreads = true;
+	for(unique_ptr<AutoResetEvent>& startWork : _startWork) {
+		startWork->Signal();
+	}
+	for(std::thread& t : _threads) {
+		t.join();
+	}
+}
+
+uint32_t VideoFilterThreadPool::GetThreadCount()
+{
+	return std::max<uint32_t>(1, std::min<uint32_t>(VideoFilterThreadPool::MaxThreads, std::thread::hardware_concurrency()));
+}
+
+void VideoFilterThreadPool::StartThreads()
+{
+	//The workers are only started once a filter needs them (most emulator instances never use a multithreaded filter)
+	uint32_t threadCount = GetThreadCount();
+	for(uint32_t i = 1; i < threadCount; i++) {
+		_startWork.push_back(std::make_unique<AutoResetEvent>());
+		AutoResetEvent* startWork = _startWork.back().get();
+		_threads.push_back(std::thread([=]() {
+			while(true) {
+				startWork->Wait();
+				if(_stopThreads) {
+					break;
+				}
+				ProcessBands();
+				_activeWorkers--;
+			}
+		}));
+	}
+}
+
+void VideoFilterThreadPool::ProcessBands()
+{
+	uint32_t band;
+	while((band = _nextBand++) < _bandCount) {
+		uint32_t startRow = _rowCount * band / _bandCount;
+		uint32_t endRow = _rowCount * (band + 1) / _bandCount;
+		(*_job)(startRow, endRow);
+	}
+}
+
+void VideoFilterThreadPool::Run(uint32_t rowCount, const std::function<void(uint32_t startRow, uint32_t endRow)>& job)
+{
+	uint32_t bandCount = std::min(rowCount, _forcedBandCount ? _forcedBandCount : GetThreadCount());
+	bool expected = false;
+	if(bandCount <= 1 || !_busy.compare_exchange_strong(expected, true)) {
+		job(0, rowCount);
+		return;
+	}
+
+	if(_threads.empty()) {
+		StartThreads();
+	}
+
+	_job = &job;
+	_rowCount = rowCount;
+	_bandCount = bandCount;
+	_nextBand = 0;
+	_activeWorkers = (uint32_t)_threads.size();
+	for(unique_ptr<AutoResetEvent>& startWork : _startWork) {
+		startWork->Signal();
+	}
+
+	ProcessBands();
+
+	//Bands are short (a fraction of a frame), wait for the workers without sleeping
+	while(_activeWorkers > 0) {
+		std::this_thread::yield();
+	}
+	_job = nullptr;
+	_busy = false;
+}
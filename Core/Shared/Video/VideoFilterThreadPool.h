@@ -0,0 +1,41 @@
+#pragma once
+#include "pch.h"
+#include <functional>
+#include "Utilities/AutoResetEvent.h"
+
+//Splits a frame into horizontal bands and processes them over a few persistent worker threads
+//A single pool is owned by the emulator and shared by all of its video filters
+class VideoFilterThreadPool
+{
+private:
+	static constexpr uint32_t MaxThreads = 4;
+
+	vector<std::thread> _threads;
+	vector<unique_ptr<AutoResetEvent>> _startWork;
+	atomic<bool> _stopThreads;
+	atomic<bool> _busy;
+	atomic<uint32_t> _activeWorkers;
+	atomic<uint32_t> _nextBand;
+
+	const std::function<void(uint32_t, uint32_t)>* _job = nullptr;
+	uint32_t _rowCount = 0;
+	uint32_t _bandCount = 0;
+	uint32_t _forcedBandCount = 0;
+
+	void StartThreads();
+	void ProcessBands();
+
+public:
+	VideoFilterThreadPool();
+	~VideoFilterThreadPool();
+
+	uint32_t GetThreadCount();
+
+	//Splits frames into a specific number of bands, regardless of the number of threads (0 = one band per thread)
+	//Used by VideoFilterTest to check that the output doesn't depend on where the bands start
+	void SetBandCount(uint32_t bandCount) { _forcedBandCount = bandCount; }
+
+	//Calls job(startRow, endRow) for each band (endRow is exclusive), on the calling thread and the workers, and returns once all bands are done
+	//When the pool is already in use by another filter (e.g a screenshot taken by a Lua script), the whole frame is processed on the calling thread
+	void Run(uint32_t rowCount, const std::function<void(uint32_t startRow, uint32_t endRow)>& job);
+};
@@ -8,6 +8,7 @@
 #include "Shared/Video/SystemHud.h"
 #include "Shared/InputHud.h"
 #include "Shared/MessageManager.h"
+#include "Utilities/Timer.h"
 #include "Utilities/Video/IVideoRecorder.h"
 #include "Utilities/Video/AviRecorder.h"
 #include "Utilities/Video/GifRecorder.h"
@@ -95,7 +96,14 @@ void VideoRenderer::RenderThread()
 
 			DrawScriptHud(frame);
 
+			Timer renderTimer;
 			_renderer->Render(_emuHudSurface, _scriptHudSurface);
+
+			if(frame.InputTimestamp > 0 && frame.InputTimestamp != _lastPresentedInputTimestamp) {
+				//Only the first presentation of each frame is used to measure the latency
+				_lastPresentedInputTimestamp = frame.InputTimestamp;
+				_emu->ProcessFramePresented(frame.InputTimestamp, renderTimer.GetElapsedMS());
+			}
 		}
 	}
 }
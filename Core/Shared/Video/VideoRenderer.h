@@ -55,6 +55,7 @@ private:
 
 	RenderedFrame _lastFrame;
 	SimpleLock _frameLock;
+	double _lastPresentedInputTimestamp = 0;
 
 	safe_ptr<IVideoRecorder> _recorder;
 
@@ -105,6 +105,7 @@ extern "C"
 	}
 
 	DllExport void __stdcall ResetProfiler(CpuType cpuType) { WithToolVoid(GetCallstackManager(cpuType), GetProfiler()->Reset()); }
+	DllExport bool __stdcall ExportProfilerCallTree(CpuType cpuType, char* filename, ProfilerExportFormat format) { return WithTool(bool, GetCallstackManager(cpuType), GetProfiler()->ExportCallTree(filename, format)); }
 
 	DllExport void __stdcall GetConsoleState(BaseState& state, ConsoleType consoleType) { WithDebugger(void, GetConsoleState(state, consoleType)); }
 	DllExport void __stdcall GetCpuState(BaseState& state, CpuType cpuType) { WithDebugger(void, GetCpuState(state, cpuType)); }
@@ -140,6 +141,8 @@ extern "C"
 
 	DllExport void __stdcall SetLabel(uint32_t address, MemoryType memType, char* label, char* comment) { WithDebugger(void, GetLabelManager()->SetLabel(address, memType, label, comment)); }
 	DllExport void __stdcall ClearLabels() { WithDebugger(void, GetLabelManager()->ClearLabels()); }
+	DllExport bool __stdcall LoadLabelWorkspace(char* filename) { return WithDebugger(bool, GetLabelManager()->LoadWorkspace(filename)); }
+	DllExport bool __stdcall SaveLabelWorkspace(char* filename) { return WithDebugger(bool, GetLabelManager()->SaveWorkspace(filename)); }
 
 	DllExport void __stdcall ResetMemoryAccessCounts() { WithDebugger(void, GetMemoryAccessCounter()->ResetCounts()); }
 	DllExport void __stdcall GetMemoryAccessCounts(uint32_t offset, uint32_t length, MemoryType memoryType, AddressCounters* counts) { WithDebugger(void, GetMemoryAccessCounter()->GetAccessCounts(offset, length, memoryType, counts)); }
@@ -149,6 +152,8 @@ extern "C"
 	DllExport void __stdcall ResetCdl(MemoryType memoryType) { WithDebugger(void, GetCdlManager()->ResetCdl(memoryType)); }
 	DllExport void __stdcall SaveCdlFile(MemoryType memoryType, char* cdlFile) { WithDebugger(void, GetCdlManager()->SaveCdlFile(memoryType, cdlFile)); }
 	DllExport void __stdcall LoadCdlFile(MemoryType memoryType, char* cdlFile) { WithDebugger(void, GetCdlManager()->LoadCdlFile(memoryType, cdlFile)); }
+	DllExport bool __stdcall MapCdlFile(MemoryType memoryType, char* cdlFile) { return WithDebugger(bool, GetCdlManager()->MapCdlFile(memoryType, cdlFile)); }
+	DllExport void __stdcall FlushCdlFiles() { WithDebugger(void, GetCdlManager()->FlushCdlFiles()); }
 	DllExport void __stdcall GetCdlData(uint32_t offset, uint32_t length, MemoryType memoryType, uint8_t* cdlData) { WithDebugger(void, GetCdlManager()->GetCdlData(offset, length, memoryType, cdlData)); }
 	DllExport void __stdcall SetCdlData(MemoryType memoryType, uint8_t* cdlData, uint32_t length) { WithDebugger(void, GetCdlManager()->SetCdlData(memoryType, cdlData, length)); }
 	DllExport void __stdcall MarkBytesAs(MemoryType memoryType, uint32_t start, uint32_t end, uint8_t flags) { WithDebugger(void, GetCdlManager()->MarkBytesAs(memoryType, start, end, flags)); }
@@ -12,6 +12,8 @@
 #include "Core/Shared/TimingInfo.h"
 #include "Core/Shared/CheatManager.h"
 #include "Core/Shared/DebuggerRequest.h"
+#include "Core/Shared/CdReader.h"
+#include "Core/Shared/RomIndex.h"
 #include "Core/Netplay/GameClient.h"
 #include "Core/Netplay/GameServer.h"
 #include "Utilities/ArchiveReader.h"
@@ -120,7 +122,11 @@ extern "C" {
 		return _emu->LoadRom((VirtualFile)filename, patchFile ? (VirtualFile)patchFile : VirtualFile());
 	}
 
-	DllExport void __stdcall AddKnownGameFolder(char* folder) { FolderUtilities::AddKnownGameFolder(folder); }
+	DllExport void __stdcall AddKnownGameFolder(char* folder)
+	{
+		FolderUtilities::AddKnownGameFolder(folder);
+		_emu->GetRomIndex()->Refresh();
+	}
 
 	DllExport void __stdcall GetRomInfo(InteropRomInfo &info)
 	{
@@ -166,6 +172,12 @@ extern "C" {
 		StringUtilities::CopyToBuffer(out.str(), outBuffer, maxLength);
 	}
 
+	DllExport bool __stdcall CreateCompressedDiscImage(char* cueFile, char* outFile)
+	{
+		VirtualFile file = string(cueFile);
+		return CdReader::CreateCompressedImage(file, outFile);
+	}
+
 	DllExport bool __stdcall IsRunning()
 	{
 		return _emu->IsRunning();
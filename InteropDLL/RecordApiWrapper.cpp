@@ -20,5 +20,7 @@ extern "C"
 	DllExport void __stdcall MovieStop() { _emu->GetMovieManager()->Stop(); }
 	DllExport bool __stdcall MoviePlaying() { return _emu->GetMovieManager()->Playing(); }
 	DllExport bool __stdcall MovieRecording() { return _emu->GetMovieManager()->Recording(); }
+	DllExport uint32_t __stdcall MovieGetInputRowCount() { return _emu->GetMovieManager()->GetInputRowCount(); }
+	DllExport bool __stdcall MovieSeekTo(uint32_t inputRow) { return _emu->GetMovieManager()->SeekTo(inputRow); }
 	DllExport void __stdcall MovieRecord(RecordMovieOptions options) { _emu->GetMovieManager()->Record(options); }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Common.h"
 #include "Core/Shared/RecordedRomTest.h"
 #include "Core/Shared/Emulator.h"
+#include "Core/Shared/Video/VideoFilterTest.h"
 
 extern unique_ptr<Emulator> _emu;
 shared_ptr<RecordedRomTest> _recordedRomTest;
@@ -35,4 +36,28 @@ extern "C"
 	}
 
 	DllExport bool __stdcall RomTestRecording() { return _recordedRomTest != nullptr; }
+
+	DllExport RomTestResult __stdcall RunVideoFilterKernelTest()
+	{
+		VideoFilterTest test;
+		return test.RunKernelTest();
+	}
+
+	DllExport void __stdcall RunVideoFilterKernelBenchmark()
+	{
+		VideoFilterTest test;
+		test.RunKernelBenchmark();
+	}
+
+	DllExport RomTestResult __stdcall RunNtscFilterTest()
+	{
+		VideoFilterTest test;
+		return test.RunNtscFilterTest();
+	}
+
+	DllExport void __stdcall RunNtscFilterBenchmark()
+	{
+		VideoFilterTest test;
+		test.RunNtscFilterBenchmark();
+	}
 }
\ No newline at end of file
@@ -71,7 +71,7 @@ namespace Mesen.Debugger.Labels
 			return _labels.Contains(label);
 		}
 
-		public static void SetLabels(IEnumerable<CodeLabel> labels, bool raiseEvents = true)
+		public static void SetLabels(IEnumerable<CodeLabel> labels, bool raiseEvents = true, bool updateCore = true)
 		{
 			Dictionary<MemoryType, bool> isAvailable = new();
 
@@ -83,7 +83,7 @@ namespace Mesen.Debugger.Labels
 				}
 
 				if(available) {
-					SetLabel(label, false);
+					SetLabel(label, false, updateCore);
 				}
 			}
 			if(raiseEvents) {
@@ -116,7 +116,7 @@ namespace Mesen.Debugger.Labels
 			}, false);
 		}
 
-		public static bool SetLabel(CodeLabel label, bool raiseEvent)
+		public static bool SetLabel(CodeLabel label, bool raiseEvent, bool updateCore = true)
 		{
 			if(_reverseLookup.ContainsKey(label.Label)) {
 				//Another identical label exists, we need to remove it
@@ -134,7 +134,9 @@ namespace Mesen.Debugger.Labels
 
 				_labelsByKey[key] = label;
 
-				if(label.Length == 1) {
+				if(!updateCore) {
+					//The core already contains this label (loaded from the binary label workspace)
+				} else if(label.Length == 1) {
 					DebugApi.SetLabel(i, label.MemoryType, label.Label, comment.Replace(Environment.NewLine, "\n"));
 				} else {
 					DebugApi.SetLabel(i, label.MemoryType, label.Label + "+" + (i - label.Address).ToString(), comment.Replace(Environment.NewLine, "\n"));
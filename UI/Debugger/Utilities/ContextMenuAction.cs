@@ -591,6 +591,9 @@ namespace Mesen.Debugger.Utilities
 		[IconFile("HdPack")]
 		HdPackBuilder,
 
+		[IconFile("PceIcon")]
+		CompressDiscImage,
+
 		[IconFile("LogWindow")]
 		LogWindow,
 
@@ -1,4 +1,5 @@
-﻿using Mesen.Config;
+﻿using Avalonia.Threading;
+using Mesen.Config;
 using Mesen.Debugger.Integration;
 using Mesen.Debugger.Labels;
 using Mesen.Interop;
@@ -19,6 +20,8 @@ namespace Mesen.Debugger.Utilities
 		private static DebugWorkspace? _workspace = null;
 		private static RomInfo _romInfo = new();
 		private static string _path = "";
+		private static string _labelWorkspacePath = "";
+		private static DispatcherTimer? _cdlFlushTimer = null;
 		public static ISymbolProvider? SymbolProvider { get; private set; }
 
 		public static event EventHandler? SymbolProviderChanged;
@@ -43,9 +46,10 @@ namespace Mesen.Debugger.Utilities
 
 			_romInfo = EmuApi.GetRomInfo();
 			_path = Path.Combine(ConfigManager.DebuggerFolder, _romInfo.GetRomName() + ".json");
+			_labelWorkspacePath = Path.Combine(ConfigManager.DebuggerFolder, _romInfo.GetRomName() + ".labels");
 
 			LabelManager.SuspendEvents();
-			_workspace = DebugWorkspace.Load(_path);
+			_workspace = DebugWorkspace.Load(_path, _labelWorkspacePath);
 
 			SymbolProvider = null;
 			if(ConfigManager.Config.Debug.Integration.AutoLoadDbgFiles) {
@@ -68,6 +72,13 @@ namespace Mesen.Debugger.Utilities
 				LoadNesAsmLabelFile(fnsPath, false);
 			}
 
+			//Keep the CDL data in a memory-mapped file in the debugger folder (done before importing a CDL file, so the imported data is written to it)
+			string mappedCdlPath = Path.Combine(ConfigManager.DebuggerFolder, _romInfo.GetRomName() + "." + FileDialogHelper.CdlExt);
+			DebugApi.MapCdlFile(_romInfo.ConsoleType.GetMainCpuType().GetPrgRomMemoryType(), mappedCdlPath);
+			if(_cdlFlushTimer == null) {
+				_cdlFlushTimer = new DispatcherTimer(TimeSpan.FromSeconds(30), DispatcherPriority.Background, (s, e) => DebugApi.FlushCdlFiles());
+			}
+
 			if(ConfigManager.Config.Debug.Integration.AutoLoadCdlFiles) {
 				string cdlPath = Path.ChangeExtension(_romInfo.RomPath, FileDialogHelper.CdlExt);
 				LoadCdlFile(cdlPath);
@@ -155,9 +166,11 @@ namespace Mesen.Debugger.Utilities
 
 		public static void Save(bool releaseWorkspace = false)
 		{
-			_workspace?.Save(_path, _romInfo.CpuTypes);
+			_workspace?.Save(_path, _labelWorkspacePath, _romInfo.CpuTypes);
 			if(releaseWorkspace) {
 				_workspace = null;
+				_cdlFlushTimer?.Stop();
+				_cdlFlushTimer = null;
 			}
 		}
 	}
@@ -174,7 +187,7 @@ namespace Mesen.Debugger.Utilities
 		public Dictionary<CpuType, CpuDebugWorkspace> WorkspaceByCpu { get; set; } = new();
 		public string[] TblMappings = Array.Empty<string>();
 
-		public static DebugWorkspace Load(string path)
+		public static DebugWorkspace Load(string path, string labelWorkspacePath)
 		{
 			DebugWorkspace dbgWorkspace = new();
 			if(File.Exists(path)) {
@@ -190,9 +203,17 @@ namespace Mesen.Debugger.Utilities
 			if(dbgWorkspace.WorkspaceByCpu.Count == 0) {
 				DefaultLabelHelper.SetDefaultLabels();
 			} else {
+				//The binary label workspace is saved along with the json file, when it's up to date the core can map it
+				//directly instead of receiving each label one by one
+				bool coreLabelsLoaded = (
+					File.Exists(labelWorkspacePath) &&
+					File.GetLastWriteTimeUtc(labelWorkspacePath) >= File.GetLastWriteTimeUtc(path) &&
+					DebugApi.LoadLabelWorkspace(labelWorkspacePath)
+				);
+
 				foreach((CpuType cpuType, CpuDebugWorkspace workspace) in dbgWorkspace.WorkspaceByCpu) {
 					WatchManager.GetWatchManager(cpuType).WatchEntries = workspace.WatchEntries;
-					LabelManager.SetLabels(workspace.Labels);
+					LabelManager.SetLabels(workspace.Labels, true, !coreLabelsLoaded);
 					BreakpointManager.AddBreakpoints(workspace.Breakpoints);
 				}
 			}
@@ -200,7 +221,7 @@ namespace Mesen.Debugger.Utilities
 			return dbgWorkspace;
 		}
 
-		public void Save(string path, HashSet<CpuType> cpuTypes)
+		public void Save(string path, string labelWorkspacePath, HashSet<CpuType> cpuTypes)
 		{
 			WorkspaceByCpu = new();
 			foreach(CpuType cpuType in cpuTypes) {
@@ -212,6 +233,11 @@ namespace Mesen.Debugger.Utilities
 			}
 
 			FileHelper.WriteAllText(path, JsonSerializer.Serialize(this, typeof(DebugWorkspace), JsonHelper.Options));
+
+			//Saved after the json file, the binary workspace is only used if it's not older than it
+			if(!DebugApi.SaveLabelWorkspace(labelWorkspacePath)) {
+				File.Delete(labelWorkspacePath);
+			}
 		}
 
 		public void Reset()
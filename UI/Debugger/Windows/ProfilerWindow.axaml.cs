@@ -9,8 +9,11 @@ using Mesen.Debugger.Controls;
 using Mesen.Debugger.Utilities;
 using Mesen.Debugger.ViewModels;
 using Mesen.Interop;
+using Mesen.Utilities;
+using Mesen.Windows;
 using System;
 using System.ComponentModel;
+using System.IO;
 
 namespace Mesen.Debugger.Windows
 {
@@ -84,6 +87,24 @@ namespace Mesen.Debugger.Windows
 			_model.SelectedTab?.ResetData();
 		}
 
+		private async void OnExportClick(object sender, RoutedEventArgs e)
+		{
+			if(_model.SelectedTab == null) {
+				return;
+			}
+
+			CpuType cpuType = _model.SelectedTab.CpuType;
+			string initFilename = EmuApi.GetRomInfo().GetRomName() + "." + cpuType.ToString() + ".speedscope.json";
+			string? filename = await FileDialogHelper.SaveFile(null, initFilename, VisualRoot, "json", "txt");
+			if(filename != null) {
+				//Text files are saved in the "collapsed stacks" format used by flamegraph.pl, otherwise use speedscope's format
+				bool collapsed = Path.GetExtension(filename).ToLower() == ".txt";
+				if(!DebugApi.ExportProfilerCallTree(cpuType, filename, collapsed ? ProfilerExportFormat.CollapsedStacks : ProfilerExportFormat.Speedscope)) {
+					await MesenMsgBox.Show(this, "FileSaveError", MessageBoxButtons.OK, MessageBoxIcon.Error);
+				}
+			}
+		}
+
 		private void InitializeComponent()
 		{
 			AvaloniaXamlLoader.Load(this);
@@ -226,6 +226,8 @@ namespace Mesen.Interop
 
 		[DllImport(DllPath)] public static extern void SetLabel(uint address, MemoryType memType, string label, string comment);
 		[DllImport(DllPath)] public static extern void ClearLabels();
+		[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool LoadLabelWorkspace([MarshalAs(UnmanagedType.LPUTF8Str)] string filename);
+		[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool SaveLabelWorkspace([MarshalAs(UnmanagedType.LPUTF8Str)] string filename);
 
 		[DllImport(DllPath)] public static extern void SetBreakpoints([MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 1)] InteropBreakpoint[] breakpoints, UInt32 length);
 		
@@ -419,6 +421,7 @@ namespace Mesen.Interop
 		}
 
 		[DllImport(DllPath)] public static extern void ResetProfiler(CpuType type);
+		[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool ExportProfilerCallTree(CpuType type, [MarshalAs(UnmanagedType.LPUTF8Str)] string filename, ProfilerExportFormat format);
 		[DllImport(DllPath, EntryPoint = "GetProfilerData")] private static extern void GetProfilerDataWrapper(CpuType type, IntPtr profilerData, ref UInt32 functionCount);
 		public static unsafe int GetProfilerData(CpuType type, ref ProfiledFunction[] profilerData)
 		{
@@ -494,6 +497,8 @@ namespace Mesen.Interop
 		[DllImport(DllPath)] public static extern void ResetCdl(MemoryType memType);
 		[DllImport(DllPath)] public static extern void SaveCdlFile(MemoryType memType, [MarshalAs(UnmanagedType.LPUTF8Str)] string cdlFile);
 		[DllImport(DllPath)] public static extern void LoadCdlFile(MemoryType memType, [MarshalAs(UnmanagedType.LPUTF8Str)] string cdlFile);
+		[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool MapCdlFile(MemoryType memType, [MarshalAs(UnmanagedType.LPUTF8Str)] string cdlFile);
+		[DllImport(DllPath)] public static extern void FlushCdlFiles();
 		[DllImport(DllPath)] public static extern void SetCdlData(MemoryType memType, [In] byte[] cdlData, Int32 length);
 		[DllImport(DllPath)] public static extern void MarkBytesAs(MemoryType memType, UInt32 start, UInt32 end, CdlFlags type);
 		[DllImport(DllPath)] public static extern CdlStatistics GetCdlStatistics(MemoryType memType);
@@ -1364,6 +1369,12 @@ namespace Mesen.Interop
 		}
 	}
 
+	public enum ProfilerExportFormat
+	{
+		CollapsedStacks = 0,
+		Speedscope = 1
+	}
+
 	public unsafe struct TraceRow
 	{
 		public UInt32 ProgramCounter;
@@ -103,6 +103,7 @@ namespace Mesen.Interop
 		}, 1000000); }
 
 		[DllImport(DllPath)] public static extern IntPtr GetArchiveRomList([MarshalAs(UnmanagedType.LPUTF8Str)]string filename, IntPtr outFileList, Int32 maxLength);
+		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool CreateCompressedDiscImage([MarshalAs(UnmanagedType.LPUTF8Str)]string cueFile, [MarshalAs(UnmanagedType.LPUTF8Str)]string outFile);
 
 		[DllImport(DllPath)] public static extern void SaveState(UInt32 stateIndex);
 		[DllImport(DllPath)] public static extern void LoadState(UInt32 stateIndex);
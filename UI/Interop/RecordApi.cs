@@ -25,6 +25,8 @@ namespace Mesen.Interop
 		[DllImport(DllPath)] public static extern void MovieStop();
 		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool MoviePlaying();
 		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool MovieRecording();
+		[DllImport(DllPath)] public static extern UInt32 MovieGetInputRowCount();
+		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool MovieSeekTo(UInt32 inputRow);
 	}
 
 	public enum RecordMovieFrom
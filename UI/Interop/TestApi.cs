@@ -15,6 +15,11 @@ namespace Mesen.Interop
 		[DllImport(DllPath)] public static extern void RomTestRecord([MarshalAs(UnmanagedType.LPUTF8Str)]string filename, [MarshalAs(UnmanagedType.I1)]bool reset);
 		[DllImport(DllPath)] public static extern void RomTestStop();
 		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool RomTestRecording();
+
+		[DllImport(DllPath)] public static extern RomTestResult RunVideoFilterKernelTest();
+		[DllImport(DllPath)] public static extern void RunVideoFilterKernelBenchmark();
+		[DllImport(DllPath)] public static extern RomTestResult RunNtscFilterTest();
+		[DllImport(DllPath)] public static extern void RunNtscFilterBenchmark();
 	}
 
 	public struct RomTestResult
@@ -26,6 +26,7 @@ public class CommandLineHelper
 	public bool NoInput { get; private set; }
 	public bool Fullscreen { get; private set; }
 	public bool LoadLastSessionRequested { get; private set; }
+	public bool VideoFilterTest { get; private set; }
 	public string? MovieToRecord { get; private set; } = null;
 	public int TestRunnerTimeout { get; private set; } = 100;
 	public List<string> LuaScriptsToLoad { get; private set; } = new();
@@ -60,6 +61,7 @@ public class CommandLineHelper
 					case "fullscreen": Fullscreen = true; break;
 					case "donotsavesettings": ConfigManager.DisableSaveSettings = true; break;
 					case "loadlastsession": LoadLastSessionRequested = true; break;
+					case "videofiltertest": VideoFilterTest = true; break;
 					default:
 						if(switchArg.StartsWith("recordmovie=")) {
 							string[] values = switchArg.Split('=');
@@ -83,5 +83,34 @@ namespace Mesen.Utilities
 				});
 			});
 		}
+
+		private static void RunVideoFilterTest(string name, Func<RomTestResult> runTest, Action runBenchmark)
+		{
+			RomTestResult result = runTest();
+			string msg = "[Test] " + result.State.ToString() + ": " + name;
+			if(result.State != RomTestState.Passed) {
+				msg += " (" + result.ErrorCode.ToString() + ")";
+			}
+			EmuApi.WriteLogEntry(msg);
+
+			if(result.State != RomTestState.Failed) {
+				//Only benchmark the filters when they produce the expected results
+				runBenchmark();
+			}
+		}
+
+		public static void RunVideoFilterTests()
+		{
+			Task.Run(() => {
+				EmuApi.WriteLogEntry("==================");
+				RunVideoFilterTest("Video filter kernels", TestApi.RunVideoFilterKernelTest, TestApi.RunVideoFilterKernelBenchmark);
+				RunVideoFilterTest("NTSC filters", TestApi.RunNtscFilterTest, TestApi.RunNtscFilterBenchmark);
+				EmuApi.WriteLogEntry("==================");
+
+				Dispatcher.UIThread.Post(() => {
+					ApplicationHelper.GetOrCreateUniqueWindow<LogWindow>(null, () => new LogWindow());
+				});
+			});
+		}
 	}
 }
@@ -18,6 +18,10 @@ namespace Mesen.Utilities
 			ConfigManager.DisableSaveSettings = true;
 			CommandLineHelper commandLineHelper = new(args, true);
 
+			if(commandLineHelper.VideoFilterTest) {
+				return RunVideoFilterTest();
+			}
+
 			if(commandLineHelper.FilesToLoad.Count != 1) {
 				//No rom specified
 				return -1;
@@ -63,5 +67,24 @@ namespace Mesen.Utilities
 			EmuApi.Release();
 			return result;
 		}
+
+		private static int RunVideoFilterTest()
+		{
+			//Doesn't need a rom - compares the vectorized/multithreaded video filters with their scalar versions and benchmarks them
+			EmuApi.InitDll();
+
+			RomTestResult kernelResult = TestApi.RunVideoFilterKernelTest();
+			if(kernelResult.State != RomTestState.Failed) {
+				TestApi.RunVideoFilterKernelBenchmark();
+			}
+
+			RomTestResult ntscResult = TestApi.RunNtscFilterTest();
+			if(ntscResult.State != RomTestState.Failed) {
+				TestApi.RunNtscFilterBenchmark();
+			}
+
+			Console.Write(EmuApi.GetLog());
+			return kernelResult.State == RomTestState.Failed || ntscResult.State == RomTestState.Failed ? -1 : 0;
+		}
 	}
 }
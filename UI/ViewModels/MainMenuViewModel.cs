@@ -698,6 +698,13 @@ namespace Mesen.ViewModels
 					}
 				},
 
+				new ContextMenuSeparator(),
+
+				new MainMenuAction() {
+					ActionType = ActionType.CompressDiscImage,
+					OnClick = () => CompressDiscImage(wnd)
+				},
+
 				new ContextMenuSeparator(),
 				
 				new MainMenuAction() {
@@ -1077,6 +1084,26 @@ namespace Mesen.ViewModels
 			});
 		}
 
+		private async void CompressDiscImage(Window wnd)
+		{
+			string? cueFile = await FileDialogHelper.OpenFile(null, wnd, FileDialogHelper.CueExt);
+			if(cueFile == null) {
+				return;
+			}
+
+			string? outFile = await FileDialogHelper.SaveFile(Path.GetDirectoryName(cueFile), Path.GetFileNameWithoutExtension(cueFile) + "." + FileDialogHelper.DczExt, wnd, FileDialogHelper.DczExt);
+			if(outFile == null) {
+				return;
+			}
+
+			bool result = await Task.Run(() => EmuApi.CreateCompressedDiscImage(cueFile, outFile));
+			if(result) {
+				await MesenMsgBox.Show(wnd, "CompressDiscImageSuccess", MessageBoxButtons.OK, MessageBoxIcon.Info);
+			} else {
+				await MesenMsgBox.Show(wnd, "CompressDiscImageError", MessageBoxButtons.OK, MessageBoxIcon.Error);
+			}
+		}
+
 		private async void InstallHdPack(Window wnd)
 		{
 			string? filename = await FileDialogHelper.OpenFile(null, wnd, FileDialogHelper.ZipExt);
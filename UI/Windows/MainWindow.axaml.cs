@@ -527,6 +527,9 @@ namespace Mesen.Windows
 			} else if(key == Key.F3) {
 				RomTestHelper.RunAllTests();
 				return true;
+			} else if(key == Key.F4) {
+				RomTestHelper.RunVideoFilterTests();
+				return true;
 			} else if(key == Key.F6) {
 				//For testing purposes (to test for memory leaks)
 				Task.Run(() => {
@@ -19,7 +19,7 @@ public:
 		delete[] compressedData;
 	}
 
-	static bool Decompress(vector<uint8_t>& input, vector<uint8_t>& output)
+	static bool Decompress(const vector<uint8_t>& input, vector<uint8_t>& output)
 	{
 		uint32_t decompressedSize;
 		uint32_t compressedSize;
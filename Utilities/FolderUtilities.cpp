@@ -152,6 +152,20 @@ void FolderUtilities::CreateFolder(string folder)
 	fs::create_directory(fs::u8path(folder), errorCode);
 }
 
+bool FolderUtilities::RenameFile(string srcFile, string destFile)
+{
+	//Replaces the destination file if it already exists
+	std::error_code errorCode;
+	fs::rename(fs::u8path(srcFile), fs::u8path(destFile), errorCode);
+	return !errorCode;
+}
+
+bool FolderUtilities::IsSameFile(string file1, string file2)
+{
+	std::error_code errorCode;
+	return fs::equivalent(fs::u8path(file1), fs::u8path(file2), errorCode) && !errorCode;
+}
+
 vector<string> FolderUtilities::GetFolders(string rootFolder)
 {
 	vector<string> folders;
@@ -211,6 +225,16 @@ vector<string> FolderUtilities::GetFilesInFolder(string rootFolder, std::unorder
 	return files;
 }
 
+int64_t FolderUtilities::GetFileModificationTime(string filepath)
+{
+	std::error_code errorCode;
+	auto time = fs::last_write_time(fs::u8path(filepath), errorCode);
+	if(errorCode) {
+		return 0;
+	}
+	return (int64_t)time.time_since_epoch().count();
+}
+
 string FolderUtilities::GetFilename(string filepath, bool includeExtension)
 {
 	fs::path filename = fs::u8path(filepath).filename();
@@ -32,12 +32,15 @@ public:
 
 	static vector<string> GetFolders(string rootFolder);
 	static vector<string> GetFilesInFolder(string rootFolder, std::unordered_set<string> extensions, bool recursive);
+	static int64_t GetFileModificationTime(string filepath);
 
 	static string GetFilename(string filepath, bool includeExtension);
 	static string GetExtension(string filename);
 	static string GetFolderName(string filepath);
 
 	static void CreateFolder(string folder);
+	static bool RenameFile(string srcFile, string destFile);
+	static bool IsSameFile(string file1, string file2);
 
 	static string CombinePath(string folder, string filename);
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "pch.h"
+#include "MemoryMappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+MemoryMappedFile::MemoryMappedFile()
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	Close();
+}
+
+bool MemoryMappedFile::Open(string filepath)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(utf8::utf8::decode(filepath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	_fileHandle = file;
+
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		Close();
+		return false;
+	}
+
+	_mappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if(!_mappingHandle) {
+		Close();
+		return false;
+	}
+
+	_data = (uint8_t*)MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	_size = (size_t)size.QuadPart;
+#else
+	_fd = open(filepath.c_str(), O_RDONLY);
+	if(_fd < 0) {
+		return false;
+	}
+
+	struct stat st;
+	if(fstat(_fd, &st) != 0 || st.st_size == 0) {
+		Close();
+		return false;
+	}
+
+	void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, _fd, 0);
+	_data = data == MAP_FAILED ? nullptr : (uint8_t*)data;
+	_size = (size_t)st.st_size;
+#endif
+
+	if(!_data) {
+		Close();
+		return false;
+	}
+	_writable = false;
+	return true;
+}
+
+bool MemoryMappedFile::OpenWritable(string filepath, size_t size)
+{
+	Close();
+	if(size == 0) {
+		return false;
+	}
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(utf8::utf8::decode(filepath).c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	_fileHandle = file;
+
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart != 0 && (size_t)fileSize.QuadPart != size)) {
+		//Only empty files can be extended
+		Close();
+		return false;
+	}
+
+	//The mapping extends the file to the requested size if it's empty
+	LARGE_INTEGER mapSize;
+	mapSize.QuadPart = (LONGLONG)size;
+	_mappingHandle = CreateFileMappingW(file, nullptr, PAGE_READWRITE, mapSize.HighPart, mapSize.LowPart, nullptr);
+	if(!_mappingHandle) {
+		Close();
+		return false;
+	}
+
+	_data = (uint8_t*)MapViewOfFile(_mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+#else
+	_fd = open(filepath.c_str(), O_RDWR | O_CREAT, 0644);
+	if(_fd < 0) {
+		return false;
+	}
+
+	struct stat st;
+	if(fstat(_fd, &st) != 0 || (st.st_size != 0 && (size_t)st.st_size != size)) {
+		//Only empty files can be extended
+		Close();
+		return false;
+	}
+
+	if(st.st_size == 0 && ftruncate(_fd, (off_t)size) != 0) {
+		Close();
+		return false;
+	}
+
+	void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+	_data = data == MAP_FAILED ? nullptr : (uint8_t*)data;
+#endif
+
+	if(!_data) {
+		Close();
+		return false;
+	}
+	_size = size;
+	_writable = true;
+	return true;
+}
+
+void MemoryMappedFile::Flush()
+{
+	if(_data && _writable) {
+#ifdef _WIN32
+		FlushViewOfFile(_data, _size);
+#else
+		msync(_data, _size, MS_ASYNC);
+#endif
+	}
+}
+
+void MemoryMappedFile::Close()
+{
+#ifdef _WIN32
+	if(_data) {
+		UnmapViewOfFile(_data);
+	}
+	if(_mappingHandle) {
+		CloseHandle(_mappingHandle);
+	}
+	if(_fileHandle) {
+		CloseHandle(_fileHandle);
+	}
+	_mappingHandle = nullptr;
+	_fileHandle = nullptr;
+#else
+	if(_data) {
+		munmap(_data, _size);
+	}
+	if(_fd >= 0) {
+		close(_fd);
+	}
+	_fd = -1;
+#endif
+
+	_data = nullptr;
+	_size = 0;
+	_writable = false;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "pch.h"
+
+class MemoryMappedFile
+{
+private:
+	uint8_t* _data = nullptr;
+	size_t _size = 0;
+	bool _writable = false;
+
+#ifdef _WIN32
+	void* _fileHandle = nullptr;
+	void* _mappingHandle = nullptr;
+#else
+	int _fd = -1;
+#endif
+
+public:
+	MemoryMappedFile();
+	~MemoryMappedFile();
+
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+	//Maps an existing file in read-only mode
+	bool Open(string filepath);
+
+	//Maps a file of exactly [size] bytes in read/write mode
+	//The file is created (and extended to [size] bytes) if it doesn't exist or is empty, other files are never resized
+	bool OpenWritable(string filepath, size_t size);
+
+	//Writes the modified pages back to the disk
+	void Flush();
+	void Close();
+
+	bool IsOpen() { return _data != nullptr; }
+	uint8_t* GetData() { return _data; }
+	size_t GetSize() { return _size; }
+};
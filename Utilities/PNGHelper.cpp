@@ -6,7 +6,7 @@
 #define SPNG_USE_MINIZ
 #include "spng.h"
 
-bool PNGHelper::WritePNG(std::stringstream &stream, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel)
+bool PNGHelper::WritePNG(std::stringstream &stream, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel, int compressionLevel)
 {
 	size_t pngSize = 0;
 
@@ -31,7 +31,7 @@ bool PNGHelper::WritePNG(std::stringstream &stream, uint32_t* buffer, uint32_t x
 		return false;
 	}
 
-	void* pngData = tdefl_write_image_to_png_file_in_memory_ex(convertedData.data(), xSize, ySize, bitsPerPixel / 8, &pngSize, MZ_DEFAULT_LEVEL, MZ_FALSE);
+	void* pngData = tdefl_write_image_to_png_file_in_memory_ex(convertedData.data(), xSize, ySize, bitsPerPixel / 8, &pngSize, std::max(0, std::min(compressionLevel, PNGHelper::MaxCompressionLevel)), MZ_FALSE);
 	if(!pngData) {
 		std::cout << "tdefl_write_image_to_png_file_in_memory_ex() failed!" << std::endl;
 		return false;
@@ -42,10 +42,10 @@ bool PNGHelper::WritePNG(std::stringstream &stream, uint32_t* buffer, uint32_t x
 	}
 }
 
-bool PNGHelper::WritePNG(string filename, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel)
+bool PNGHelper::WritePNG(string filename, uint32_t* buffer, uint32_t xSize, uint32_t ySize, uint32_t bitsPerPixel, int compressionLevel)
 {
 	std::stringstream stream;
-	if(WritePNG(stream, buffer, xSize, ySize, bitsPerPixel)) {
+	if(WritePNG(stream, buffer, xSize, ySize, bitsPerPixel, compressionLevel)) {
 		ofstream file(filename, std::ios::out | std::ios::binary);
 		if(file.good()) {
 			file << stream.rdbuf();
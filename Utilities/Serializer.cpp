@@ -209,31 +209,68 @@ void Serializer::SaveTo(ostream& file, int compressionLevel)
 	if(_format == SerializeFormat::Text) {
 		file.write((char*)_data.data(), _data.size());
 	} else {
-		bool isCompressed = compressionLevel > 0;
-		file.put((char)isCompressed);
-
-		if(isCompressed) {
-			unsigned long compressedSize = compressBound((unsigned long)_data.size());
-			uint8_t* compressedData = new uint8_t[compressedSize];
-			compress2(compressedData, &compressedSize, (unsigned char*)_data.data(), (unsigned long)_data.size(), compressionLevel);
-
-			uint32_t size = (uint32_t)compressedSize;
-			uint32_t originalSize = (uint32_t)_data.size();
-			file.write((char*)&originalSize, sizeof(uint32_t));
-			file.write((char*)&size, sizeof(uint32_t));
-			file.write((char*)compressedData, compressedSize);
-			delete[] compressedData;
-		} else {
-			file.write((char*)_data.data(), _data.size());
-		}
+		WriteBinaryData(file, _data.data(), (uint32_t)_data.size(), compressionLevel);
 	}
 }
 
+void Serializer::WriteBinaryData(ostream& file, const uint8_t* data, uint32_t size, int compressionLevel)
+{
+	bool isCompressed = compressionLevel > 0;
+	file.put((char)isCompressed);
+
+	if(isCompressed) {
+		unsigned long compressedSize = compressBound((unsigned long)size);
+		vector<uint8_t> compressedData(compressedSize, 0);
+		compress2(compressedData.data(), &compressedSize, data, (unsigned long)size, compressionLevel);
+
+		uint32_t outputSize = (uint32_t)compressedSize;
+		file.write((char*)&size, sizeof(uint32_t));
+		file.write((char*)&outputSize, sizeof(uint32_t));
+		file.write((char*)compressedData.data(), compressedSize);
+	} else {
+		file.write((char*)data, size);
+	}
+}
+
+void Serializer::CompressSavedData(ostream& file, const string& savedData, int compressionLevel)
+{
+	if(savedData.empty() || savedData[0] != 0) {
+		//Empty or already compressed, nothing to do
+		file.write(savedData.data(), savedData.size());
+		return;
+	}
+
+	//Skip the uncompressed flag, it's written again by WriteBinaryData
+	WriteBinaryData(file, (const uint8_t*)savedData.data() + 1, (uint32_t)savedData.size() - 1, compressionLevel);
+}
+
 void Serializer::LoadFromMap(unordered_map<string, SerializeMapValue>& map)
 {
 	_mapValues = map;
 }
 
+void Serializer::SetMapKeyFilter(vector<string>& keys)
+{
+	//Only the specified keys will be added to the map (used to fetch a subset of the state cheaply)
+	_mapKeyFilter = unordered_set<string>(keys.begin(), keys.end());
+	_mapKeyFilterEnabled = true;
+}
+
+bool Serializer::IsMapPrefixFiltered()
+{
+	if(!_mapKeyFilterEnabled || !_saving || _format != SerializeFormat::Map) {
+		return false;
+	}
+
+	//Skip the object entirely if none of the requested keys are inside it
+	for(const string& key : _mapKeyFilter) {
+		if(key.size() > _prefix.size() && key.compare(0, _prefix.size(), _prefix) == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
 string Serializer::NormalizeName(const char* name, int index)
 {
 	string valName = name[0] == '_' ? name + 1 : name;
@@ -81,6 +81,8 @@ private:
 
 	//Used by Lua API
 	unordered_map<string, SerializeMapValue> _mapValues;
+	unordered_set<string> _mapKeyFilter;
+	bool _mapKeyFilterEnabled = false;
 
 	uint32_t _version = 0;
 	bool _saving = false;
@@ -122,9 +124,15 @@ private:
 		}
 	}
 
+	bool IsMapPrefixFiltered();
+
 	template<typename T>
 	void WriteMapFormat(string& key, T& value)
 	{
+		if(_mapKeyFilterEnabled && _mapKeyFilter.find(key) == _mapKeyFilter.end()) {
+			return;
+		}
+
 		if constexpr(std::is_same<T, bool>::value) {
 			_mapValues.try_emplace(key, SerializeMapValueFormat::Bool, (bool)value);
 		} else if constexpr(std::is_integral<T>::value) {
@@ -220,6 +228,7 @@ public:
 	
 	SerializeFormat GetFormat() { return _format; }
 	unordered_map<string, SerializeMapValue>& GetMapValues() { return _mapValues; }
+	void SetMapKeyFilter(vector<string>& keys);
 
 	bool IsValid() { return _values.size() > 0; }
 	void AddKeyPrefix(string prefix);
@@ -303,7 +312,9 @@ public:
 	void Stream(ISerializable& obj, const char* name, int index)
 	{
 		PushNamePrefix(name, index);
-		obj.Serialize(*this);
+		if(!IsMapPrefixFiltered()) {
+			obj.Serialize(*this);
+		}
 		PopNamePrefix();
 	}
 
@@ -311,7 +322,9 @@ public:
 	{
 		static_assert(std::is_base_of<ISerializable, T>::value, "[Serializer] Object does not implement ISerializable");
 		PushNamePrefix(name, index);
-		((ISerializable*)obj.get())->Serialize(*this);
+		if(!IsMapPrefixFiltered()) {
+			((ISerializable*)obj.get())->Serialize(*this);
+		}
 		PopNamePrefix();
 	}
 
@@ -319,7 +332,9 @@ public:
 	{
 		static_assert(std::is_base_of<ISerializable, T>::value, "[Serializer] Object does not implement ISerializable");
 		PushNamePrefix(name, index);
-		((ISerializable*)obj.get())->Serialize(*this);
+		if(!IsMapPrefixFiltered()) {
+			((ISerializable*)obj.get())->Serialize(*this);
+		}
 		PopNamePrefix();
 	}
 
@@ -327,7 +342,9 @@ public:
 	{
 		static_assert(std::is_base_of<ISerializable, T>::value, "[Serializer] Object does not implement ISerializable");
 		PushNamePrefix(name, index);
-		((ISerializable*)obj.get())->Serialize(*this);
+		if(!IsMapPrefixFiltered()) {
+			((ISerializable*)obj.get())->Serialize(*this);
+		}
 		PopNamePrefix();
 	}
 
@@ -335,7 +352,9 @@ public:
 	{
 		static_assert(std::is_base_of<ISerializable, T>::value, "[Serializer] Object does not implement ISerializable");
 		PushNamePrefix(name, index);
-		((ISerializable*)obj.get())->Serialize(*this);
+		if(!IsMapPrefixFiltered()) {
+			((ISerializable*)obj.get())->Serialize(*this);
+		}
 		PopNamePrefix();
 	}
 
@@ -432,6 +451,12 @@ public:
 	void PushNamePrefix(const char* name, int index = -1);
 	void PopNamePrefix();
 	void SaveTo(ostream &file, int compressionLevel = 1);
+
+	//Writes data in SaveTo's binary format (compressed flag, followed by the sizes when compressed)
+	static void WriteBinaryData(ostream& file, const uint8_t* data, uint32_t size, int compressionLevel);
+
+	//Compresses binary data produced by SaveTo without compression (e.g to compress a save state captured on the emulation thread on another thread)
+	static void CompressSavedData(ostream& file, const string& savedData, int compressionLevel = 1);
 	bool LoadFrom(istream& file);
 	void LoadFromMap(unordered_map<string, SerializeMapValue>& map);
 };
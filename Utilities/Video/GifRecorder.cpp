@@ -29,15 +29,41 @@ bool GifRecorder::StartRecording(uint32_t width, uint32_t height, uint32_t bpp,
 	_height = height;
 	_fps = fps;
 
-	_recording = GifBegin(_gif.get(), _outputFile.c_str(), width, height, 2, 8, false);
+	_recording = GifBegin(_gif.get(), _outputFile.c_str(), width, height, GifRecorder::FrameDelay, 8, false);
 	_frameCounter = 0;
+
+	if(_recording) {
+		_stopThreads = false;
+		_nextFrameNumber = 0;
+		_nextFrameToWrite = 0;
+		_prevFrame.reset();
+
+		uint32_t threadCount = std::max<uint32_t>(1, std::min<uint32_t>(GifRecorder::MaxThreads, std::thread::hardware_concurrency()));
+		for(uint32_t i = 0; i < threadCount; i++) {
+			_threads.push_back(std::thread(&GifRecorder::ProcessFrames, this));
+		}
+	}
 	return _recording;
 }
 
 void GifRecorder::StopRecording()
 {
 	if(_recording) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_stopThreads = true;
+		}
+		_jobAdded.notify_all();
+
+		//The threads encode and write all pending frames before exiting
+		for(std::thread& t : _threads) {
+			t.join();
+		}
+		_threads.clear();
+		_prevFrame.reset();
+
 		GifEnd(_gif.get());
+		_recording = false;
 	}
 }
 
@@ -51,12 +77,276 @@ bool GifRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, d
 	
 	if(fps < 55 || (_frameCounter % 6) != 0) {
 		//At 60 FPS, skip 1 of every 6 frames (max FPS for GIFs is 50fps)
-		GifWriteFrame(_gif.get(), (uint8_t*)frameBuffer, width, height, 2, 8, false);
+		shared_ptr<vector<uint32_t>> frame(new vector<uint32_t>((uint32_t*)frameBuffer, (uint32_t*)frameBuffer + width * height));
+
+		FrameJob job;
+		job.Frame = frame;
+		job.PrevFrame = _prevFrame;
+		_prevFrame = frame;
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		//Wait for the encoder threads to catch up when they fall too far behind
+		_jobRemoved.wait(lock, [this] { return _jobs.size() < GifRecorder::MaxPendingFrames; });
+		job.FrameNumber = _nextFrameNumber++;
+		_jobs.push_back(job);
+		lock.unlock();
+
+		_jobAdded.notify_one();
 	}
 
 	return true;
 }
 
+void GifRecorder::ProcessFrames()
+{
+	vector<uint8_t> encodedFrame;
+	vector<uint16_t> lzwTree(4096 * 256);
+
+	while(true) {
+		FrameJob job;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_jobAdded.wait(lock, [this] { return _stopThreads || !_jobs.empty(); });
+			if(_jobs.empty()) {
+				break;
+			}
+			job = _jobs.front();
+			_jobs.pop_front();
+		}
+		_jobRemoved.notify_one();
+
+		encodedFrame.clear();
+		EncodeFrame(job, encodedFrame, lzwTree);
+
+		//Write all the frames that are ready, in order
+		std::unique_lock<std::mutex> lock(_mutex);
+		_encodedFrames[job.FrameNumber] = std::move(encodedFrame);
+		auto result = _encodedFrames.begin();
+		while(result != _encodedFrames.end() && result->first == _nextFrameToWrite) {
+			fwrite(result->second.data(), 1, result->second.size(), _gif->f);
+			result = _encodedFrames.erase(result);
+			_nextFrameToWrite++;
+		}
+	}
+}
+
+void GifRecorder::EncodeFrame(FrameJob& job, vector<uint8_t>& out, vector<uint16_t>& lzwTree)
+{
+	const uint32_t* frame = job.Frame->data();
+	const uint32_t* prevFrame = job.PrevFrame ? job.PrevFrame->data() : nullptr;
+
+	//Only encode the rectangle that contains all the pixels that changed since the previous frame
+	uint32_t left = 0;
+	uint32_t top = 0;
+	uint32_t right = _width - 1;
+	uint32_t bottom = _height - 1;
+	if(prevFrame) {
+		left = _width;
+		top = _height;
+		right = 0;
+		bottom = 0;
+		for(uint32_t y = 0; y < _height; y++) {
+			const uint32_t* row = frame + y * _width;
+			const uint32_t* prevRow = prevFrame + y * _width;
+			uint32_t x = 0;
+			while(x < _width && ((row[x] ^ prevRow[x]) & 0xFFFFFF) == 0) {
+				x++;
+			}
+			if(x == _width) {
+				continue;
+			}
+
+			uint32_t lastX = _width - 1;
+			while(((row[lastX] ^ prevRow[lastX]) & 0xFFFFFF) == 0) {
+				lastX--;
+			}
+
+			left = std::min(left, x);
+			right = std::max(right, lastX);
+			top = std::min(top, y);
+			bottom = y;
+		}
+
+		if(top == _height) {
+			//Nothing changed, write a single transparent pixel to keep the frame's delay
+			left = top = right = bottom = 0;
+		}
+	}
+
+	uint32_t width = right - left + 1;
+	uint32_t height = bottom - top + 1;
+
+	vector<uint8_t> indexes(width * height);
+	GifPalette pal = {};
+	if(!BuildExactPalette(frame, prevFrame, left, top, width, height, indexes, pal)) {
+		QuantizeImage(frame, prevFrame, left, top, width, height, indexes, pal);
+	}
+
+	WriteImage(out, indexes, left, top, width, height, pal, lzwTree);
+}
+
+bool GifRecorder::BuildExactPalette(const uint32_t* frame, const uint32_t* prevFrame, uint32_t left, uint32_t top, uint32_t width, uint32_t height, vector<uint8_t>& indexes, GifPalette& pal)
+{
+	//Most frames use far less than 256 colors (e.g the console's palette, without video filters), in which case
+	//the frame's colors are used as is - this avoids quantization errors and is much faster than building a k-d tree
+	constexpr uint32_t tableSize = 1024;
+	constexpr uint32_t emptyEntry = 0xFFFFFFFF;
+	uint32_t colors[tableSize];
+	uint8_t colorIndexes[tableSize];
+	std::fill(colors, colors + tableSize, emptyEntry);
+
+	//Index 0 is the transparent color (used for pixels that didn't change)
+	uint32_t colorCount = 1;
+	for(uint32_t y = 0; y < height; y++) {
+		uint32_t offset = (top + y) * _width + left;
+		for(uint32_t x = 0; x < width; x++) {
+			uint32_t color = frame[offset + x] & 0xFFFFFF;
+			if(prevFrame && color == (prevFrame[offset + x] & 0xFFFFFF)) {
+				indexes[y * width + x] = kGifTransIndex;
+				continue;
+			}
+
+			uint32_t hash = (color * 2654435761u) >> 22;
+			while(colors[hash] != color && colors[hash] != emptyEntry) {
+				hash = (hash + 1) & (tableSize - 1);
+			}
+
+			if(colors[hash] == emptyEntry) {
+				if(colorCount == 256) {
+					return false;
+				}
+				colors[hash] = color;
+				colorIndexes[hash] = (uint8_t)colorCount;
+
+				//Same byte order as gif.h (the palette writer swaps the r/b channels)
+				pal.r[colorCount] = color & 0xFF;
+				pal.g[colorCount] = (color >> 8) & 0xFF;
+				pal.b[colorCount] = (color >> 16) & 0xFF;
+				colorCount++;
+			}
+			indexes[y * width + x] = colorIndexes[hash];
+		}
+	}
+
+	pal.bitDepth = 2;
+	while((1u << pal.bitDepth) < colorCount) {
+		pal.bitDepth++;
+	}
+	return true;
+}
+
+void GifRecorder::QuantizeImage(const uint32_t* frame, const uint32_t* prevFrame, uint32_t left, uint32_t top, uint32_t width, uint32_t height, vector<uint8_t>& indexes, GifPalette& pal)
+{
+	vector<uint32_t> image(width * height);
+	vector<uint32_t> prevImage(prevFrame ? width * height : 0);
+	vector<uint32_t> output(width * height);
+	for(uint32_t y = 0; y < height; y++) {
+		uint32_t offset = (top + y) * _width + left;
+		std::copy(frame + offset, frame + offset + width, image.begin() + y * width);
+		if(prevFrame) {
+			std::copy(prevFrame + offset, prevFrame + offset + width, prevImage.begin() + y * width);
+		}
+	}
+
+	uint8_t* prevData = prevFrame ? (uint8_t*)prevImage.data() : nullptr;
+	GifMakePalette(prevData, (uint8_t*)image.data(), width, height, 8, false, &pal);
+	GifThresholdImage(prevData, (uint8_t*)image.data(), (uint8_t*)output.data(), width, height, &pal);
+
+	//The palette index is stored in the alpha channel
+	for(uint32_t i = 0; i < width * height; i++) {
+		indexes[i] = (uint8_t)(output[i] >> 24);
+	}
+}
+
+//Same as gif.h's GifWriteLzwImage, but writes to a memory buffer (to allow multiple frames to be encoded at once)
+void GifRecorder::WriteImage(vector<uint8_t>& out, const vector<uint8_t>& indexes, uint32_t left, uint32_t top, uint32_t width, uint32_t height, GifPalette& pal, vector<uint16_t>& lzwTree)
+{
+	uint8_t header[] = {
+		//Graphics control extension (leave prev frame in place, this frame has transparency)
+		0x21, 0xF9, 0x04, 0x05, GifRecorder::FrameDelay & 0xFF, (GifRecorder::FrameDelay >> 8) & 0xFF, kGifTransIndex, 0,
+
+		//Image descriptor block
+		0x2C,
+		(uint8_t)(left & 0xFF), (uint8_t)(left >> 8), (uint8_t)(top & 0xFF), (uint8_t)(top >> 8),
+		(uint8_t)(width & 0xFF), (uint8_t)(width >> 8), (uint8_t)(height & 0xFF), (uint8_t)(height >> 8),
+		(uint8_t)(0x80 + pal.bitDepth - 1) //Local color table present, 2 ^ bitDepth entries
+	};
+	out.insert(out.end(), header, header + sizeof(header));
+
+	//Local color table (first color is transparency)
+	out.insert(out.end(), { 0, 0, 0 });
+	for(int i = 1; i < (1 << pal.bitDepth); i++) {
+		out.insert(out.end(), { pal.b[i], pal.g[i], pal.r[i] });
+	}
+
+	const uint32_t minCodeSize = pal.bitDepth;
+	const uint32_t clearCode = 1 << pal.bitDepth;
+	out.push_back((uint8_t)minCodeSize);
+
+	//Data sub-blocks are up to 255 bytes long, each one is preceded by its length
+	size_t blockStart = out.size();
+	out.push_back(0);
+	uint32_t bitBuffer = 0;
+	uint32_t bitCount = 0;
+	auto writeCode = [&](uint32_t code, uint32_t length) {
+		bitBuffer |= code << bitCount;
+		bitCount += length;
+		while(bitCount >= 8) {
+			out.push_back((uint8_t)bitBuffer);
+			bitBuffer >>= 8;
+			bitCount -= 8;
+			if(out.size() - blockStart == 256) {
+				out[blockStart] = 255;
+				blockStart = out.size();
+				out.push_back(0);
+			}
+		}
+	};
+
+	std::fill(lzwTree.begin(), lzwTree.end(), 0);
+	int32_t curCode = -1;
+	uint32_t codeSize = minCodeSize + 1;
+	uint32_t maxCode = clearCode + 1;
+
+	writeCode(clearCode, codeSize);
+	for(uint8_t nextValue : indexes) {
+		if(curCode < 0) {
+			curCode = nextValue;
+		} else if(lzwTree[curCode * 256 + nextValue]) {
+			curCode = lzwTree[curCode * 256 + nextValue];
+		} else {
+			writeCode((uint32_t)curCode, codeSize);
+			lzwTree[curCode * 256 + nextValue] = (uint16_t)++maxCode;
+
+			if(maxCode >= (1u << codeSize)) {
+				codeSize++;
+			}
+			if(maxCode == 4095) {
+				//Dictionary is full, clear it
+				writeCode(clearCode, codeSize);
+				std::fill(lzwTree.begin(), lzwTree.end(), 0);
+				codeSize = minCodeSize + 1;
+				maxCode = clearCode + 1;
+			}
+			curCode = nextValue;
+		}
+	}
+
+	writeCode((uint32_t)curCode, codeSize);
+	writeCode(clearCode, codeSize);
+	writeCode(clearCode + 1, minCodeSize + 1);
+	if(bitCount > 0) {
+		writeCode(0, 8 - bitCount);
+	}
+
+	if(out.size() - blockStart > 1) {
+		out[blockStart] = (uint8_t)(out.size() - blockStart - 1);
+		out.push_back(0); //Block terminator
+	} else {
+		out[blockStart] = 0; //Empty sub-block is the block terminator
+	}
+}
+
 bool GifRecorder::AddSound(int16_t* soundBuffer, uint32_t sampleCount, uint32_t sampleRate)
 {
 	return true;
@@ -70,4 +360,4 @@ bool GifRecorder::IsRecording()
 string GifRecorder::GetOutputFile()
 {
 	return _outputFile;
-}
\ No newline at end of file
+}
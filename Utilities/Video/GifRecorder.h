@@ -1,12 +1,29 @@
 #pragma once
 #include "pch.h"
+#include <thread>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
 #include "Utilities/Video/IVideoRecorder.h"
 
 struct GifWriter;
+struct GifPalette;
 
 class GifRecorder final : public IVideoRecorder
 {
 private:
+	static constexpr uint32_t MaxThreads = 4;
+	static constexpr uint32_t MaxPendingFrames = 16;
+	static constexpr uint32_t FrameDelay = 2;
+
+	struct FrameJob
+	{
+		uint64_t FrameNumber;
+		shared_ptr<vector<uint32_t>> Frame;
+		shared_ptr<vector<uint32_t>> PrevFrame;
+	};
+
 	std::unique_ptr<GifWriter> _gif;
 	bool _recording = false;
 	uint32_t _frameCounter = 0;
@@ -15,6 +32,24 @@ private:
 	uint32_t _height = 0;
 	double _fps = 0;
 
+	//Frames are encoded in parallel by the worker threads, and written to the file in order
+	vector<std::thread> _threads;
+	std::deque<FrameJob> _jobs;
+	std::map<uint64_t, vector<uint8_t>> _encodedFrames;
+	shared_ptr<vector<uint32_t>> _prevFrame;
+	uint64_t _nextFrameNumber = 0;
+	uint64_t _nextFrameToWrite = 0;
+	std::mutex _mutex;
+	std::condition_variable _jobAdded;
+	std::condition_variable _jobRemoved;
+	bool _stopThreads = false;
+
+	void ProcessFrames();
+	void EncodeFrame(FrameJob& job, vector<uint8_t>& out, vector<uint16_t>& lzwTree);
+	bool BuildExactPalette(const uint32_t* frame, const uint32_t* prevFrame, uint32_t left, uint32_t top, uint32_t width, uint32_t height, vector<uint8_t>& indexes, GifPalette& pal);
+	void QuantizeImage(const uint32_t* frame, const uint32_t* prevFrame, uint32_t left, uint32_t top, uint32_t width, uint32_t height, vector<uint8_t>& indexes, GifPalette& pal);
+	static void WriteImage(vector<uint8_t>& out, const vector<uint8_t>& indexes, uint32_t left, uint32_t top, uint32_t width, uint32_t height, GifPalette& pal, vector<uint16_t>& lzwTree);
+
 public:
 	GifRecorder();
 	virtual ~GifRecorder();
@@ -26,4 +61,4 @@ public:
 	bool AddSound(int16_t* soundBuffer, uint32_t sampleCount, uint32_t sampleRate) override;
 	bool IsRecording() override;
 	string GetOutputFile() override;
-};
\ No newline at end of file
+};
@@ -10,12 +10,13 @@
 #include "Utilities/Patches/IpsPatcher.h"
 #include "Utilities/Patches/UpsPatcher.h"
 #include "Utilities/CRC32.h"
+#include "Utilities/MemoryMappedFile.h"
 
 const std::initializer_list<string> VirtualFile::RomExtensions = {
 	".nes", ".fds", ".unif", ".unf", ".nsf", ".nsfe", ".studybox",
 	".sfc", ".swc", ".fig", ".smc", ".bs", ".spc",
 	".gb", ".gbc", ".gbs",
-	".pce", ".cue", ".hes"
+	".pce", ".cue", ".dcz", ".hes"
 };
 
 VirtualFile::VirtualFile()
@@ -228,8 +229,94 @@ void VirtualFile::InitChunks()
 {
 	if(!_useChunks) {
 		_useChunks = true;
-		_chunks.resize(GetSize() / VirtualFile::ChunkSize + 1);
+
+		if(_data.empty() && !IsArchive()) {
+			shared_ptr<MemoryMappedFile> mappedFile = std::make_shared<MemoryMappedFile>();
+			if(mappedFile->Open(_path)) {
+				_mappedFile = mappedFile;
+				return;
+			}
+		} else if(IsArchive()) {
+			//Files inside archives need to be extracted, there is nothing on the disk to read from
+			LoadFile();
+		}
+
+		if(_data.empty()) {
+			//Mapping failed, read the file in chunks and keep a limited number of them in memory
+			size_t chunkCount = GetSize() / VirtualFile::ChunkSize + 1;
+			_chunks.resize(chunkCount);
+			_chunkLastUse.resize(chunkCount);
+		}
+	}
+}
+
+void VirtualFile::LoadChunk(uint32_t chunkId)
+{
+	vector<uint8_t> buffer;
+	if(_loadedChunks.size() >= VirtualFile::MaxCachedChunks) {
+		//Evict the least recently used chunk and reuse its buffer
+		size_t lruIndex = 0;
+		for(size_t i = 1; i < _loadedChunks.size(); i++) {
+			if(_chunkLastUse[_loadedChunks[i]] < _chunkLastUse[_loadedChunks[lruIndex]]) {
+				lruIndex = i;
+			}
+		}
+		std::swap(buffer, _chunks[_loadedChunks[lruIndex]]);
+		_loadedChunks.erase(_loadedChunks.begin() + lruIndex);
+	}
+
+	unique_ptr<ifstream>& stream = _chunkStream.Stream;
+	if(!stream) {
+		stream.reset(new ifstream(_path, std::ios::in | std::ios::binary));
+	}
+
+	buffer.resize(VirtualFile::ChunkSize);
+	stream->clear();
+	stream->seekg((std::streamoff)chunkId * VirtualFile::ChunkSize, std::ios::beg);
+	stream->read((char*)buffer.data(), VirtualFile::ChunkSize);
+	buffer.resize((size_t)std::max<std::streamsize>(stream->gcount(), 0));
+
+	_chunks[chunkId] = std::move(buffer);
+	_loadedChunks.push_back(chunkId);
+}
+
+bool VirtualFile::ReadSpans(uint32_t offset, uint32_t length, void* container, AppendDataFunc appendData)
+{
+	if(!_data.empty() || _mappedFile) {
+		//The whole file is in memory, copy the range at once
+		uint8_t* data = _data.empty() ? _mappedFile->GetData() : _data.data();
+		size_t size = _data.empty() ? _mappedFile->GetSize() : _data.size();
+		if((size_t)offset + length > size) {
+			return false;
+		}
+		appendData(container, data + offset, length);
+		return true;
+	}
+
+	//Copy one span per chunk - each chunk's data is appended before the next chunk is loaded (which can evict it)
+	while(length > 0) {
+		uint32_t chunkId = offset / VirtualFile::ChunkSize;
+		if(chunkId >= _chunks.size()) {
+			return false;
+		}
+
+		if(_chunks[chunkId].empty()) {
+			LoadChunk(chunkId);
+		}
+		_chunkLastUse[chunkId] = ++_chunkUseCounter;
+
+		vector<uint8_t>& chunk = _chunks[chunkId];
+		uint32_t chunkOffset = offset - chunkId * VirtualFile::ChunkSize;
+		if(chunkOffset >= chunk.size()) {
+			return false;
+		}
+
+		uint32_t count = std::min((uint32_t)chunk.size() - chunkOffset, length);
+		appendData(container, chunk.data() + chunkOffset, count);
+		offset += count;
+		length -= count;
 	}
+	return true;
 }
 
 bool VirtualFile::ReadFile(vector<uint8_t>& out)
@@ -266,21 +353,12 @@ bool VirtualFile::ReadFile(uint8_t* out, uint32_t expectedSize)
 uint8_t VirtualFile::ReadByte(uint32_t offset)
 {
 	InitChunks();
-	if(offset < 0 || offset > GetSize()) {
-		//Out of bounds
-		return 0;
-	}
-
-	uint32_t chunkId = offset / VirtualFile::ChunkSize;
-	uint32_t chunkStart = chunkId * VirtualFile::ChunkSize;
-	if(_chunks[chunkId].size() == 0) {
-		ifstream input(_path, std::ios::in | std::ios::binary);
-		input.seekg(chunkStart, std::ios::beg);
 
-		_chunks[chunkId].resize(VirtualFile::ChunkSize);
-		input.read((char*)_chunks[chunkId].data(), VirtualFile::ChunkSize);
-	}
-	return _chunks[chunkId][offset - chunkStart];
+	uint8_t value = 0;
+	ReadSpans(offset, 1, &value, [](void* out, const uint8_t* data, uint32_t count) {
+		*(uint8_t*)out = *data;
+	});
+	return value;
 }
 
 bool VirtualFile::ApplyPatch(VirtualFile& patch)
@@ -2,10 +2,13 @@
 #include "pch.h"
 #include <sstream>
 
+class MemoryMappedFile;
+
 class VirtualFile
 {
 private:
 	constexpr static int ChunkSize = 256 * 1024;
+	constexpr static int MaxCachedChunks = 32;
 
 	string _path = "";
 	string _innerFile = "";
@@ -14,9 +17,30 @@ private:
 	int64_t _fileSize = -1;
 
 	vector<vector<uint8_t>> _chunks;
+	vector<uint64_t> _chunkLastUse;
+	vector<uint32_t> _loadedChunks;
+	uint64_t _chunkUseCounter = 0;
 	bool _useChunks = false;
 
+	//Stream used to load chunks - it is owned by a single instance, copies open their own stream when they need one
+	struct ChunkStream
+	{
+		unique_ptr<ifstream> Stream;
+
+		ChunkStream() {}
+		ChunkStream(const ChunkStream&) {}
+		ChunkStream& operator=(const ChunkStream&) { Stream.reset(); return *this; }
+	};
+
+	//Uncompressed files are mapped in memory instead of being loaded chunk by chunk
+	shared_ptr<MemoryMappedFile> _mappedFile;
+	ChunkStream _chunkStream;
+
+	typedef void (*AppendDataFunc)(void* container, const uint8_t* data, uint32_t length);
+
 	void FromStream(std::istream &input, vector<uint8_t> &output);
+	void LoadChunk(uint32_t chunkId);
+	bool ReadSpans(uint32_t offset, uint32_t length, void* container, AppendDataFunc appendData);
 
 	void LoadFile();
 
@@ -53,18 +77,17 @@ public:
 	bool ApplyPatch(VirtualFile &patch);
 
 	template<typename T>
-	bool ReadChunk(T& container, int start, int length)
+	bool ReadChunk(T& container, uint32_t start, uint32_t length)
 	{
 		InitChunks();
-		if(start < 0 || start + length > GetSize()) {
+		if((uint64_t)start + length > GetSize()) {
 			//Out of bounds
 			return false;
 		}
 
-		for(int i = start, end = start + length; i < end; i++) {
-			container.push_back(ReadByte(i));
-		}
-
-		return true;
+		return ReadSpans(start, length, &container, [](void* out, const uint8_t* data, uint32_t count) {
+			T& dst = *(T*)out;
+			dst.insert(dst.end(), data, data + count);
+		});
 	}
 };
\ No newline at end of file